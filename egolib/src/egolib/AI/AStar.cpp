@@ -27,39 +27,135 @@
 #include "egolib/Script/script.h"  // for waypoint list control
 #include "game/mesh.h"
 
-AStar::AStar() : 
-    final_node(nullptr), 
-    start_node(nullptr)
+const size_t AStar::MAX_ASTAR_NODES;
+const uint32_t AStar::NO_NODE;
+
+AStar::AStar() :
+    _generation(),
+    _cost(),
+    _estimate(),
+    _parent(),
+    _heapPosition(),
+    _currentGeneration(0),
+    _open(),
+    _path(),
+    _tileCountX(0),
+    _diagonal(false)
 {}
 
-void AStar::reset()
+void AStar::reset(size_t tileCountX, size_t tileCount)
 {
     /// @author ZF
     /// @details Reset AStar memory.
-    final_node = nullptr;
-    start_node = nullptr;
+    _open.clear();
+    _path.clear();
+    _tileCountX = tileCountX;
+
+    // The arrays are only touched again if the mesh changes size,
+    // otherwise a new generation invalidates the entries of all tiles.
+    if (_generation.size() != tileCount)
+    {
+        _generation.assign(tileCount, 0);
+        _cost.resize(tileCount);
+        _estimate.resize(tileCount);
+        _parent.resize(tileCount);
+        _heapPosition.resize(tileCount);
+        _currentGeneration = 0;
+    }
+    _currentGeneration++;
+    if (0 == _currentGeneration)
+    {
+        // wrapped around, entries of old searches could look current
+        std::fill(_generation.begin(), _generation.end(), 0);
+        _currentGeneration = 1;
+    }
+}
+
+void AStar::heapSet(size_t position, uint32_t tile)
+{
+    _open[position] = tile;
+    _heapPosition[tile] = static_cast<uint32_t>(position);
+}
+
+void AStar::heapUp(size_t position)
+{
+    const uint32_t tile = _open[position];
+    while (position > 0)
+    {
+        const size_t parent = (position - 1) / 2;
+        if (_estimate[_open[parent]] <= _estimate[tile]) break;
+        heapSet(position, _open[parent]);
+        position = parent;
+    }
+    heapSet(position, tile);
+}
+
+void AStar::heapDown(size_t position)
+{
+    const uint32_t tile = _open[position];
+    const size_t size = _open.size();
+    while (true)
+    {
+        size_t child = 2 * position + 1;
+        if (child >= size) break;
+        if (child + 1 < size && _estimate[_open[child + 1]] < _estimate[_open[child]]) child++;
+        if (_estimate[tile] <= _estimate[_open[child]]) break;
+        heapSet(position, _open[child]);
+        position = child;
+    }
+    heapSet(position, tile);
+}
+
+void AStar::heapPush(uint32_t tile)
+{
+    _open.push_back(tile);
+    heapUp(_open.size() - 1);
 }
 
-/// Functor to determine the distance of point (sourceX, sourceY) to point (targetX, targetY).
-struct Distance {
-    float operator()(int sourceX, int sourceY, int targetX, int targetY) const {
-        int distanceX = targetX - sourceX,
-            distanceY = targetY - sourceY;
-        float distance = std::sqrt(distanceX * distanceX + distanceY * distanceY);
-        return distance;
+uint32_t AStar::heapPop()
+{
+    const uint32_t top = _open.front();
+    _heapPosition[top] = NO_NODE;
+    const uint32_t last = _open.back();
+    _open.pop_back();
+    if (!_open.empty())
+    {
+        _open[0] = last;
+        heapDown(0);
     }
-};
+    return top;
+}
 
-bool AStar::find_path(const std::shared_ptr<const ego_mesh_t>& mesh, uint32_t stoppedby, const int src_ix, const int src_iy, int dst_ix, int dst_iy)
+bool AStar::is_passable(const ego_mesh_t& mesh, uint32_t stoppedBy, int x, int y)
+{
+    // is the test node on the mesh?
+    Index1D itile = mesh.getTileIndex(Index2D(x, y));
+    if (Index1D::Invalid == itile) {
+        return false;
+    }
+
+    //Dont walk into pits
+    //@todo: might need to check tile Z level here instead
+    if (mesh.getTileInfo(itile).isFanOff()) {
+        return false;
+    }
+
+    ///
+    /// @todo  I need to check for collisions with static objects, like trees
+
+    // is this a wall or impassable?
+    return !mesh.tile_has_bits(Index2D(x, y), stoppedBy);
+}
+
+bool AStar::find_path(const std::shared_ptr<const ego_mesh_t>& mesh, uint32_t stoppedby, const int src_ix, const int src_iy, int dst_ix, int dst_iy, bool diagonal)
 {
     /// @author ZF
     /// @details Explores up to MAX_ASTAR_NODES number of nodes to find a path between the source coordinates and destination coordinates.
     //              The result is stored in a node list and can be accessed through AStar_get_path(). Returns false if no path was found.
 
-    float weight;
-
     // do not start if the initial point is off the mesh
-    if (Index1D::Invalid == mesh->getTileIndex(Index2D(src_ix, src_iy)))
+    const Index1D src_tile = mesh->getTileIndex(Index2D(src_ix, src_iy));
+    if (Index1D::Invalid == src_tile)
     {
 #ifdef DEBUG_ASTAR
         Log::get().debug("AStar failed because source position is off the mesh.\n");
@@ -68,7 +164,8 @@ bool AStar::find_path(const std::shared_ptr<const ego_mesh_t>& mesh, uint32_t st
     }
 
     //Is the destination is inside a wall or outside the map?
-    if (mesh->tile_has_bits(Index2D(dst_ix, dst_iy), stoppedby) != 0 || Index1D::Invalid == mesh->getTileIndex(Index2D(dst_ix, dst_iy)))
+    const Index1D dst_tile = mesh->getTileIndex(Index2D(dst_ix, dst_iy));
+    if (mesh->tile_has_bits(Index2D(dst_ix, dst_iy), stoppedby) != 0 || Index1D::Invalid == dst_tile)
     {
 #ifdef DEBUG_ASTAR
         Log::get().debug("AStar failed because goal position is impassable.\n");
@@ -76,6 +173,14 @@ bool AStar::find_path(const std::shared_ptr<const ego_mesh_t>& mesh, uint32_t st
         return false;
     }
 
+    //A path to the start tile would have no waypoints
+    if (src_tile == dst_tile)
+    {
+#ifdef DEBUG_ASTAR
+        Log::get().debug("AStar failed because source and goal are the same tile.\n");
+#endif
+        return false;
+    }
 
     struct Offset
     {
@@ -84,100 +189,116 @@ bool AStar::find_path(const std::shared_ptr<const ego_mesh_t>& mesh, uint32_t st
         int y;
     };
 
-    //Explore all nearby nodes, not including diagonal ones
-    static const std::array<Offset, 4> EXPLORE_NODES = {
+    //Explore all nearby nodes, the diagonal ones last
+    static const std::array<Offset, 8> EXPLORE_NODES = {
         Offset(-1, 0), Offset(0, -1),
-        Offset(1, 0), Offset(0, 1)
+        Offset(1, 0), Offset(0, 1),
+        Offset(-1, -1), Offset(1, -1),
+        Offset(1, 1), Offset(-1, 1)
     };
-
-    //Node sorting algorithm (lowest weight first)
-    auto comparator = [](const std::shared_ptr<Node> &first, const std::shared_ptr<Node> &second){
-        return first->weight < second->weight;
+    const size_t explore_count = diagonal ? 8 : 4;
+    const float DIAGONAL_COST = std::sqrt(2.0f);
+
+    //Estimate the remaining cost to the destination
+    auto heuristic = [&](int x, int y) {
+        const int distanceX = std::abs(dst_ix - x),
+                  distanceY = std::abs(dst_iy - y);
+        if (diagonal) {
+            // octile distance
+            return std::max(distanceX, distanceY) + (DIAGONAL_COST - 1.0f) * std::min(distanceX, distanceY);
+        }
+        // manhattan distance
+        return static_cast<float>(distanceX + distanceY);
     };
 
-    //Set of closed nodes
-    std::unordered_set<int> closedNodes;
-    std::priority_queue<std::shared_ptr<Node>, 
-                        std::vector<std::shared_ptr<Node>>,
-                        decltype(comparator)> openNodes(comparator);
+    //Can a tile be entered?
+    auto passable = [&](int x, int y, Index1D& itile) {
+        itile = mesh->getTileIndex(Index2D(x, y));
+        return is_passable(*mesh, stoppedby, x, y);
+    };
 
     // restart the algorithm
-    reset();
+    reset(mesh->_info.getTileCountX(), mesh->_info.getTileCount());
+    _diagonal = diagonal;
 
     // initialize the starting node
-    weight = Distance()(src_ix, src_iy, dst_ix, dst_iy);
-    start_node = std::make_shared<AStar::Node>(src_ix, src_iy, weight, nullptr);
-    openNodes.push(start_node);
+    const uint32_t start = src_tile.i();
+    _generation[start] = _currentGeneration;
+    _cost[start] = 0.0f;
+    _estimate[start] = heuristic(src_ix, src_iy);
+    _parent[start] = NO_NODE;
+    heapPush(start);
 
     // do the algorithm
-    while (!openNodes.empty())
+    size_t explored = 0;
+    while (!_open.empty())
     {
-        // list is completely full... we failed
-        if (closedNodes.size() >= MAX_ASTAR_NODES) {
+        // explored too many nodes... we failed
+        if (explored >= MAX_ASTAR_NODES) {
 #ifdef DEBUG_ASTAR
             Log::get().debug("AStar failed because maximum number of nodes were explored (%lu)\n", MAX_ASTAR_NODES);
 #endif
             break;
         }
 
-        //Get the cheapest open node
-        std::shared_ptr<Node> currentNode = openNodes.top();
-        openNodes.pop();
+        //Get the cheapest open node, it is closed from now on
+        const uint32_t current = heapPop();
+        explored++;
 
-        // find some child nodes
-        for(const auto& offset: EXPLORE_NODES) {
+        // is this the destination node?
+        if (current == static_cast<uint32_t>(dst_tile.i()))
+        {
+            for (uint32_t tile = current; NO_NODE != tile; tile = _parent[tile]) {
+                _path.push_back(tile);
+            }
+            return true;
+        }
 
-            // do not check diagonals
-            if (offset.x != 0 && offset.y != 0) continue;
+        const int current_x = current % _tileCountX;
+        const int current_y = current / _tileCountX;
+
+        // find some child nodes
+        for (size_t i = 0; i < explore_count; ++i) {
+            const Offset& offset = EXPLORE_NODES[i];
 
             //The node to explore
-            int tmp_x = currentNode->ix + offset.x;
-            int tmp_y = currentNode->iy + offset.y;
+            int tmp_x = current_x + offset.x;
+            int tmp_y = current_y + offset.y;
 
-            //Do not explore any node more than once
-            if(closedNodes.find(tmp_x | tmp_y << 16) != closedNodes.end()) {
+            Index1D itile;
+            if (!passable(tmp_x, tmp_y, itile)) {
                 continue;
             }
-            closedNodes.insert(tmp_x | tmp_y << 16);
 
-            // check for the simplest case, is this the destination node?
-            if (tmp_x == dst_ix && tmp_y == dst_iy)
-            {
-                weight = Distance()(tmp_x, tmp_y, currentNode->ix, currentNode->iy);
-                final_node = std::make_shared<AStar::Node>(tmp_x, tmp_y, weight, currentNode);
-                return true;
+            // do not cut the corners of blocked tiles
+            const bool is_diagonal = (offset.x != 0 && offset.y != 0);
+            if (is_diagonal) {
+                Index1D corner;
+                if (!passable(current_x + offset.x, current_y, corner) || !passable(current_x, current_y + offset.y, corner)) {
+                    continue;
+                }
             }
 
-            // is the test node on the mesh?
-            Index1D itile = mesh->getTileIndex(Index2D(tmp_x, tmp_y));
-            if (Index1D::Invalid == itile)
+            // OK. determine the weight (G + H)
+            const uint32_t next = itile.i();
+            const float cost = _cost[current] + (is_diagonal ? DIAGONAL_COST : 1.0f);
+            if (_generation[next] != _currentGeneration)
             {
-                continue;
+                // first visit of this node
+                _generation[next] = _currentGeneration;
+                _cost[next] = cost;
+                _estimate[next] = cost + heuristic(tmp_x, tmp_y);
+                _parent[next] = current;
+                heapPush(next);
             }
-
-            //Dont walk into pits
-            //@todo: might need to check tile Z level here instead
-            const ego_tile_info_t& ptile = mesh->getTileInfo(itile);
-            if (ptile.isFanOff())
+            else if (NO_NODE != _heapPosition[next] && cost < _cost[next])
             {
-                // add the invalid tile to the list as a closed tile
-                continue;
-            }
-
-            // is this a wall or impassable?
-            if (mesh->tile_has_bits(Index2D(tmp_x, tmp_y), stoppedby))
-            {
-                // add the invalid tile to the list as a closed tile
-                continue;
+                // found a cheaper path to an open node (closed nodes can not improve, the heuristic is consistent)
+                _estimate[next] -= _cost[next] - cost;
+                _cost[next] = cost;
+                _parent[next] = current;
+                heapUp(_heapPosition[next]);
             }
-
-            ///
-            /// @todo  I need to check for collisions with static objects, like trees
-
-            // OK. determine the weight (F + H)
-            weight = Distance()(tmp_x, tmp_y, currentNode->ix, currentNode->iy)
-                   + Distance()(tmp_x, tmp_y, dst_ix, dst_iy);
-            openNodes.push(std::make_shared<AStar::Node>(tmp_x, tmp_y, weight, currentNode));
         }
     }
 
@@ -185,6 +306,12 @@ bool AStar::find_path(const std::shared_ptr<const ego_mesh_t>& mesh, uint32_t st
 }
 
 bool AStar::get_path(const int pos_x, const int dst_y, waypoint_list_t& wplst)
+{
+    return make_waypoints(_path, _tileCountX, _diagonal, pos_x, dst_y, wplst);
+}
+
+bool AStar::make_waypoints(const std::vector<uint32_t>& path, size_t tileCountX, bool diagonal,
+                           const int pos_x, const int dst_y, waypoint_list_t& wplst)
 {
     /// @author ZF
     /// @details Fills a waypoint list with sensible waypoints. It will return false if it failed to add at least one waypoint.
@@ -192,56 +319,51 @@ bool AStar::get_path(const int pos_x, const int dst_y, waypoint_list_t& wplst)
     //              creates a corner. The function automatically prunes away all non-critical nodes. The final waypoint will always be
     //              the destination coordinates.
 
+    if (path.empty()) return false;
+
     int i;
     size_t path_length, waypoint_num;
-    //bool diagonal_movement = false;
 
-    Node *current_node, *last_waypoint, *safe_waypoint;
-    Node *node_path[MAX_ASTAR_PATH];
+    uint32_t current_node, last_waypoint, safe_waypoint;
+    int step_x = 0, step_y = 0;
+
+    auto node_x = [tileCountX](uint32_t node) { return static_cast<int>(node % tileCountX); };
+    auto node_y = [tileCountX](uint32_t node) { return static_cast<int>(node / tileCountX); };
 
     //Fill the waypoint list as much as we can, the final waypoint will always be the destination waypoint
     waypoint_num = 0;
-    current_node = final_node.get();
-    last_waypoint = start_node.get();
+    last_waypoint = path.back();
 
-    //Build the local node path tree
-    path_length = 0;
-    while (path_length < MAX_ASTAR_PATH && current_node != start_node.get())
-    {
-        // add the node to the end of the path
-        node_path[path_length++] = current_node;
-
-        // get next node
-        current_node = current_node->parent.get();
-    }
+    //The path without the starting node
+    path_length = path.size() - 1;
 
     //Begin at the end of the list, which contains the starting node
-    safe_waypoint = nullptr;
+    safe_waypoint = NO_NODE;
     for (i = path_length - 1; i >= 0 && waypoint_num < MAXWAY; i--)
     {
         bool change_direction;
 
         //get current node
-        current_node = node_path[i];
+        current_node = path[i];
 
         //the first node should be safe
-        if (nullptr == safe_waypoint) safe_waypoint = current_node;
+        if (NO_NODE == safe_waypoint) safe_waypoint = current_node;
 
         //is there a change in direction?
-        change_direction = (last_waypoint->ix != current_node->ix && last_waypoint->iy != current_node->iy);
-
-        //are we moving diagonally? if so, then don't fill the waypoint list with unessecary waypoints
-        /*if( i != 0 )
+        if (!diagonal)
         {
-            if( diagonal_movement ) diagonal_movement = (ABS(current_node->ix - safe_waypoint->ix) == 1)  && (ABS(current_node->iy - safe_waypoint->iy) == 1);
-            else                    diagonal_movement = (ABS(current_node->ix - last_waypoint->ix) == 1)  && (ABS(current_node->iy - last_waypoint->iy) == 1);
-
-            if( diagonal_movement )
-            {
-                safe_waypoint = current_node;
-                continue;
-            }
-        }*/
+            change_direction = (node_x(last_waypoint) != node_x(current_node) && node_y(last_waypoint) != node_y(current_node));
+        }
+        else
+        {
+            // diagonal steps move along both axes, compare the direction of the steps instead
+            const uint32_t previous_node = path[i + 1];
+            const int dx = node_x(current_node) - node_x(previous_node),
+                      dy = node_y(current_node) - node_y(previous_node);
+            change_direction = (static_cast<size_t>(i) != path_length - 1) && (dx != step_x || dy != step_y);
+            step_x = dx;
+            step_y = dy;
+        }
 
         //If we have a change in direction, we need to add it as a waypoint, always add the last waypoint
         if (i == 0 || change_direction)
@@ -258,8 +380,8 @@ bool AStar::get_path(const int pos_x, const int dst_y, waypoint_list_t& wplst)
             else
             {
                 // translate to raw coordinates
-                way_x = safe_waypoint->ix * Info<int>::Grid::Size() + (Info<int>::Grid::Size() / 2);
-                way_y = safe_waypoint->iy * Info<int>::Grid::Size() + (Info<int>::Grid::Size() / 2);
+                way_x = node_x(safe_waypoint) * Info<int>::Grid::Size() + (Info<int>::Grid::Size() / 2);
+                way_y = node_y(safe_waypoint) * Info<int>::Grid::Size() + (Info<int>::Grid::Size() / 2);
             }
 
 #ifdef DEBUG_ASTAR
@@ -268,7 +390,7 @@ bool AStar::get_path(const int pos_x, const int dst_y, waypoint_list_t& wplst)
             Log::get().debug("Waypoint %lu: X: %d, Y: %d \n", waypoint_num, static_cast<int>(way_x / Info<int>::Grid::Size()), static_cast<int>(way_y / Info<int>::Grid::Size()));
             Renderer3D::pointList.add(Vector3f(way_x, way_y, 100.0f), 800);
             Renderer3D::lineSegmentList.add(
-                Vector3f(last_waypoint->ix*Info<float>::Grid::Size() + (Info<int>::Grid::Size() / 2), last_waypoint->iy*Info<float>::Grid::Size() + (Info<int>::Grid::Size() / 2), 200.0f),
+                Vector3f(node_x(last_waypoint)*Info<float>::Grid::Size() + (Info<int>::Grid::Size() / 2), node_y(last_waypoint)*Info<float>::Grid::Size() + (Info<int>::Grid::Size() / 2), 200.0f),
                 Vector3f(way_x, way_y, 100.0f),
                 800
             );
@@ -292,11 +414,11 @@ bool AStar::get_path(const int pos_x, const int dst_y, waypoint_list_t& wplst)
 
 #ifdef DEBUG_ASTAR
     if (waypoint_num > 0) {
-        Renderer3D::pointList.add(Vector3f(start_node->ix*Info<float>::Grid::Size() + (Info<int>::Grid::Size() / 2), start_node->iy*Info<float>::Grid::Size() + (Info<int>::Grid::Size() / 2), 100.0f), 800);
+        Renderer3D::pointList.add(Vector3f(node_x(path.back())*Info<float>::Grid::Size() + (Info<int>::Grid::Size() / 2), node_y(path.back())*Info<float>::Grid::Size() + (Info<int>::Grid::Size() / 2), 100.0f), 800);
     }
 #endif
 
     return waypoint_num > 0;
 }
 
-AStar g_astar;
+thread_local AStar g_astar;
@@ -19,8 +19,8 @@
 
 /// @file egolib/AI/AStar.h
 /// @brief A* pathfinding.
-/// @details A very ugly implementation of the A* pathfinding agorithm.
-///          There is lots of room for improvement.
+/// @details A* over the tiles of a mesh. The search state is kept in flat arrays with an
+///          entry for each tile, which are reused by all searches of a thread.
 
 #pragma once
 
@@ -35,36 +35,70 @@ struct waypoint_list_t;
 /// Implementation of A* pathfinding algorithm.
 class AStar {
 
-public:
-    struct Node {
-        Node(int x, int y, float setWeight, const std::shared_ptr<Node>& setParent) :
-            ix(x),
-            iy(y),
-            weight(setWeight),
-            parent(setParent)
-        {
-            //ctor
-        }
-
-        float weight;
-        int ix, iy;
-        std::shared_ptr<Node> parent;
-    };
-
 public:
     AStar();
-    bool find_path(const std::shared_ptr<const ego_mesh_t>& mesh, uint32_t stoppedBy, const int src_ix, const int src_iy, int dst_ix, int dst_iy);
+
+    /**
+     * @brief
+     *  Find the shortest path between two tiles.
+     * @param diagonal
+     *  if @a true, moves to diagonally adjacent tiles are allowed (but not around corners of blocked tiles)
+     * @return
+     *  @a true if a path was found, the path can be retrieved with get_path().
+     *  @a false if the start and the destination are the same tile.
+     */
+    bool find_path(const std::shared_ptr<const ego_mesh_t>& mesh, uint32_t stoppedBy, const int src_ix, const int src_iy, int dst_ix, int dst_iy, bool diagonal = false);
     bool get_path(const int pos_x, const int dst_y, waypoint_list_t& wplst);
 
+    static constexpr uint32_t NO_NODE = std::numeric_limits<uint32_t>::max();
+
+    /// @return @a true if a path may enter the tile
+    static bool is_passable(const ego_mesh_t& mesh, uint32_t stoppedBy, int x, int y);
+
+    /**
+     * @brief
+     *  Fill a waypoint list with the corners of a path of tiles.
+     * @param path
+     *  the tile indices of the path, from the destination to the start
+     * @param tileCountX
+     *  the number of tiles along the x-axis of the mesh
+     * @param diagonal
+     *  if @a true, the path may contain diagonal steps
+     * @param pos_x, dst_y
+     *  the position of the final waypoint
+     * @return
+     *  @a true if at least one waypoint was added
+     */
+    static bool make_waypoints(const std::vector<uint32_t>& path, size_t tileCountX, bool diagonal,
+                               const int pos_x, const int dst_y, waypoint_list_t& wplst);
+
 private:
-    static constexpr size_t MAX_ASTAR_NODES = 512;   ///< Maximum number of nodes to explore
-    static constexpr size_t MAX_ASTAR_PATH = 128;    ///< Maximum length of the final path (before pruning)
+    static constexpr size_t MAX_ASTAR_NODES = 4096;  ///< Maximum number of nodes to explore
 
-    std::shared_ptr<Node> final_node;
-    std::shared_ptr<Node> start_node;
+    // The search state of the tiles. The entries of a tile are only valid
+    // if its generation is the generation of the current search.
+    std::vector<uint32_t> _generation;      ///< The search which visited the tile last
+    std::vector<float> _cost;               ///< The cost of the cheapest path from the start found so far
+    std::vector<float> _estimate;           ///< The cost plus the estimated remaining cost to the destination
+    std::vector<uint32_t> _parent;          ///< The previous tile on the cheapest path, NO_NODE for the start
+    std::vector<uint32_t> _heapPosition;    ///< The position in the open heap, NO_NODE if the tile is closed
+    uint32_t _currentGeneration;
+
+    std::vector<uint32_t> _open;            ///< Binary heap of the open tiles, smallest estimate first
+    std::vector<uint32_t> _path;            ///< The tiles of the path found, from the destination to the start
+    size_t _tileCountX;                     ///< The number of tiles along the x-axis of the searched mesh
+    bool _diagonal;                         ///< Were diagonal moves allowed?
 
 private:
-    void reset();
+    void reset(size_t tileCountX, size_t tileCount);
+
+    // Index-based binary heap operations on _open.
+    void heapPush(uint32_t tile);
+    uint32_t heapPop();
+    void heapUp(size_t position);
+    void heapDown(size_t position);
+    void heapSet(size_t position, uint32_t tile);
 };
 
-extern AStar g_astar;
+/// Each thread searches with its own search state.
+extern thread_local AStar g_astar;
@@ -0,0 +1,142 @@
+//********************************************************************************************
+//*
+//*    This file is part of Egoboo.
+//*
+//*    Egoboo is free software: you can redistribute it and/or modify it
+//*    under the terms of the GNU General Public License as published by
+//*    the Free Software Foundation, either version 3 of the License, or
+//*    (at your option) any later version.
+//*
+//*    Egoboo is distributed in the hope that it will be useful, but
+//*    WITHOUT ANY WARRANTY; without even the implied warranty of
+//*    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+//*    General Public License for more details.
+//*
+//*    You should have received a copy of the GNU General Public License
+//*    along with Egoboo.  If not, see <http://www.gnu.org/licenses/>.
+//*
+//********************************************************************************************
+
+
+/// @file egolib/AI/FlowField.cpp
+/// @brief Flow fields shared by agents moving to the same tile.
+
+#include "egolib/AI/FlowField.hpp"
+
+#include "game/mesh.h"
+
+const size_t FlowFieldCache::MAX_FIELDS;
+const size_t FlowFieldCache::MAX_REQUESTS;
+
+FlowFieldCache::FlowFieldCache() :
+    _requests(),
+    _fields(),
+    _queue(),
+    _path(),
+    _tileCount(0),
+    _tileCountX(0)
+{}
+
+void FlowFieldCache::compute(const ego_mesh_t& mesh, Field& field)
+{
+    const int tileCountX = mesh._info.getTileCountX(), tileCountY = mesh._info.getTileCountY();
+    field.next.assign(mesh._info.getTileCount(), AStar::NO_NODE);
+    field.revision = mesh._blockFX.getRevision();
+
+    // Breadth-first search from the destination, the tile a tile is reached from is its next tile.
+    // The destination itself is marked by pointing to itself.
+    _queue.clear();
+    field.next[field.destination] = field.destination;
+    _queue.push_back(field.destination);
+    for (size_t head = 0; head < _queue.size(); ++head)
+    {
+        const uint32_t current = _queue[head];
+        const int x = current % tileCountX, y = current / tileCountX;
+        const int neighbours[4][2] = { { x - 1, y }, { x, y - 1 }, { x + 1, y }, { x, y + 1 } };
+        for (const auto& neighbour : neighbours)
+        {
+            if (neighbour[0] < 0 || neighbour[1] < 0 || neighbour[0] >= tileCountX || neighbour[1] >= tileCountY) continue;
+            const uint32_t tile = neighbour[0] + neighbour[1] * tileCountX;
+            if (AStar::NO_NODE != field.next[tile] || !AStar::is_passable(mesh, field.stoppedBy, neighbour[0], neighbour[1])) continue;
+            field.next[tile] = current;
+            _queue.push_back(tile);
+        }
+    }
+}
+
+bool FlowFieldCache::find_path(const std::shared_ptr<const ego_mesh_t>& mesh, uint32_t stoppedBy, const int src_ix, const int src_iy, int dst_ix, int dst_iy)
+{
+    _path.clear();
+
+    // the tiles must be on the mesh and passable
+    if (!AStar::is_passable(*mesh, stoppedBy, src_ix, src_iy) || !AStar::is_passable(*mesh, stoppedBy, dst_ix, dst_iy)) {
+        return false;
+    }
+
+    // the fields of another mesh are useless
+    if (_tileCount != mesh->_info.getTileCount() || _tileCountX != mesh->_info.getTileCountX()) {
+        _requests.clear();
+        _fields.clear();
+        _tileCount = mesh->_info.getTileCount();
+        _tileCountX = mesh->_info.getTileCountX();
+    }
+
+    const uint32_t src = src_ix + src_iy * _tileCountX, dst = dst_ix + dst_iy * _tileCountX;
+    auto it = std::find_if(_fields.begin(), _fields.end(), [&](const Field& field) {
+        return field.destination == dst && field.stoppedBy == stoppedBy;
+    });
+    if (it != _fields.end())
+    {
+        // the field is the most recently used one now
+        _fields.splice(_fields.begin(), _fields, it);
+    }
+    else
+    {
+        auto request = std::find_if(_requests.begin(), _requests.end(), [&](const Request& request) {
+            return request.destination == dst && request.stoppedBy == stoppedBy;
+        });
+        if (request == _requests.end())
+        {
+            // remember the request, replacing the least recently used request
+            if (_requests.size() >= MAX_REQUESTS) {
+                _requests.pop_back();
+            }
+            _requests.push_front(Request{ dst, stoppedBy });
+            return false;
+        }
+
+        // requested a second time: the request gets a field, replacing the least recently used field
+        _requests.erase(request);
+        if (_fields.size() >= MAX_FIELDS) {
+            _fields.splice(_fields.begin(), _fields, std::prev(_fields.end()));
+            _fields.front().destination = dst;
+            _fields.front().stoppedBy = stoppedBy;
+            _fields.front().next.clear();
+        }
+        else {
+            _fields.push_front(Field{ dst, stoppedBy, 0, std::vector<uint32_t>() });
+        }
+    }
+    Field& field = _fields.front();
+    if (field.next.empty() || field.revision != mesh->_blockFX.getRevision()) {
+        compute(*mesh, field);
+    }
+    if (AStar::NO_NODE == field.next[src]) {
+        return false;
+    }
+
+    // follow the field to the destination
+    for (uint32_t tile = src; tile != dst; tile = field.next[tile]) {
+        _path.push_back(tile);
+    }
+    _path.push_back(dst);
+    std::reverse(_path.begin(), _path.end());
+    return true;
+}
+
+bool FlowFieldCache::get_path(const int pos_x, const int dst_y, waypoint_list_t& wplst)
+{
+    return AStar::make_waypoints(_path, _tileCountX, false, pos_x, dst_y, wplst);
+}
+
+FlowFieldCache g_flowFieldCache;
@@ -0,0 +1,96 @@
+//********************************************************************************************
+//*
+//*    This file is part of Egoboo.
+//*
+//*    Egoboo is free software: you can redistribute it and/or modify it
+//*    under the terms of the GNU General Public License as published by
+//*    the Free Software Foundation, either version 3 of the License, or
+//*    (at your option) any later version.
+//*
+//*    Egoboo is distributed in the hope that it will be useful, but
+//*    WITHOUT ANY WARRANTY; without even the implied warranty of
+//*    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+//*    General Public License for more details.
+//*
+//*    You should have received a copy of the GNU General Public License
+//*    along with Egoboo.  If not, see <http://www.gnu.org/licenses/>.
+//*
+//********************************************************************************************
+
+
+/// @file egolib/AI/FlowField.hpp
+/// @brief Flow fields shared by agents moving to the same tile.
+
+#pragma once
+
+#include "egolib/AI/AStar.hpp"
+
+// Forward declarations.
+class ego_mesh_t;
+struct waypoint_list_t;
+
+/**
+ * @brief
+ *  A cache of flow fields. A flow field stores for every tile of a mesh the next tile on a
+ *  shortest path to a destination tile. It is computed by a breadth-first search from the
+ *  destination over the whole mesh, afterwards the path of any agent to the destination is
+ *  read from it without a search.
+ * @remark
+ *  A field is only computed if a destination is requested a second time while the
+ *  request is remembered. A single agent is cheaper to route with (Hierarchical)AStar.
+ *  Requests seen once are remembered apart from the fields, so one-off destinations never
+ *  replace a computed field. The least recently used request or field is replaced. A field
+ *  is recomputed if the fx of the mesh changed since it was computed.
+ * @remark
+ *  Moves are 4-directional, like the moves of AStar::find_path by default.
+ * @remark
+ *  Not thread-safe, like HierarchicalAStar: searches are only made by the serial FindPath
+ *  script function.
+ */
+class FlowFieldCache {
+
+public:
+    FlowFieldCache();
+
+    /**
+     * @brief
+     *  Find a path from a tile to a destination tile with a flow field.
+     * @return
+     *  @a true if a path was found, the path can be retrieved with get_path().
+     *  @a false if no path exists or if no flow field to the destination exists (yet).
+     */
+    bool find_path(const std::shared_ptr<const ego_mesh_t>& mesh, uint32_t stoppedBy, const int src_ix, const int src_iy, int dst_ix, int dst_iy);
+    bool get_path(const int pos_x, const int dst_y, waypoint_list_t& wplst);
+
+private:
+    static constexpr size_t MAX_FIELDS = 8;     ///< Maximum number of flow fields
+    static constexpr size_t MAX_REQUESTS = 8;   ///< Maximum number of remembered requests without a field
+
+    /// A destination requested once.
+    struct Request
+    {
+        uint32_t destination;
+        uint32_t stoppedBy;
+    };
+
+    /// A flow field to a destination tile.
+    struct Field
+    {
+        uint32_t destination;
+        uint32_t stoppedBy;
+        uint32_t revision;              ///< The revision of the mesh when the field was computed
+        std::vector<uint32_t> next;     ///< For each tile, the next tile to the destination or AStar::NO_NODE. Empty if not computed.
+    };
+
+    std::list<Request> _requests;       ///< Most recently used first
+    std::list<Field> _fields;           ///< Most recently used first
+
+    std::vector<uint32_t> _queue;       ///< The open tiles of a breadth-first search
+    std::vector<uint32_t> _path;        ///< The tiles of the path found, from the destination to the start
+    size_t _tileCount, _tileCountX;    ///< The size of the mesh of the fields
+
+private:
+    void compute(const ego_mesh_t& mesh, Field& field);
+};
+
+extern FlowFieldCache g_flowFieldCache;
@@ -0,0 +1,370 @@
+//********************************************************************************************
+//*
+//*    This file is part of Egoboo.
+//*
+//*    Egoboo is free software: you can redistribute it and/or modify it
+//*    under the terms of the GNU General Public License as published by
+//*    the Free Software Foundation, either version 3 of the License, or
+//*    (at your option) any later version.
+//*
+//*    Egoboo is distributed in the hope that it will be useful, but
+//*    WITHOUT ANY WARRANTY; without even the implied warranty of
+//*    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+//*    General Public License for more details.
+//*
+//*    You should have received a copy of the GNU General Public License
+//*    along with Egoboo.  If not, see <http://www.gnu.org/licenses/>.
+//*
+//********************************************************************************************
+
+
+/// @file egolib/AI/HierarchicalAStar.cpp
+/// @brief Hierarchical A* pathfinding.
+
+#include "egolib/AI/HierarchicalAStar.hpp"
+
+#include "game/mesh.h"
+
+const uint8_t HierarchicalAStar::NO_SLOT;
+const int HierarchicalAStar::BLOCK_SIZE;
+const int HierarchicalAStar::BLOCK_TILES;
+
+HierarchicalAStar::HierarchicalAStar() :
+    _graphs(),
+    _generation(),
+    _closed(),
+    _cost(),
+    _parent(),
+    _currentGeneration(0),
+    _open(),
+    _path(),
+    _tileCountX(0)
+{}
+
+void HierarchicalAStar::searchBlock(const ego_mesh_t& mesh, uint32_t stoppedBy, int x, int y, BlockSearch& search)
+{
+    const int blockX = x / BLOCK_SIZE * BLOCK_SIZE, blockY = y / BLOCK_SIZE * BLOCK_SIZE;
+
+    bool passable[BLOCK_TILES];
+    for (int i = 0; i < BLOCK_TILES; ++i) {
+        passable[i] = AStar::is_passable(mesh, stoppedBy, blockX + i % BLOCK_SIZE, blockY + i / BLOCK_SIZE);
+        search.cost[i] = std::numeric_limits<float>::infinity();
+        search.parent[i] = NO_SLOT;
+    }
+
+    // breadth-first search, all steps have the same cost
+    uint8_t queue[BLOCK_TILES];
+    size_t head = 0, tail = 0;
+    const int start = getLocalIndex(x, y);
+    search.cost[start] = 0.0f;
+    queue[tail++] = start;
+    while (head < tail)
+    {
+        const int current = queue[head++];
+        const int cx = current % BLOCK_SIZE, cy = current / BLOCK_SIZE;
+        const int neighbours[4][2] = { { cx - 1, cy }, { cx, cy - 1 }, { cx + 1, cy }, { cx, cy + 1 } };
+        for (const auto& neighbour : neighbours)
+        {
+            if (neighbour[0] < 0 || neighbour[0] >= BLOCK_SIZE || neighbour[1] < 0 || neighbour[1] >= BLOCK_SIZE) continue;
+            const int next = neighbour[0] + neighbour[1] * BLOCK_SIZE;
+            if (!passable[next] || search.cost[next] != std::numeric_limits<float>::infinity()) continue;
+            search.cost[next] = search.cost[current] + 1.0f;
+            search.parent[next] = current;
+            queue[tail++] = next;
+        }
+    }
+}
+
+void HierarchicalAStar::buildEntrances(const ego_mesh_t& mesh, Graph& graph, int blockX, int blockY)
+{
+    const int tileCountX = mesh._info.getTileCountX(), tileCountY = mesh._info.getTileCountY();
+    const int minX = blockX * BLOCK_SIZE, maxX = std::min(tileCountX, minX + BLOCK_SIZE) - 1;
+    const int minY = blockY * BLOCK_SIZE, maxY = std::min(tileCountY, minY + BLOCK_SIZE) - 1;
+
+    std::vector<uint32_t>& nodes = graph.nodes[blockX + blockY * mesh._blockFX.getBlockCountX()];
+    for (uint32_t tile : nodes) {
+        graph.slots[tile] = NO_SLOT;
+    }
+    nodes.clear();
+
+    auto add = [&](int x, int y) {
+        const uint32_t tile = x + y * tileCountX;
+        if (NO_SLOT == graph.slots[tile]) {
+            graph.slots[tile] = static_cast<uint8_t>(nodes.size());
+            nodes.push_back(tile);
+        }
+    };
+
+    // The border tiles of the block on each side and the direction to the neighbouring block.
+    struct Border { int x, y, dx, dy, stepX, stepY, length; };
+    const Border borders[4] = {
+        { minX, minY, -1,  0, 0, 1, maxY - minY + 1 },  // left
+        { maxX, minY,  1,  0, 0, 1, maxY - minY + 1 },  // right
+        { minX, minY,  0, -1, 1, 0, maxX - minX + 1 },  // top
+        { minX, maxY,  0,  1, 1, 0, maxX - minX + 1 },  // bottom
+    };
+    for (const Border& border : borders)
+    {
+        // one entrance in the middle of each run of pairs of passable tiles
+        int runStart = -1;
+        for (int i = 0; i <= border.length; ++i)
+        {
+            const int x = border.x + i * border.stepX, y = border.y + i * border.stepY;
+            const bool open = i < border.length
+                           && AStar::is_passable(mesh, graph.stoppedBy, x, y)
+                           && AStar::is_passable(mesh, graph.stoppedBy, x + border.dx, y + border.dy);
+            if (open && runStart < 0) {
+                runStart = i;
+            } else if (!open && runStart >= 0) {
+                const int middle = (runStart + i - 1) / 2;
+                add(border.x + middle * border.stepX, border.y + middle * border.stepY);
+                runStart = -1;
+            }
+        }
+    }
+}
+
+void HierarchicalAStar::buildCosts(const ego_mesh_t& mesh, Graph& graph, int blockX, int blockY)
+{
+    const size_t block = blockX + blockY * mesh._blockFX.getBlockCountX();
+    const std::vector<uint32_t>& nodes = graph.nodes[block];
+    std::vector<float>& costs = graph.costs[block];
+    costs.resize(nodes.size() * nodes.size());
+
+    const int tileCountX = mesh._info.getTileCountX();
+    BlockSearch search;
+    for (size_t i = 0; i < nodes.size(); ++i)
+    {
+        searchBlock(mesh, graph.stoppedBy, nodes[i] % tileCountX, nodes[i] / tileCountX, search);
+        for (size_t j = 0; j < nodes.size(); ++j)
+        {
+            costs[i * nodes.size() + j] = search.cost[getLocalIndex(nodes[j] % tileCountX, nodes[j] / tileCountX)];
+        }
+    }
+}
+
+void HierarchicalAStar::update(const ego_mesh_t& mesh, Graph& graph)
+{
+    const mesh_block_fx_t& blocks = mesh._blockFX;
+    if (graph.meshRevision == blocks.getRevision()) {
+        return;
+    }
+    graph.meshRevision = blocks.getRevision();
+
+    // The entrances on the borders of a changed block belong to the neighbouring blocks too.
+    const int blockCountX = blocks.getBlockCountX(), blockCountY = blocks.getBlockCountY();
+    std::vector<char> affected(blockCountX * blockCountY, false);
+    for (int y = 0; y < blockCountY; ++y)
+    {
+        for (int x = 0; x < blockCountX; ++x)
+        {
+            const size_t block = x + y * blockCountX;
+            if (graph.revisions[block] == blocks.getRevision(x, y)) continue;
+            graph.revisions[block] = blocks.getRevision(x, y);
+
+            affected[block] = true;
+            if (x > 0) affected[block - 1] = true;
+            if (x + 1 < blockCountX) affected[block + 1] = true;
+            if (y > 0) affected[block - blockCountX] = true;
+            if (y + 1 < blockCountY) affected[block + blockCountX] = true;
+        }
+    }
+
+    // the costs depend on the entrances
+    for (int y = 0; y < blockCountY; ++y)
+    {
+        for (int x = 0; x < blockCountX; ++x)
+        {
+            if (affected[x + y * blockCountX]) buildEntrances(mesh, graph, x, y);
+        }
+    }
+    for (int y = 0; y < blockCountY; ++y)
+    {
+        for (int x = 0; x < blockCountX; ++x)
+        {
+            if (affected[x + y * blockCountX]) buildCosts(mesh, graph, x, y);
+        }
+    }
+}
+
+HierarchicalAStar::Graph& HierarchicalAStar::getGraph(const ego_mesh_t& mesh, uint32_t stoppedBy)
+{
+    // the graphs of another mesh are useless
+    const size_t blockCount = mesh._blockFX.getBlockCountX() * mesh._blockFX.getBlockCountY();
+    if (!_graphs.empty() && (_graphs.front().slots.size() != mesh._info.getTileCount() || _graphs.front().revisions.size() != blockCount)) {
+        _graphs.clear();
+    }
+
+    for (Graph& graph : _graphs)
+    {
+        if (graph.stoppedBy == stoppedBy) {
+            update(mesh, graph);
+            return graph;
+        }
+    }
+
+    // Revisions are never 0, so all blocks are built.
+    _graphs.emplace_back();
+    Graph& graph = _graphs.back();
+    graph.stoppedBy = stoppedBy;
+    graph.meshRevision = 0;
+    graph.revisions.assign(blockCount, 0);
+    graph.nodes.resize(blockCount);
+    graph.costs.resize(blockCount);
+    graph.slots.assign(mesh._info.getTileCount(), NO_SLOT);
+    update(mesh, graph);
+    return graph;
+}
+
+void HierarchicalAStar::refine(const ego_mesh_t& mesh, uint32_t stoppedBy, uint32_t from, uint32_t to, std::vector<uint32_t>& path) const
+{
+    const int fromX = from % _tileCountX, fromY = from / _tileCountX;
+    const int toX = to % _tileCountX, toY = to / _tileCountX;
+
+    // a step across the border of two blocks
+    if (fromX / BLOCK_SIZE != toX / BLOCK_SIZE || fromY / BLOCK_SIZE != toY / BLOCK_SIZE) {
+        path.push_back(to);
+        return;
+    }
+
+    // follow the shortest paths to the target tile back from the source tile
+    BlockSearch search;
+    searchBlock(mesh, stoppedBy, toX, toY, search);
+    const int blockX = toX / BLOCK_SIZE * BLOCK_SIZE, blockY = toY / BLOCK_SIZE * BLOCK_SIZE;
+    for (int tile = search.parent[getLocalIndex(fromX, fromY)]; NO_SLOT != tile; tile = search.parent[tile]) {
+        path.push_back((blockX + tile % BLOCK_SIZE) + (blockY + tile / BLOCK_SIZE) * _tileCountX);
+    }
+}
+
+bool HierarchicalAStar::find_path(const std::shared_ptr<const ego_mesh_t>& mesh, uint32_t stoppedBy, const int src_ix, const int src_iy, int dst_ix, int dst_iy)
+{
+    _path.clear();
+
+    // the tiles must be on the mesh and passable
+    if (!AStar::is_passable(*mesh, stoppedBy, src_ix, src_iy) || !AStar::is_passable(*mesh, stoppedBy, dst_ix, dst_iy)) {
+        return false;
+    }
+
+    // nearby paths are cheaper to find on the tiles
+    const int srcBlockX = src_ix / BLOCK_SIZE, srcBlockY = src_iy / BLOCK_SIZE;
+    const int dstBlockX = dst_ix / BLOCK_SIZE, dstBlockY = dst_iy / BLOCK_SIZE;
+    if (std::abs(srcBlockX - dstBlockX) <= 1 && std::abs(srcBlockY - dstBlockY) <= 1) {
+        return false;
+    }
+
+    const Graph& graph = getGraph(*mesh, stoppedBy);
+    _tileCountX = mesh->_info.getTileCountX();
+    const size_t blockCountX = mesh->_blockFX.getBlockCountX();
+
+    // restart the search (see AStar::reset), the destination has the index of the tile count
+    const size_t tileCount = mesh->_info.getTileCount();
+    const uint32_t src = src_ix + src_iy * _tileCountX, dst = static_cast<uint32_t>(tileCount);
+    if (_generation.size() != tileCount + 1)
+    {
+        _generation.assign(tileCount + 1, 0);
+        _closed.assign(tileCount + 1, 0);
+        _cost.resize(tileCount + 1);
+        _parent.resize(tileCount + 1);
+        _currentGeneration = 0;
+    }
+    _currentGeneration++;
+    if (0 == _currentGeneration)
+    {
+        std::fill(_generation.begin(), _generation.end(), 0);
+        std::fill(_closed.begin(), _closed.end(), 0);
+        _currentGeneration = 1;
+    }
+    _open.clear();
+
+    // the costs from the tiles of the first block to the source and from the tiles of the last block to the destination
+    BlockSearch srcSearch, dstSearch;
+    searchBlock(*mesh, stoppedBy, src_ix, src_iy, srcSearch);
+    searchBlock(*mesh, stoppedBy, dst_ix, dst_iy, dstSearch);
+
+    auto relax = [&](uint32_t tile, uint32_t parent, float cost) {
+        if (_generation[tile] == _currentGeneration && (_closed[tile] == _currentGeneration || _cost[tile] <= cost)) {
+            return;
+        }
+        _generation[tile] = _currentGeneration;
+        _cost[tile] = cost;
+        _parent[tile] = parent;
+
+        // manhattan distance to the destination
+        const float estimate = (tile == dst) ? cost : cost + std::abs(dst_ix - static_cast<int>(tile % _tileCountX)) + std::abs(dst_iy - static_cast<int>(tile / _tileCountX));
+        _open.emplace_back(estimate, tile);
+        std::push_heap(_open.begin(), _open.end(), std::greater<std::pair<float, uint32_t>>());
+    };
+
+    relax(src, AStar::NO_NODE, 0.0f);
+    while (!_open.empty())
+    {
+        std::pop_heap(_open.begin(), _open.end(), std::greater<std::pair<float, uint32_t>>());
+        const uint32_t current = _open.back().second;
+        _open.pop_back();
+
+        // skip outdated entries
+        if (_closed[current] == _currentGeneration) continue;
+        _closed[current] = _currentGeneration;
+
+        if (current == dst) break;
+
+        const int x = current % _tileCountX, y = current / _tileCountX;
+        const int blockX = x / BLOCK_SIZE, blockY = y / BLOCK_SIZE;
+        const size_t block = blockX + blockY * blockCountX;
+        const std::vector<uint32_t>& nodes = graph.nodes[block];
+
+        // to the entrances of the same block
+        if (current == src) {
+            for (uint32_t node : nodes) {
+                const float cost = srcSearch.cost[getLocalIndex(node % _tileCountX, node / _tileCountX)];
+                if (cost != std::numeric_limits<float>::infinity()) relax(node, current, cost);
+            }
+        } else {
+            const size_t slot = graph.slots[current];
+            for (size_t i = 0; i < nodes.size(); ++i) {
+                const float cost = graph.costs[block][slot * nodes.size() + i];
+                if (cost != std::numeric_limits<float>::infinity()) relax(nodes[i], current, _cost[current] + cost);
+            }
+        }
+
+        // across the borders to the entrances of the neighbouring blocks
+        const int neighbours[4][2] = { { x - 1, y }, { x, y - 1 }, { x + 1, y }, { x, y + 1 } };
+        for (const auto& neighbour : neighbours)
+        {
+            if (neighbour[0] / BLOCK_SIZE == blockX && neighbour[1] / BLOCK_SIZE == blockY) continue;
+            if (neighbour[0] < 0 || neighbour[1] < 0 || neighbour[0] >= static_cast<int>(_tileCountX) || neighbour[1] >= static_cast<int>(mesh->_info.getTileCountY())) continue;
+            const uint32_t tile = neighbour[0] + neighbour[1] * _tileCountX;
+            if (NO_SLOT != graph.slots[tile]) relax(tile, current, _cost[current] + 1.0f);
+        }
+
+        // to the destination
+        if (blockX == dstBlockX && blockY == dstBlockY) {
+            const float cost = dstSearch.cost[getLocalIndex(x, y)];
+            if (cost != std::numeric_limits<float>::infinity()) relax(dst, current, _cost[current] + cost);
+        }
+    }
+    if (_closed[dst] != _currentGeneration) {
+        return false;
+    }
+
+    // Refine the abstract path to tiles, each step of it is within a block or across a border.
+    std::vector<uint32_t> nodes;
+    for (uint32_t node = _parent[dst]; AStar::NO_NODE != node; node = _parent[node]) {
+        nodes.push_back(node);
+    }
+    const uint32_t dst_tile = dst_ix + dst_iy * _tileCountX;
+    _path.push_back(src);
+    for (size_t i = nodes.size() - 1; i > 0; --i) {
+        refine(*mesh, stoppedBy, nodes[i], nodes[i - 1], _path);
+    }
+    refine(*mesh, stoppedBy, nodes.front(), dst_tile, _path);
+    std::reverse(_path.begin(), _path.end());
+    return true;
+}
+
+bool HierarchicalAStar::get_path(const int pos_x, const int dst_y, waypoint_list_t& wplst)
+{
+    return AStar::make_waypoints(_path, _tileCountX, false, pos_x, dst_y, wplst);
+}
+
+HierarchicalAStar g_hierarchicalAStar;
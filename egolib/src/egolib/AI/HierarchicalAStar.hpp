@@ -0,0 +1,118 @@
+//********************************************************************************************
+//*
+//*    This file is part of Egoboo.
+//*
+//*    Egoboo is free software: you can redistribute it and/or modify it
+//*    under the terms of the GNU General Public License as published by
+//*    the Free Software Foundation, either version 3 of the License, or
+//*    (at your option) any later version.
+//*
+//*    Egoboo is distributed in the hope that it will be useful, but
+//*    WITHOUT ANY WARRANTY; without even the implied warranty of
+//*    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+//*    General Public License for more details.
+//*
+//*    You should have received a copy of the GNU General Public License
+//*    along with Egoboo.  If not, see <http://www.gnu.org/licenses/>.
+//*
+//********************************************************************************************
+
+
+/// @file egolib/AI/HierarchicalAStar.hpp
+/// @brief Hierarchical A* pathfinding.
+/// @details Long paths are searched on an abstract graph over the blocks of a mesh
+///          and only refined to tiles within single blocks.
+
+#pragma once
+
+#include "egolib/AI/AStar.hpp"
+#include "egolib/FileFormats/map_file.h"
+
+// Forward declarations.
+class ego_mesh_t;
+struct waypoint_list_t;
+
+/**
+ * @brief
+ *  Hierarchical A* (HPA*) over the blocks of a mesh.
+ * @details
+ *  The nodes of the abstract graph are entrances, pairs of adjacent passable tiles
+ *  in neighbouring blocks. Each maximal run of such pairs along the border of two blocks
+ *  has one entrance in its middle. The costs between the entrances of a block are the
+ *  lengths of the shortest paths within the block and are cached. There is one graph for
+ *  each stoppedby mask that was searched with. If the fx of a tile change, then the
+ *  entrances and costs of its block and of the neighbouring blocks are recomputed with
+ *  the next search.
+ * @remark
+ *  Moves are 4-directional, like the moves of AStar::find_path by default.
+ * @remark
+ *  Not thread-safe: the path found by find_path() is kept until get_path(). Searches are
+ *  only made by the FindPath script function, which is not a concurrent script function.
+ */
+class HierarchicalAStar {
+
+public:
+    HierarchicalAStar();
+
+    /**
+     * @brief
+     *  Find a path between two tiles in blocks which are not adjacent.
+     * @return
+     *  @a true if a path was found, the path can be retrieved with get_path().
+     *  @a false if no path was found or if the tiles are in the same or adjacent blocks,
+     *  a search with AStar is cheaper for these.
+     */
+    bool find_path(const std::shared_ptr<const ego_mesh_t>& mesh, uint32_t stoppedBy, const int src_ix, const int src_iy, int dst_ix, int dst_iy);
+    bool get_path(const int pos_x, const int dst_y, waypoint_list_t& wplst);
+
+private:
+    static constexpr uint8_t NO_SLOT = std::numeric_limits<uint8_t>::max();
+    static constexpr int BLOCK_SIZE = 1 << (Info<int>::Block::Bits() - Info<int>::Grid::Bits());   ///< The size, in tiles, of a block
+    static constexpr int BLOCK_TILES = BLOCK_SIZE * BLOCK_SIZE;
+
+    /// The abstract graph for a stoppedby mask.
+    struct Graph
+    {
+        uint32_t stoppedBy;
+        uint32_t meshRevision;                      ///< The revision of the mesh when the graph was updated
+        std::vector<uint32_t> revisions;            ///< For each block, its revision when it was built
+        std::vector<std::vector<uint32_t>> nodes;   ///< For each block, the tiles of its entrances
+        std::vector<std::vector<float>> costs;      ///< For each block, the costs between its entrances (row-major)
+        std::vector<uint8_t> slots;                 ///< For each tile, its index in the entrances of its block or NO_SLOT
+    };
+
+    /// The shortest paths from a tile to the tiles of its block.
+    struct BlockSearch
+    {
+        float cost[BLOCK_TILES];    ///< The cost of the path to the tile, infinity if there is no path
+        uint8_t parent[BLOCK_TILES];///< The previous tile of the path to the tile (local index)
+    };
+
+    std::vector<Graph> _graphs;
+
+    // The search state of the tiles (see AStar). The destination is the tile with the index of the tile count.
+    std::vector<uint32_t> _generation;
+    std::vector<uint32_t> _closed;
+    std::vector<float> _cost;
+    std::vector<uint32_t> _parent;
+    uint32_t _currentGeneration;
+    std::vector<std::pair<float, uint32_t>> _open;  ///< Heap of the open tiles, smallest estimate first (may contain outdated entries)
+
+    std::vector<uint32_t> _path;                ///< The tiles of the path found, from the destination to the start
+    size_t _tileCountX;
+
+private:
+    Graph& getGraph(const ego_mesh_t& mesh, uint32_t stoppedBy);
+    void update(const ego_mesh_t& mesh, Graph& graph);
+    void buildEntrances(const ego_mesh_t& mesh, Graph& graph, int blockX, int blockY);
+    void buildCosts(const ego_mesh_t& mesh, Graph& graph, int blockX, int blockY);
+
+    /// @brief Search the shortest paths from a tile to all tiles of its block.
+    static void searchBlock(const ego_mesh_t& mesh, uint32_t stoppedBy, int x, int y, BlockSearch& search);
+    /// @brief Append the tiles of the shortest path within a block from a tile to another tile, excluding the first tile.
+    void refine(const ego_mesh_t& mesh, uint32_t stoppedBy, uint32_t from, uint32_t to, std::vector<uint32_t>& path) const;
+
+    static int getLocalIndex(int x, int y) { return (x % BLOCK_SIZE) + (y % BLOCK_SIZE) * BLOCK_SIZE; }
+};
+
+extern HierarchicalAStar g_hierarchicalAStar;
@@ -33,14 +33,8 @@ bool line_of_sight_info_t::blocked(line_of_sight_info_t& self, std::shared_ptr<c
 
 bool line_of_sight_info_t::with_mesh(line_of_sight_info_t& self, std::shared_ptr<const ego_mesh_t> mesh) {
     int Dx, Dy;
-    int ix, ix_stt, ix_end;
-    int iy, iy_stt, iy_end;
-
-    int Dbig, Dsmall;
-    int ibig, ibig_stt, ibig_end;
-    int ismall, ismall_stt, ismall_end;
-    int dbig, dsmall;
-    int TwoDsmall, TwoDsmallMinusTwoDbig, TwoDsmallMinusDbig;
+    int ix_stt, ix_end;
+    int iy_stt, iy_end;
 
     bool steep;
 
@@ -58,6 +52,48 @@ bool line_of_sight_info_t::with_mesh(line_of_sight_info_t& self, std::shared_ptr
 
     steep = (std::abs(Dy) >= std::abs(Dx));
 
+    // The ray only visits tiles within the rectangle spanned by its end tiles. If the blocks
+    // overlapped by that rectangle contain no blocking tile, then the ray is not blocked.
+    // This is only checked if there are not more blocks to check than steps along the ray.
+    IndexRect rect(Index2D(std::min(ix_stt, ix_end), std::min(iy_stt, iy_end)),
+                   Index2D(std::max(ix_stt, ix_end), std::max(iy_stt, iy_end)));
+    const size_t steps = std::max(std::abs(ix_end - ix_stt), std::abs(iy_end - iy_stt)) + 1;
+    if (mesh_block_fx_t::getBlockCount(rect) <= steps && mesh->_blockFX.isClear(self.stopped_by, rect))
+    {
+        return false;
+    }
+
+    // The visited tiles only depend on the end tiles and the direction of the ray.
+    const mesh_los_cache_t::key_t key = { ix_stt, iy_stt, ix_end, iy_end, self.stopped_by, steep };
+    mesh_los_cache_t::result_t result;
+    if (!mesh->_losCache.find(key, result))
+    {
+        result.blocked = walk(self, mesh, ix_stt, iy_stt, ix_end, iy_end, steep);
+        result.collideX = self.collide_x;
+        result.collideY = self.collide_y;
+        result.collideFX = self.collide_fx;
+        mesh->_losCache.insert(key, result);
+    }
+
+    if (result.blocked)
+    {
+        self.collide_x = result.collideX;
+        self.collide_y = result.collideY;
+        self.collide_fx = result.collideFX;
+    }
+    return result.blocked;
+}
+
+bool line_of_sight_info_t::walk(line_of_sight_info_t& self, const std::shared_ptr<const ego_mesh_t>& mesh,
+                                int ix_stt, int iy_stt, int ix_end, int iy_end, bool steep) {
+    int ix, iy;
+
+    int Dbig, Dsmall;
+    int ibig, ibig_stt, ibig_end;
+    int ismall, ismall_stt, ismall_end;
+    int dbig, dsmall;
+    int TwoDsmall, TwoDsmallMinusTwoDbig, TwoDsmallMinusDbig;
+
     // determine which are the big and small values
     if (steep)
     {
@@ -39,4 +39,10 @@ struct line_of_sight_info_t
     static bool blocked(line_of_sight_info_t& self, std::shared_ptr<const ego_mesh_t> mesh);
     static bool with_mesh(line_of_sight_info_t& self, std::shared_ptr<const ego_mesh_t> mesh);
     static bool with_characters(line_of_sight_info_t& self);
+
+private:
+    /// @brief Walk along the tiles of the ray from the start tile to the end tile.
+    /// @param steep if @a true the ray is stepped along the y-axis, otherwise along the x-axis
+    static bool walk(line_of_sight_info_t& self, const std::shared_ptr<const ego_mesh_t>& mesh,
+                     int ix_stt, int iy_stt, int ix_end, int iy_end, bool steep);
 };
\ No newline at end of file
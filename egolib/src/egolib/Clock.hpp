@@ -26,6 +26,7 @@
 #include "egolib/Time/LocalTime.hpp"
 #include "egolib/Time/Stopwatch.hpp"
 #include "egolib/Time/SlidingWindow.hpp"
+#include "egolib/Time/Profiler.hpp"
 
 namespace Ego {
 namespace Time {
@@ -142,6 +143,11 @@ protected:
 	 *	The stopwatch backing this clock.
 	 */
 	Stopwatch _stopwatch;
+	/**
+	 * @brief
+	 *	The ID of the profiler zone of this clock.
+	 */
+	Profiler::ZoneId _zoneId;
 
 protected:
 
@@ -158,7 +164,7 @@ protected:
 	 *	The clock is in its initial state w.r.t. the current point in time.
 	 */
 	AbstractClock(const std::string& name, size_t slidingWindowCapacity)
-		: _name(name), _stopwatch(), _slidingWindow(slidingWindowCapacity) {
+		: _name(name), _stopwatch(), _slidingWindow(slidingWindowCapacity), _zoneId(Profiler::getZoneId(name)) {
 		// Intentionally empty.
 	}
 	virtual ~AbstractClock() {
@@ -220,6 +226,9 @@ public:
 	 *	Enter the observed section.
 	 */
 	virtual void enter() {
+		if (Profiler::isCapturing()) {
+			Profiler::enterZone(_zoneId);
+		}
 		_stopwatch.reset();
 		_stopwatch.start();
 	}
@@ -235,6 +244,9 @@ public:
 		_slidingWindow.add(_stopwatch.elapsed());
 		// Reset the stopwatch.
 		_stopwatch.reset();
+		if (Profiler::isCapturing()) {
+			Profiler::leaveZone(_zoneId);
+		}
 	}
 
 	/**
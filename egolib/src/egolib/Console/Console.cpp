@@ -31,6 +31,7 @@
 #include "egolib/Graphics/GraphicsSystem.hpp"
 #include "egolib/Graphics/GraphicsWindow.hpp"
 #include "egolib/Renderer/Renderer.hpp"
+#include "egolib/Time/Profiler.hpp"
 #include "egolib/Extensions/ogl_include.h"
 #include "egolib/Extensions/ogl_extensions.h"
 #include "egolib/Extensions/SDL_extensions.h"
@@ -100,6 +101,33 @@ void ConsoleHistory::down() {
 
 ConsoleHandler *ConsoleHandler::_singleton = nullptr;
 
+bool ConsoleHandler::runDefaultCommands(Console *console, void *data) {
+	std::istringstream stream(console->buffer);
+	std::string command, argument;
+	stream >> command >> argument;
+	if (command != "profile") {
+		return false;
+	}
+	if (argument == "start") {
+		Ego::Time::Profiler::startCapture();
+		console->print("profiler capture started\n");
+	} else if (argument == "stop") {
+		Ego::Time::Profiler::stopCapture();
+		console->print("profiler capture stopped, %lu events\n", static_cast<unsigned long>(Ego::Time::Profiler::getNumberOfEvents()));
+	} else if (argument == "dump") {
+		std::string filename = "/debug/profile.json";
+		stream >> filename;
+		if (Ego::Time::Profiler::writeChromeTrace(filename)) {
+			console->print("profiler capture written to `%s`\n", filename.c_str());
+		} else {
+			console->print("unable to write profiler capture to `%s`\n", filename.c_str());
+		}
+	} else {
+		console->print("usage: profile start|stop|dump [<filename>]\n");
+	}
+	return true;
+}
+
 ConsoleHandler::ConsoleHandler() {
 	/// @author BB
 	/// @details initialize the console. This must happen after the screen has been defined,
@@ -114,8 +142,8 @@ ConsoleHandler::ConsoleHandler() {
 	blah.w = windowSize.width();
 	blah.h = windowSize.height() * 0.25f;
 
-	// without a callback, this console just dumps the input and generates no output
-	egolib_console_top = new Ego::Core::Console(blah, nullptr, nullptr);
+	// the default console only knows the built-in commands
+	egolib_console_top = new Ego::Core::Console(blah, &ConsoleHandler::runDefaultCommands, nullptr);
 }
 
 ConsoleHandler::~ConsoleHandler() {
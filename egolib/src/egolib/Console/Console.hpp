@@ -192,6 +192,18 @@ public:
     */
     SDL_Event *handle_event(SDL_Event *event);
 
+private:
+	/**
+	 * @brief
+	 *  The callback of the default console.
+	 *  Executes the commands
+	 *  - <tt>profile start</tt> start a profiler capture
+	 *  - <tt>profile stop</tt> stop the profiler capture
+	 *  - <tt>profile dump [&lt;filename&gt;]</tt> write the capture in the Chrome trace event format
+	 *    (default <tt>/debug/profile.json</tt>)
+	 */
+	static bool runDefaultCommands(Console *console, void *data);
+
 private:
 	static ConsoleHandler *_singleton;
 	ConsoleHandler();
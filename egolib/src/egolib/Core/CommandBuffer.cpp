@@ -0,0 +1,99 @@
+//********************************************************************************************
+//*
+//*    This file is part of Egoboo.
+//*
+//*    Egoboo is free software: you can redistribute it and/or modify it
+//*    under the terms of the GNU General Public License as published by
+//*    the Free Software Foundation, either version 3 of the License, or
+//*    (at your option) any later version.
+//*
+//*    Egoboo is distributed in the hope that it will be useful, but
+//*    WITHOUT ANY WARRANTY; without even the implied warranty of
+//*    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+//*    General Public License for more details.
+//*
+//*    You should have received a copy of the GNU General Public License
+//*    along with Egoboo.  If not, see <http://www.gnu.org/licenses/>.
+//*
+//********************************************************************************************
+
+/// @file   egolib/Core/CommandBuffer.cpp
+/// @brief  Deferred commands recorded concurrently and executed in a deterministic order.
+
+#include "egolib/Core/CommandBuffer.hpp"
+
+namespace Ego {
+namespace Core {
+
+CommandBuffer::CommandBuffer() :
+    _buffers(1),
+    _commands(),
+    _next(0) {
+    //ctor
+}
+
+void CommandBuffer::open() {
+    const size_t numberOfThreads = JobSystem::isInitialized() ? JobSystem::get().getNumberOfWorkers() + 1 : 1;
+    _buffers.resize(numberOfThreads);
+    for (std::vector<Entry>& buffer : _buffers) {
+        buffer.clear();
+    }
+    _commands.clear();
+    _next = 0;
+}
+
+void CommandBuffer::record(size_t key, Command command) {
+    const size_t index = JobSystem::isInitialized() ? JobSystem::get().getThreadIndex() : 0;
+    if (index >= _buffers.size()) {
+        throw std::logic_error("command buffer was not opened for this job system");
+    }
+    _buffers[index].push_back(Entry{key, std::move(command)});
+}
+
+void CommandBuffer::close() {
+    for (std::vector<Entry>& buffer : _buffers) {
+        std::move(buffer.begin(), buffer.end(), std::back_inserter(_commands));
+        buffer.clear();
+    }
+    // Stable, as the commands of one key are recorded by one thread in the order of execution.
+    std::stable_sort(_commands.begin() + _next, _commands.end(), [](const Entry& x, const Entry& y) {
+        return x.key < y.key;
+    });
+}
+
+void CommandBuffer::execute(size_t end) {
+    while (_next < _commands.size() && _commands[_next].key < end) {
+        Command command = std::move(_commands[_next++].command);
+        command();
+    }
+    if (_next == _commands.size()) {
+        _commands.clear();
+        _next = 0;
+    }
+}
+
+void CommandBuffer::execute() {
+    while (_next < _commands.size()) {
+        Command command = std::move(_commands[_next++].command);
+        command();
+    }
+    _commands.clear();
+    _next = 0;
+}
+
+void CommandBuffer::discard(size_t end) {
+    while (_next < _commands.size() && _commands[_next].key < end) {
+        _commands[_next++].command = nullptr;
+    }
+    if (_next == _commands.size()) {
+        _commands.clear();
+        _next = 0;
+    }
+}
+
+bool CommandBuffer::empty() const {
+    return _next == _commands.size();
+}
+
+} // namespace Core
+} // namespace Ego
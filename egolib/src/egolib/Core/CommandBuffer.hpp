@@ -0,0 +1,94 @@
+//********************************************************************************************
+//*
+//*    This file is part of Egoboo.
+//*
+//*    Egoboo is free software: you can redistribute it and/or modify it
+//*    under the terms of the GNU General Public License as published by
+//*    the Free Software Foundation, either version 3 of the License, or
+//*    (at your option) any later version.
+//*
+//*    Egoboo is distributed in the hope that it will be useful, but
+//*    WITHOUT ANY WARRANTY; without even the implied warranty of
+//*    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+//*    General Public License for more details.
+//*
+//*    You should have received a copy of the GNU General Public License
+//*    along with Egoboo.  If not, see <http://www.gnu.org/licenses/>.
+//*
+//********************************************************************************************
+
+/// @file   egolib/Core/CommandBuffer.hpp
+/// @brief  Deferred commands recorded concurrently and executed in a deterministic order.
+
+#pragma once
+
+#include "egolib/Core/JobSystem.hpp"
+
+namespace Ego {
+namespace Core {
+
+/// @brief Commands recorded concurrently by the threads of the job system and executed later by one thread.
+/// Every thread records into a buffer of its own, hence recording requires no locking. Commands are executed
+/// in the order of their keys (e.g. the index of the entity which recorded them in the serial update order).
+/// @remark If all commands with a given key are recorded by a single task, commands with equal keys are
+/// executed in the order in which they were recorded: the order of execution does not depend on the number
+/// of threads or on the scheduling of the tasks.
+/// @code
+/// commands.open();
+/// parallel_for(0, n, grainSize, [&commands](size_t begin, size_t end) {
+///     for (size_t i = begin; i < end; ++i) commands.record(i, [i]() { ... });
+/// });
+/// commands.close();
+/// for (size_t i = 0; i < n; ++i) {
+///     commands.execute(i + 1);
+///     ...
+/// }
+/// @endcode
+class CommandBuffer : public Id::NonCopyable {
+public:
+    using Command = std::function<void()>;
+
+    CommandBuffer();
+
+    /// @brief Start recording.
+    /// @remark Remaining commands of the previous recording are discarded.
+    void open();
+
+    /// @brief Record a command.
+    /// @param key the key of the command
+    /// @param command the command
+    /// @remark May be called concurrently by the threads of the job system between open() and close().
+    void record(size_t key, Command command);
+
+    /// @brief Stop recording and sort the recorded commands by their keys.
+    void close();
+
+    /// @brief Execute and remove all commands with keys smaller than @a end.
+    /// @remark Commands must not record further commands.
+    void execute(size_t end);
+
+    /// @brief Execute and remove all commands.
+    void execute();
+
+    /// @brief Remove all commands with keys smaller than @a end without executing them.
+    void discard(size_t end);
+
+    /// @brief Get if commands are waiting for execution.
+    bool empty() const;
+
+private:
+    struct Entry {
+        size_t key;
+        Command command;
+    };
+
+    /// @brief The buffers the threads record into, one for each thread of the job system.
+    std::vector<std::vector<Entry>> _buffers;
+    /// @brief The commands of all threads sorted by their keys.
+    std::vector<Entry> _commands;
+    /// @brief The index of the next command in _commands to execute.
+    size_t _next;
+};
+
+} // namespace Core
+} // namespace Ego
@@ -0,0 +1,205 @@
+//********************************************************************************************
+//*
+//*    This file is part of Egoboo.
+//*
+//*    Egoboo is free software: you can redistribute it and/or modify it
+//*    under the terms of the GNU General Public License as published by
+//*    the Free Software Foundation, either version 3 of the License, or
+//*    (at your option) any later version.
+//*
+//*    Egoboo is distributed in the hope that it will be useful, but
+//*    WITHOUT ANY WARRANTY; without even the implied warranty of
+//*    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+//*    General Public License for more details.
+//*
+//*    You should have received a copy of the GNU General Public License
+//*    along with Egoboo.  If not, see <http://www.gnu.org/licenses/>.
+//*
+//********************************************************************************************
+
+/// @file   egolib/Core/JobSystem.cpp
+/// @brief  A work-stealing job system.
+
+#include "egolib/Core/JobSystem.hpp"
+
+namespace Ego {
+namespace Core {
+
+TaskGroup::TaskGroup() :
+    _pending(0),
+    _exceptionMutex(),
+    _exception() {
+    //ctor
+}
+
+TaskGroup::~TaskGroup() {
+    help();
+}
+
+void TaskGroup::run(std::function<void()> task) {
+    if (!JobSystem::isInitialized()) {
+        _pending++;
+        execute(task);
+        return;
+    }
+    _pending++;
+    JobSystem::get().submit(*this, std::move(task));
+}
+
+void TaskGroup::wait() {
+    help();
+    std::exception_ptr exception;
+    {
+        std::lock_guard<std::mutex> lock(_exceptionMutex);
+        std::swap(exception, _exception);
+    }
+    if (exception) {
+        std::rethrow_exception(exception);
+    }
+}
+
+void TaskGroup::execute(const std::function<void()>& task) {
+    try {
+        task();
+    } catch (...) {
+        std::lock_guard<std::mutex> lock(_exceptionMutex);
+        if (!_exception) {
+            _exception = std::current_exception();
+        }
+    }
+    _pending--;
+}
+
+void TaskGroup::help() {
+    while (_pending > 0) {
+        if (!JobSystem::isInitialized() || !JobSystem::get().executeOne()) {
+            // The remaining tasks of this group are executed by other threads.
+            std::this_thread::yield();
+        }
+    }
+}
+
+thread_local size_t JobSystem::t_queueIndex = std::numeric_limits<size_t>::max();
+
+JobSystem::JobSystem() :
+    JobSystem(getDefaultNumberOfWorkers()) {
+    //ctor
+}
+
+JobSystem::JobSystem(size_t numberOfWorkers) :
+    _numberOfWorkers(numberOfWorkers),
+    _queues(),
+    _workers(),
+    _numberOfQueuedTasks(0),
+    _numberOfSleepingWorkers(0),
+    _terminateRequested(false),
+    _sleepMutex(),
+    _wakeUp() {
+    for (size_t i = 0; i < numberOfWorkers + 1; ++i) {
+        _queues.push_back(std::make_unique<Queue>());
+    }
+    for (size_t i = 0; i < numberOfWorkers; ++i) {
+        _workers.emplace_back([this, i]() { run(i); });
+    }
+}
+
+JobSystem::~JobSystem() {
+    {
+        std::lock_guard<std::mutex> lock(_sleepMutex);
+        _terminateRequested = true;
+    }
+    _wakeUp.notify_all();
+    for (std::thread& worker : _workers) {
+        worker.join();
+    }
+}
+
+size_t JobSystem::getDefaultNumberOfWorkers() {
+    const size_t numberOfHardwareThreads = std::thread::hardware_concurrency();
+    return numberOfHardwareThreads > 1 ? numberOfHardwareThreads - 1 : 0;
+}
+
+size_t JobSystem::getNumberOfWorkers() const {
+    return _numberOfWorkers;
+}
+
+size_t JobSystem::getThreadIndex() const {
+    // Threads other than the workers of this job system use the shared queue.
+    return t_queueIndex < _numberOfWorkers ? t_queueIndex : _numberOfWorkers;
+}
+
+void JobSystem::submit(TaskGroup& group, std::function<void()> task) {
+    Queue& queue = *_queues[getThreadIndex()];
+    _numberOfQueuedTasks++;
+    {
+        std::lock_guard<std::mutex> lock(queue.mutex);
+        queue.tasks.push_back(Task{&group, std::move(task)});
+    }
+    // A worker going to sleep increments the number of sleeping workers before it checks the number of
+    // queued tasks (with the sleep mutex locked). Hence either it sees the new task or it is woken up here.
+    if (_numberOfSleepingWorkers > 0) {
+        { std::lock_guard<std::mutex> lock(_sleepMutex); }
+        _wakeUp.notify_one();
+    }
+}
+
+bool JobSystem::executeOne() {
+    const size_t index = getThreadIndex();
+    Task task;
+    if (!pop(index, task) && !steal(index, task)) {
+        return false;
+    }
+    _numberOfQueuedTasks--;
+    task.group->execute(task.function);
+    return true;
+}
+
+bool JobSystem::pop(size_t index, Task& task) {
+    Queue& queue = *_queues[index];
+    std::lock_guard<std::mutex> lock(queue.mutex);
+    if (queue.tasks.empty()) {
+        return false;
+    }
+    task = std::move(queue.tasks.back());
+    queue.tasks.pop_back();
+    return true;
+}
+
+bool JobSystem::steal(size_t index, Task& task) {
+    for (size_t i = 1; i < _queues.size(); ++i) {
+        Queue& queue = *_queues[(index + i) % _queues.size()];
+        std::unique_lock<std::mutex> lock(queue.mutex, std::try_to_lock);
+        if (!lock.owns_lock() || queue.tasks.empty()) {
+            continue;
+        }
+        task = std::move(queue.tasks.front());
+        queue.tasks.pop_front();
+        return true;
+    }
+    return false;
+}
+
+void JobSystem::run(size_t index) {
+    static const size_t SpinCount = 64;
+    t_queueIndex = index;
+    size_t idle = 0;
+    while (!_terminateRequested) {
+        if (executeOne()) {
+            idle = 0;
+            continue;
+        }
+        // Spin for a while before going to sleep: tasks often arrive in bursts.
+        if (++idle < SpinCount) {
+            std::this_thread::yield();
+            continue;
+        }
+        std::unique_lock<std::mutex> lock(_sleepMutex);
+        _numberOfSleepingWorkers++;
+        _wakeUp.wait(lock, [this]() { return _terminateRequested || _numberOfQueuedTasks > 0; });
+        _numberOfSleepingWorkers--;
+        idle = 0;
+    }
+}
+
+} // namespace Core
+} // namespace Ego
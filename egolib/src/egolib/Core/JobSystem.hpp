@@ -0,0 +1,185 @@
+//********************************************************************************************
+//*
+//*    This file is part of Egoboo.
+//*
+//*    Egoboo is free software: you can redistribute it and/or modify it
+//*    under the terms of the GNU General Public License as published by
+//*    the Free Software Foundation, either version 3 of the License, or
+//*    (at your option) any later version.
+//*
+//*    Egoboo is distributed in the hope that it will be useful, but
+//*    WITHOUT ANY WARRANTY; without even the implied warranty of
+//*    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+//*    General Public License for more details.
+//*
+//*    You should have received a copy of the GNU General Public License
+//*    along with Egoboo.  If not, see <http://www.gnu.org/licenses/>.
+//*
+//********************************************************************************************
+
+/// @file   egolib/Core/JobSystem.hpp
+/// @brief  A work-stealing job system.
+
+#pragma once
+
+#include "egolib/Core/Singleton.hpp"
+
+namespace Ego {
+namespace Core {
+
+/// @brief A group of tasks which is waited for as a whole.
+/// @remark If the job system is not initialized, tasks are executed immediately by TaskGroup::run.
+/// @remark The first exception raised by a task of the group is re-raised by TaskGroup::wait.
+class TaskGroup : public Id::NonCopyable {
+public:
+    TaskGroup();
+    /// @brief Destruct this task group.
+    /// @remark Waits for all tasks of this group, discarding exceptions raised by them.
+    ~TaskGroup();
+
+    /// @brief Run a task as part of this group.
+    /// @param task the task
+    void run(std::function<void()> task);
+
+    /// @brief Wait until all tasks of this group have been executed.
+    /// @remark The waiting thread executes queued tasks (of any group) while waiting.
+    /// @throw the first exception raised by a task of this group
+    void wait();
+
+private:
+    friend class JobSystem;
+    /// @brief Execute a task of this group and mark it as done.
+    void execute(const std::function<void()>& task);
+    /// @brief Help the job system until all tasks of this group have been executed.
+    void help();
+
+    std::atomic<size_t> _pending;
+    std::mutex _exceptionMutex;
+    std::exception_ptr _exception;
+};
+
+/// @brief A work-stealing job system.
+/// Every worker thread owns a double-ended queue of tasks. A worker pushes and pops tasks at the back
+/// of its own queue, idle workers steal the oldest (and usually largest) tasks from the front of the
+/// queues of other workers. Threads which are not workers (the main thread, the loading thread) share
+/// one additional queue. Any thread waiting for a TaskGroup executes tasks while it waits.
+class JobSystem : public Singleton<JobSystem> {
+protected:
+    friend Singleton<JobSystem>::CreateFunctorType;
+    friend Singleton<JobSystem>::DestroyFunctorType;
+    /// @brief Construct this job system.
+    /// @param numberOfWorkers the number of worker threads
+    /// @remark Intentionally protected.
+    JobSystem(size_t numberOfWorkers);
+    /// @brief Construct this job system with the default number of worker threads.
+    /// @remark Intentionally protected.
+    JobSystem();
+    /// @brief Destruct this job system.
+    /// @remark Intentionally protected.
+    virtual ~JobSystem();
+
+public:
+    /// @brief Get the default number of worker threads.
+    /// @return one less than the number of hardware threads (the main thread is the remaining one)
+    static size_t getDefaultNumberOfWorkers();
+
+    /// @brief Get the number of worker threads.
+    size_t getNumberOfWorkers() const;
+
+    /// @brief Get the index of the calling thread.
+    /// @return the index of the worker if the calling thread is a worker, getNumberOfWorkers() otherwise
+    /// @remark Use this index to select per-thread data, e.g. command buffers.
+    size_t getThreadIndex() const;
+
+    /// @brief Queue a task of a task group.
+    void submit(TaskGroup& group, std::function<void()> task);
+
+    /// @brief Execute one queued task, if any.
+    /// @return @a true if a task was executed, @a false if no task was queued
+    bool executeOne();
+
+private:
+    struct Task {
+        TaskGroup *group;
+        std::function<void()> function;
+    };
+
+    struct Queue {
+        std::mutex mutex;
+        std::deque<Task> tasks;
+    };
+
+    /// @brief The entry point of a worker thread.
+    void run(size_t index);
+
+    /// @brief Pop the newest task from the queue of the calling thread.
+    bool pop(size_t index, Task& task);
+
+    /// @brief Steal the oldest task from the queue of another thread.
+    bool steal(size_t index, Task& task);
+
+    const size_t _numberOfWorkers;
+    /// @brief The queues, one for each worker followed by the queue shared by all other threads.
+    std::vector<std::unique_ptr<Queue>> _queues;
+    std::vector<std::thread> _workers;
+
+    std::atomic<size_t> _numberOfQueuedTasks;
+    std::atomic<size_t> _numberOfSleepingWorkers;
+    std::atomic<bool> _terminateRequested;
+    std::mutex _sleepMutex;
+    std::condition_variable _wakeUp;
+
+    /// @brief The index of the queue of the calling thread if it is a worker of this job system.
+    static thread_local size_t t_queueIndex;
+};
+
+template <>
+struct CreateFunctor<JobSystem> {
+    JobSystem *operator()() const {
+        return new JobSystem();
+    }
+    JobSystem *operator()(size_t numberOfWorkers) const {
+        return new JobSystem(numberOfWorkers);
+    }
+};
+
+namespace Internal {
+template <typename Function>
+void parallel_for(TaskGroup& group, size_t begin, size_t end, size_t grainSize, const Function& function) {
+    // Hand the upper halves to the job system where idle workers can steal them, process the lowest chunk.
+    while (end - begin > grainSize) {
+        const size_t middle = begin + (end - begin) / 2;
+        group.run([&group, middle, end, grainSize, &function]() {
+            parallel_for(group, middle, end, grainSize, function);
+        });
+        end = middle;
+    }
+    function(begin, end);
+}
+} // namespace Internal
+
+/// @brief Invoke a function for sub-ranges of the index range <tt>[begin, end)</tt> in parallel.
+/// @param begin, end the index range
+/// @param grainSize the maximum size of a sub-range
+/// @param function a function <tt>void(size_t begin, size_t end)</tt> invoked for each sub-range.
+/// It is invoked concurrently by several threads.
+/// @remark The range is processed by the calling thread if it is not larger than the grain size or if
+/// the job system is not initialized or has no workers.
+/// @throw the first exception raised by an invocation of @a function
+template <typename Function>
+void parallel_for(size_t begin, size_t end, size_t grainSize, const Function& function) {
+    if (begin >= end) {
+        return;
+    }
+    grainSize = std::max<size_t>(1, grainSize);
+    if (end - begin <= grainSize || !JobSystem::isInitialized() || 0 == JobSystem::get().getNumberOfWorkers()) {
+        function(begin, end);
+        return;
+    }
+    TaskGroup group;
+    Internal::parallel_for(group, begin, end, grainSize, function);
+    group.wait();
+}
+
+} // namespace Core
+} // namespace Ego
@@ -0,0 +1,303 @@
+//********************************************************************************************
+//*
+//*    This file is part of Egoboo.
+//*
+//*    Egoboo is free software: you can redistribute it and/or modify it
+//*    under the terms of the GNU General Public License as published by
+//*    the Free Software Foundation, either version 3 of the License, or
+//*    (at your option) any later version.
+//*
+//*    Egoboo is distributed in the hope that it will be useful, but
+//*    WITHOUT ANY WARRANTY; without even the implied warranty of
+//*    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+//*    General Public License for more details.
+//*
+//*    You should have received a copy of the GNU General Public License
+//*    along with Egoboo.  If not, see <http://www.gnu.org/licenses/>.
+//*
+//********************************************************************************************
+
+/// @file   egolib/Core/LooseGrid.hpp
+/// @brief  Loose uniform grid for fast element lookup based on bounding boxes
+
+#pragma once
+
+#include "egolib/Math/_Include.hpp"
+#include "egolib/Math/Standard.hpp"
+
+namespace Ego
+{
+
+/**
+* @brief
+*   A loose uniform grid. Every element is stored in exactly one cell (the cell containing
+*   the center of its bounding box) and searches are widened by the largest half-extent
+*   of any element in the grid. Elements are identified by a caller-supplied key (e.g. an
+*   object reference) and cells only store these keys, so an element that stays within its
+*   cell costs nothing to update and a search never yields the same element twice.
+* @remark
+*   The grid does not own its elements. Elements which are destroyed without being removed
+*   are skipped by queries and dropped the next time their key is updated or removed.
+**/
+template<typename T>
+class LooseGrid
+{
+public:
+    /**
+    * @brief
+    *   Construct an empty grid with the specified cell size. The grid has no cells until
+    *   reset() is called.
+    **/
+    LooseGrid(const float cellSize) :
+        _cellSize(cellSize),
+        _minX(0.0f),
+        _minY(0.0f),
+        _maxX(0.0f),
+        _maxY(0.0f),
+        _cellCountX(0),
+        _cellCountY(0),
+        _maxExtent(0.0f),
+        _cells(),
+        _entries()
+    {
+        //ctor
+    }
+
+    /**
+    * @brief
+    *   Removes all elements and sets the bounds of this grid
+    **/
+    void reset(const float minX, const float minY, const float maxX, const float maxY)
+    {
+        _minX = minX;
+        _minY = minY;
+        _maxX = maxX;
+        _maxY = maxY;
+        _cellCountX = std::max<size_t>(1, static_cast<size_t>(std::ceil((maxX - minX) / _cellSize)));
+        _cellCountY = std::max<size_t>(1, static_cast<size_t>(std::ceil((maxY - minY) / _cellSize)));
+        _maxExtent = 0.0f;
+
+        _cells.clear();
+        _cells.resize(_cellCountX * _cellCountY);
+        _entries.clear();
+    }
+
+    /**
+    * @return
+    *   true if this grid was reset with exactly the specified bounds
+    **/
+    bool hasBounds(const float minX, const float minY, const float maxX, const float maxY) const
+    {
+        return !_cells.empty() && _minX == minX && _minY == minY && _maxX == maxX && _maxY == maxY;
+    }
+
+    /**
+    * @brief
+    *   Inserts an element or moves it to the cell its bounding box currently belongs to
+    * @param key
+    *   unique key of the element
+    * @return
+    *   true if the element was inserted or changed cell, false if it was already in the right cell
+    **/
+    bool update(const size_t key, const std::shared_ptr<T> &element)
+    {
+        const AxisAlignedBox2f &bounds = element->getAxisAlignedBox2D();
+        const Vector2f extent = bounds.getSize() * 0.5f;
+        _maxExtent = std::max(_maxExtent, std::max(extent[kX], extent[kY]));
+
+        const Point2f center = bounds.getCenter();
+        const uint32_t cell = getCell(getCellX(center[kX]), getCellY(center[kY]));
+
+        if(key >= _entries.size()) {
+            _entries.resize(key + 1);
+        }
+        Entry &entry = _entries[key];
+
+        //Nothing to do if the element did not change cell
+        if(entry.pointer == element.get() && entry.cell == cell) {
+            return false;
+        }
+
+        //A different element with the same key (e.g. a reused object reference) is replaced
+        if(entry.cell != NO_CELL) {
+            unlink(entry);
+        }
+        entry.element = element;
+        entry.pointer = element.get();
+        entry.cell = cell;
+        entry.slot = static_cast<uint32_t>(_cells[cell].size());
+        _cells[cell].push_back(static_cast<uint32_t>(key));
+        return true;
+    }
+
+    /**
+    * @brief
+    *   Removes an element from this grid
+    * @param key
+    *   unique key of the element
+    * @param element
+    *   the element to remove. Nothing is removed if the key now belongs to another element.
+    **/
+    void remove(const size_t key, const T *element)
+    {
+        if(key >= _entries.size()) {
+            return;
+        }
+        Entry &entry = _entries[key];
+        if(entry.cell != NO_CELL && entry.pointer == element) {
+            unlink(entry);
+        }
+    }
+
+    /**
+    * @brief
+    *   Find all elements that collide with a search area
+    * @param searchArea
+    *   The bounding box which is used for finding elements
+    * @param result
+    *   Vector of all elements that fit within the search area
+    **/
+    void find(const AxisAlignedBox2f &searchArea, std::vector<std::shared_ptr<T>> &result) const
+    {
+        find(searchArea, result, [](const std::shared_ptr<T>&) { return true; });
+    }
+
+    /**
+    * @brief
+    *   Find all elements that collide with a search area and satisfy a predicate
+    * @param searchArea
+    *   The bounding box which is used for finding elements
+    * @param result
+    *   Vector of all elements that fit within the search area
+    * @param predicate
+    *   only elements for which this returns true are added to the result
+    **/
+    template<typename Predicate>
+    void find(const AxisAlignedBox2f &searchArea, std::vector<std::shared_ptr<T>> &result, Predicate predicate) const
+    {
+        traverse(searchArea, [&result, &predicate](const Entry &entry) {
+            //Make sure element still exists
+            std::shared_ptr<T> element = entry.element.lock();
+            if(element != nullptr && predicate(element)) {
+                result.push_back(element);
+            }
+        });
+    }
+
+    /**
+    * @brief
+    *   Visit all elements that collide with a search area without allocating memory
+    * @param searchArea
+    *   The bounding box which is used for finding elements
+    * @param visitor
+    *   A function object called with a reference to every element (<tt>T&</tt>) within the search area
+    * @remark
+    *   Elements are not locked while they are visited, the caller must keep them alive.
+    *   Any number of threads may visit the grid at the same time as long as it is not modified.
+    **/
+    template<typename Visitor>
+    void visit(const AxisAlignedBox2f &searchArea, Visitor visitor) const
+    {
+        traverse(searchArea, [&visitor](const Entry &entry) {
+            visitor(*entry.pointer);
+        });
+    }
+
+private:
+    static const uint32_t NO_CELL = std::numeric_limits<uint32_t>::max();
+
+    struct Entry
+    {
+        Entry() : element(), pointer(nullptr), cell(NO_CELL), slot(0) {}
+
+        std::weak_ptr<T> element;   //< The element
+        T *pointer;                 //< Identity of the element, only dereferenced while element is not expired
+        uint32_t cell;              //< Index of the cell containing the element or NO_CELL
+        uint32_t slot;              //< Index of the key within that cell
+    };
+
+    /**
+    * @brief
+    *   Call a function for every live entry whose bounding box intersects the search area
+    **/
+    template<typename Function>
+    void traverse(const AxisAlignedBox2f &searchArea, Function function) const
+    {
+        if(_cells.empty()) {
+            return;
+        }
+
+        //An element can reach at most _maxExtent beyond the cell containing its center
+        const size_t minCellX = getCellX(searchArea.getMin()[kX] - _maxExtent);
+        const size_t minCellY = getCellY(searchArea.getMin()[kY] - _maxExtent);
+        const size_t maxCellX = getCellX(searchArea.getMax()[kX] + _maxExtent);
+        const size_t maxCellY = getCellY(searchArea.getMax()[kY] + _maxExtent);
+
+        Ego::Math::Intersects<AxisAlignedBox2f, AxisAlignedBox2f> intersects;
+        for(size_t y = minCellY; y <= maxCellY; ++y) {
+            for(size_t x = minCellX; x <= maxCellX; ++x) {
+                for(const uint32_t key : _cells[getCell(x, y)]) {
+                    const Entry &entry = _entries[key];
+
+                    //Make sure element still exists
+                    if(entry.element.expired()) {
+                        continue;
+                    }
+
+                    //Check if element is within search area
+                    if(intersects(entry.pointer->getAxisAlignedBox2D(), searchArea)) {
+                        function(entry);
+                    }
+                }
+            }
+        }
+    }
+
+    size_t getCellX(const float x) const
+    {
+        const float cell = std::floor((x - _minX) / _cellSize);
+        return static_cast<size_t>(Ego::Math::constrain(cell, 0.0f, static_cast<float>(_cellCountX - 1)));
+    }
+
+    size_t getCellY(const float y) const
+    {
+        const float cell = std::floor((y - _minY) / _cellSize);
+        return static_cast<size_t>(Ego::Math::constrain(cell, 0.0f, static_cast<float>(_cellCountY - 1)));
+    }
+
+    uint32_t getCell(const size_t x, const size_t y) const
+    {
+        return static_cast<uint32_t>(y * _cellCountX + x);
+    }
+
+    /**
+    * @brief
+    *   Remove an entry from its cell by moving the last key of that cell into its slot
+    **/
+    void unlink(Entry &entry)
+    {
+        std::vector<uint32_t> &cell = _cells[entry.cell];
+        const uint32_t last = cell.back();
+        cell[entry.slot] = last;
+        _entries[last].slot = entry.slot;
+        cell.pop_back();
+
+        entry.element.reset();
+        entry.pointer = nullptr;
+        entry.cell = NO_CELL;
+    }
+
+private:
+    float _cellSize;                                //< Width and height of a cell
+    float _minX, _minY, _maxX, _maxY;               //< Bounds of the grid, elements outside are clamped to the border cells
+    size_t _cellCountX, _cellCountY;                //< Number of cells along each axis
+    float _maxExtent;                               //< Largest half-extent of any element inserted since the last reset
+
+    std::vector<std::vector<uint32_t>> _cells;      //< Keys of the elements whose center is in each cell
+    std::vector<Entry> _entries;                    //< Per-key location of each element
+};
+
+template<typename T>
+const uint32_t LooseGrid<T>::NO_CELL;
+
+} //namespace Ego
@@ -29,6 +29,16 @@
 namespace Ego
 {
 
+/**
+* @brief
+*   A QuadTree subdivides its bounds as elements are inserted, hence it suits elements spread
+*   unevenly over large or unbounded areas. The game indexes its objects and particles with a
+*   Ego::LooseGrid and an Ego::SpatialHash instead, which are updated incrementally; QuadTree has
+*   the same queries, so either can back a spatial lookup.
+* @remark
+*   Queries do not modify the tree: any number of threads may query it at the same time as long
+*   as it is not modified, and a visitor may query the tree again.
+**/
 template<typename T>
 class QuadTree
 {
@@ -52,12 +62,8 @@ public:
     *   Constructor with bounded limits
     **/
     QuadTree(const float minX, const float minY, const float maxX, const float maxY) :
-        _bounds(Point2f(minX, minY), Point2f(maxX, maxY)),
-        _nodes(),
-        _northWest(nullptr),
-        _northEast(nullptr),
-        _southWest(nullptr),
-        _southEast(nullptr)
+        _root(AxisAlignedBox2f(Point2f(minX, minY), Point2f(maxX, maxY))),
+        _elements()
     {
         //ctor
     }
@@ -71,32 +77,39 @@ public:
     bool insert(const std::shared_ptr<T> &element)
     {
         Ego::Math::Intersects<AxisAlignedBox2f,AxisAlignedBox2f> intersects;
+        const AxisAlignedBox2f &bounds = element->getAxisAlignedBox2D();
+
         //Element does not belong in this tree
-        if(!intersects(_bounds, element->getAxisAlignedBox2D())) {
+        if(!intersects(_root.bounds, bounds)) {
             return false;
         }
 
-        //Check if we have room
-        if(_nodes.size() < QUAD_TREE_NODE_CAPACITY) {
-            _nodes.push_back(element);
-            return true;
-        }
-
-        // Otherwise, subdivide and then add the point to whichever node will accept it
-        if(_northWest == nullptr) {
-            subdivide();
-        }
-
-        //Add element to a sub-tree
-        _northWest->insert(element);
-        _northEast->insert(element);
-        _southWest->insert(element);
-        _southEast->insert(element);
-
-        //Should be added to at least 1
+        //Nodes only store the index of the element
+        _elements.emplace_back(element, intersection(_root.bounds, bounds));
+        _root.insert(static_cast<uint32_t>(_elements.size() - 1), bounds);
         return true;
     }
 
+    /**
+    * @brief
+    *   Visit all elements that collide with a search area. Every element is visited at most once
+    *   and no memory is allocated.
+    * @param searchArea
+    *   The bounding box which is used for finding elements
+    * @param visitor
+    *   A function object called with a reference to every element (<tt>T&</tt>) within the search area
+    * @remark
+    *   Elements which moved since they were inserted are only found where their old bounds
+    *   overlap the search area. Rebuild the tree after moving elements.
+    **/
+    template<typename Visitor>
+    void visit(const AxisAlignedBox2f &searchArea, Visitor visitor) const
+    {
+        traverse(searchArea, [&visitor](const Element &element) {
+            visitor(*element.pointer);
+        });
+    }
+
     /**
     * @brief
     *   Find all elements that are within range of a specified point in this QuadTree's
@@ -108,38 +121,13 @@ public:
     **/
     void find(const AxisAlignedBox2f &searchArea, std::vector<std::shared_ptr<T>> &result) const
     {
-        Ego::Math::Intersects<AxisAlignedBox2f, AxisAlignedBox2f> intersects;
-        //Search grid is not part of our bounds
-        if(!intersects(_bounds, searchArea)) {
-            return;
-        }
-
-        //Check all nodes in this QuadTree
-        for(const std::weak_ptr<T> &weakElement : _nodes) {
-            std::shared_ptr<T> element = weakElement.lock();
-
+        traverse(searchArea, [&result](const Element &element) {
             //Make sure element still exists
-            if(element != nullptr) {
-
-                //Already added?
-                if(std::find(result.begin(), result.end(), element) != result.end()) {
-                    continue;
-                }
-
-                //Check if element is within search area
-                if(intersects(element->getAxisAlignedBox2D(), searchArea)) {
-                    result.push_back(element);
-                }
+            std::shared_ptr<T> pointer = element.element.lock();
+            if(pointer != nullptr) {
+                result.push_back(pointer);
             }
-        }
-
-        //Check subtrees (if any)
-        if(_northWest != nullptr) {
-            _northWest->find(searchArea, result);
-            _northEast->find(searchArea, result);
-            _southWest->find(searchArea, result);
-            _southEast->find(searchArea, result);
-        }
+        });
     }
 
     /**
@@ -149,50 +137,175 @@ public:
     void clear(const float minX, const float minY, const float maxX, const float maxY)
     {
         //Reset bounds
-        _bounds = AxisAlignedBox2f(Point2f(minX, minY), Point2f(maxX, maxY));
+        _root.bounds = AxisAlignedBox2f(Point2f(minX, minY), Point2f(maxX, maxY));
 
         //Clear children and all elements
-        _nodes.clear();
-        _northWest.reset();
-        _northEast.reset();
-        _southWest.reset();
-        _southEast.reset();
+        _root.clear();
+        _elements.clear();
     }
 
 private:
+    struct Element
+    {
+        Element(const std::shared_ptr<T> &element, const AxisAlignedBox2f &bounds) : element(element), pointer(element.get()), bounds(bounds) {}
+
+        std::weak_ptr<T> element;               //< The element
+        T *pointer;                             //< Raw pointer, only dereferenced while element is not expired
+        AxisAlignedBox2f bounds;                //< Bounds of the element when inserted, within the bounds of the tree
+    };
+
+    struct Node
+    {
+        Node(const AxisAlignedBox2f &bounds) :
+            bounds(bounds),
+            elements(),
+            northWest(nullptr),
+            northEast(nullptr),
+            southWest(nullptr),
+            southEast(nullptr)
+        {
+            //ctor
+        }
+
+        void insert(const uint32_t index, const AxisAlignedBox2f &elementBounds)
+        {
+            Ego::Math::Intersects<AxisAlignedBox2f,AxisAlignedBox2f> intersects;
+            //Element does not belong in this node
+            if(!intersects(bounds, elementBounds)) {
+                return;
+            }
+
+            //Check if we have room
+            if(elements.size() < QUAD_TREE_NODE_CAPACITY) {
+                elements.push_back(index);
+                return;
+            }
+
+            // Otherwise, subdivide and then add the point to whichever node will accept it
+            if(northWest == nullptr) {
+                subdivide();
+            }
+
+            //Add element to a sub-tree
+            northWest->insert(index, elementBounds);
+            northEast->insert(index, elementBounds);
+            southWest->insert(index, elementBounds);
+            southEast->insert(index, elementBounds);
+        }
+
+        void clear()
+        {
+            elements.clear();
+            northWest.reset();
+            northEast.reset();
+            southWest.reset();
+            southEast.reset();
+        }
+
+        /**
+        * @brief
+        *   Helper function to subdivide this node into four more nodes
+        **/
+        void subdivide()
+        {
+            float topLeftX = bounds.getMin()[kX];
+            float topLeftY = bounds.getMin()[kY];
+
+            float bottomRightX = bounds.getMax()[kX];
+            float bottomRightY = bounds.getMax()[kY];
+
+            float midX = (topLeftX + bottomRightX) * 0.5f;
+            float midY = (topLeftY + bottomRightY) * 0.5f;
+
+            //Allocate memory for the subdivision
+            northWest = std::make_unique<Node>(AxisAlignedBox2f(Point2f(topLeftX, topLeftY), Point2f(midX, midY)));
+            northEast = std::make_unique<Node>(AxisAlignedBox2f(Point2f(midX, topLeftY), Point2f(bottomRightX, midY)));
+            southWest = std::make_unique<Node>(AxisAlignedBox2f(Point2f(topLeftX, midY), Point2f(midX, bottomRightY)));
+            southEast = std::make_unique<Node>(AxisAlignedBox2f(Point2f(midX, midY), Point2f(bottomRightX, bottomRightY)));
+        }
+
+        AxisAlignedBox2f bounds;                //< 2D AABB
+        std::vector<uint32_t> elements;         //< Indices of the elements contained in this node
+
+        std::unique_ptr<Node> northWest;
+        std::unique_ptr<Node> northEast;
+        std::unique_ptr<Node> southWest;
+        std::unique_ptr<Node> southEast;
+    };
+
     /**
     * @brief
-    *   Helper function to subdivide this QuadTree into four more QuadTrees
+    *   Call a function for every element whose bounding box intersects the search area.
+    * @remark
+    *   The nodes storing an element do not overlap (apart from their edges) and cover the
+    *   bounds it was inserted with. An element stored in several nodes is only reported by
+    *   the node containing its reference point, the point of its inserted bounds closest to
+    *   the minimum of the search area. Node bounds include their minimum edges only, except
+    *   at the maximum edges of the tree.
     **/
-    void subdivide()
+    template<typename Function>
+    void traverse(const AxisAlignedBox2f &searchArea, Function function) const
     {
-        float topLeftX = _bounds.getMin()[kX];
-        float topLeftY = _bounds.getMin()[kY];
+        traverse(_root, searchArea, function);
+    }
 
-        float bottomRightX = _bounds.getMax()[kX];
-        float bottomRightY = _bounds.getMax()[kY];
+    template<typename Function>
+    void traverse(const Node &node, const AxisAlignedBox2f &searchArea, Function &function) const
+    {
+        Ego::Math::Intersects<AxisAlignedBox2f, AxisAlignedBox2f> intersects;
+        //Search grid is not part of our bounds
+        if(!intersects(node.bounds, searchArea)) {
+            return;
+        }
+
+        //Check all elements in this node
+        for(const uint32_t index : node.elements) {
+            const Element &element = _elements[index];
 
-        float midX = (topLeftX + bottomRightX) * 0.5f;
-        float midY = (topLeftY + bottomRightY) * 0.5f;
+            //Reported by another node?
+            if(!owns(node.bounds, getReferencePoint(element.bounds, searchArea))) {
+                continue;
+            }
 
-        //Allocate memory for the subdivision
-        _northWest = std::make_unique<QuadTree<T>>(topLeftX, topLeftY, midX, midY);
-        _northEast = std::make_unique<QuadTree<T>>(midX, topLeftY, bottomRightX, midY);
-        _southWest = std::make_unique<QuadTree<T>>(topLeftX, midY, midX, bottomRightY);
-        _southEast = std::make_unique<QuadTree<T>>(midX, midY, bottomRightX, bottomRightY);
+            //Check if element is within search area
+            if(!element.element.expired() && intersects(element.pointer->getAxisAlignedBox2D(), searchArea)) {
+                function(element);
+            }
+        }
+
+        //Check subtrees (if any)
+        if(node.northWest != nullptr) {
+            traverse(*node.northWest, searchArea, function);
+            traverse(*node.northEast, searchArea, function);
+            traverse(*node.southWest, searchArea, function);
+            traverse(*node.southEast, searchArea, function);
+        }
     }
 
-private:
-    static const size_t QUAD_TREE_NODE_CAPACITY = 4;    //< Maximum number of nodes in tree before subdivision
+    static AxisAlignedBox2f intersection(const AxisAlignedBox2f &a, const AxisAlignedBox2f &b)
+    {
+        return AxisAlignedBox2f(Point2f(std::max(a.getMin()[kX], b.getMin()[kX]), std::max(a.getMin()[kY], b.getMin()[kY])),
+                                Point2f(std::min(a.getMax()[kX], b.getMax()[kX]), std::min(a.getMax()[kY], b.getMax()[kY])));
+    }
+
+    static Point2f getReferencePoint(const AxisAlignedBox2f &bounds, const AxisAlignedBox2f &searchArea)
+    {
+        return Point2f(Ego::Math::constrain(searchArea.getMin()[kX], bounds.getMin()[kX], bounds.getMax()[kX]),
+                       Ego::Math::constrain(searchArea.getMin()[kY], bounds.getMin()[kY], bounds.getMax()[kY]));
+    }
 
-    AxisAlignedBox2f _bounds;                                     //< 2D AABB
+    bool owns(const AxisAlignedBox2f &bounds, const Point2f &point) const
+    {
+        const Point2f &treeMax = _root.bounds.getMax();
+        return point[kX] >= bounds.getMin()[kX] && (point[kX] < bounds.getMax()[kX] || bounds.getMax()[kX] == treeMax[kX])
+            && point[kY] >= bounds.getMin()[kY] && (point[kY] < bounds.getMax()[kY] || bounds.getMax()[kY] == treeMax[kY]);
+    }
 
-    std::vector<std::weak_ptr<T>> _nodes;               //< List of nodes contained in this QuadTree
+private:
+    static const size_t QUAD_TREE_NODE_CAPACITY = 4;    //< Maximum number of elements in a node before subdivision
 
-    std::unique_ptr<QuadTree<T>> _northWest;
-    std::unique_ptr<QuadTree<T>> _northEast;
-    std::unique_ptr<QuadTree<T>> _southWest;
-    std::unique_ptr<QuadTree<T>> _southEast;
+    Node _root;                                         //< Root node covering the bounds of the tree
+    std::vector<Element> _elements;                     //< All elements inserted since the last clear
 };
 
 } //namespace Ego
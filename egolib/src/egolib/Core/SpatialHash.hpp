@@ -0,0 +1,193 @@
+//********************************************************************************************
+//*
+//*    This file is part of Egoboo.
+//*
+//*    Egoboo is free software: you can redistribute it and/or modify it
+//*    under the terms of the GNU General Public License as published by
+//*    the Free Software Foundation, either version 3 of the License, or
+//*    (at your option) any later version.
+//*
+//*    Egoboo is distributed in the hope that it will be useful, but
+//*    WITHOUT ANY WARRANTY; without even the implied warranty of
+//*    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+//*    General Public License for more details.
+//*
+//*    You should have received a copy of the GNU General Public License
+//*    along with Egoboo.  If not, see <http://www.gnu.org/licenses/>.
+//*
+//********************************************************************************************
+
+/// @file   egolib/Core/SpatialHash.hpp
+/// @brief  Uniform grid of points which is rebuilt from scratch for fast area lookups
+
+#pragma once
+
+#include "egolib/Math/_Include.hpp"
+#include "egolib/Math/Standard.hpp"
+
+namespace Ego
+{
+
+/**
+* @brief
+*   A uniform grid which stores elements by a single point. The grid is meant to be rebuilt
+*   whenever the elements moved: clear() it, insert() every element and build() it. The
+*   elements of a cell are stored next to each other in a single array (a counting sort),
+*   so neither building nor visiting allocates memory once the grid has grown to its
+*   working size.
+* @remark
+*   The grid does not own its elements. Any number of threads may visit a built grid at
+*   the same time.
+**/
+template<typename T>
+class SpatialHash
+{
+public:
+    /**
+    * @brief
+    *   Construct an empty grid with the specified cell size
+    **/
+    SpatialHash(const float cellSize) :
+        _cellSize(cellSize),
+        _minX(0.0f),
+        _minY(0.0f),
+        _cellCountX(1),
+        _cellCountY(1),
+        _inserted(),
+        _cellStart(2, 0),
+        _elements()
+    {
+        //ctor
+    }
+
+    /**
+    * @brief
+    *   Removes all elements and sets the bounds of this grid. Points outside of the bounds
+    *   are stored in the border cells.
+    **/
+    void clear(const float minX, const float minY, const float maxX, const float maxY)
+    {
+        _minX = minX;
+        _minY = minY;
+        _cellCountX = std::max<size_t>(1, static_cast<size_t>(std::ceil((maxX - minX) / _cellSize)));
+        _cellCountY = std::max<size_t>(1, static_cast<size_t>(std::ceil((maxY - minY) / _cellSize)));
+
+        _inserted.clear();
+        _elements.clear();
+        _cellStart.assign(_cellCountX * _cellCountY + 1, 0);
+    }
+
+    /**
+    * @brief
+    *   Adds an element at a point. The element can not be found until build() is called.
+    **/
+    void insert(T *element, const float x, const float y)
+    {
+        _inserted.push_back(Entry{element, x, y, getCell(getCellX(x), getCellY(y))});
+    }
+
+    /**
+    * @brief
+    *   Sorts all inserted elements into their cells
+    **/
+    void build()
+    {
+        //Count the elements of each cell
+        std::fill(_cellStart.begin(), _cellStart.end(), 0);
+        for(const Entry &entry : _inserted) {
+            _cellStart[entry.cell + 1]++;
+        }
+
+        //The elements of a cell begin where the elements of the previous cell end
+        for(size_t i = 1; i < _cellStart.size(); ++i) {
+            _cellStart[i] += _cellStart[i - 1];
+        }
+
+        //Scatter the elements into their cells
+        _elements.resize(_inserted.size());
+        for(const Entry &entry : _inserted) {
+            _elements[_cellStart[entry.cell]++] = entry;
+        }
+
+        //Scattering advanced every start to the end of its cell, shift them back
+        for(size_t i = _cellStart.size() - 1; i > 0; --i) {
+            _cellStart[i] = _cellStart[i - 1];
+        }
+        _cellStart[0] = 0;
+        _inserted.clear();
+    }
+
+    /**
+    * @brief
+    *   Visit all elements whose point is within a search area
+    * @param searchArea
+    *   The bounding box which is used for finding elements
+    * @param visitor
+    *   A function object called with a reference to every element (<tt>T&</tt>) within the search area
+    **/
+    template<typename Visitor>
+    void visit(const AxisAlignedBox2f &searchArea, Visitor visitor) const
+    {
+        const float minX = searchArea.getMin()[kX], minY = searchArea.getMin()[kY];
+        const float maxX = searchArea.getMax()[kX], maxY = searchArea.getMax()[kY];
+
+        const size_t minCellX = getCellX(minX), maxCellX = getCellX(maxX);
+        const size_t minCellY = getCellY(minY), maxCellY = getCellY(maxY);
+        for(size_t y = minCellY; y <= maxCellY; ++y) {
+            //The cells of a row are stored next to each other
+            const uint32_t begin = _cellStart[getCell(minCellX, y)];
+            const uint32_t end = _cellStart[getCell(maxCellX, y) + 1];
+            for(uint32_t i = begin; i < end; ++i) {
+                const Entry &entry = _elements[i];
+                if(entry.x >= minX && entry.x <= maxX && entry.y >= minY && entry.y <= maxY) {
+                    visitor(*entry.element);
+                }
+            }
+        }
+    }
+
+    /**
+    * @return
+    *   the number of elements found by visit() since the last build()
+    **/
+    size_t size() const
+    {
+        return _elements.size();
+    }
+
+private:
+    struct Entry
+    {
+        T *element;                 //< The element
+        float x, y;                 //< The point of the element
+        uint32_t cell;              //< Index of the cell containing the point
+    };
+
+    size_t getCellX(const float x) const
+    {
+        const float cell = std::floor((x - _minX) / _cellSize);
+        return static_cast<size_t>(Ego::Math::constrain(cell, 0.0f, static_cast<float>(_cellCountX - 1)));
+    }
+
+    size_t getCellY(const float y) const
+    {
+        const float cell = std::floor((y - _minY) / _cellSize);
+        return static_cast<size_t>(Ego::Math::constrain(cell, 0.0f, static_cast<float>(_cellCountY - 1)));
+    }
+
+    uint32_t getCell(const size_t x, const size_t y) const
+    {
+        return static_cast<uint32_t>(y * _cellCountX + x);
+    }
+
+private:
+    float _cellSize;                    //< Width and height of a cell
+    float _minX, _minY;                 //< Lower bounds of the grid
+    size_t _cellCountX, _cellCountY;    //< Number of cells along each axis
+
+    std::vector<Entry> _inserted;       //< Elements inserted since the last build
+    std::vector<uint32_t> _cellStart;   //< Index of the first element of each cell, plus the total count
+    std::vector<Entry> _elements;       //< Elements sorted by cell
+};
+
+} //namespace Ego
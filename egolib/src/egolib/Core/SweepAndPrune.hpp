@@ -0,0 +1,437 @@
+//********************************************************************************************
+//*
+//*    This file is part of Egoboo.
+//*
+//*    Egoboo is free software: you can redistribute it and/or modify it
+//*    under the terms of the GNU General Public License as published by
+//*    the Free Software Foundation, either version 3 of the License, or
+//*    (at your option) any later version.
+//*
+//*    Egoboo is distributed in the hope that it will be useful, but
+//*    WITHOUT ANY WARRANTY; without even the implied warranty of
+//*    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+//*    General Public License for more details.
+//*
+//*    You should have received a copy of the GNU General Public License
+//*    along with Egoboo.  If not, see <http://www.gnu.org/licenses/>.
+//*
+//********************************************************************************************
+
+/// @file   egolib/Core/SweepAndPrune.hpp
+/// @brief  Sort-and-sweep broadphase for finding pairs of overlapping bounding boxes
+
+#pragma once
+
+#include "egolib/Math/_Include.hpp"
+#include "egolib/Math/Standard.hpp"
+
+namespace Ego
+{
+
+/**
+* @brief
+*   A sort-and-sweep broadphase. Every update frame the bounding boxes of all elements are
+*   submitted between begin() and end(). The lower and upper bounds of the boxes are kept in one
+*   sorted endpoint list per axis from one frame to the next, so re-sorting them is an insertion
+*   sort over almost sorted lists and only the endpoints of new elements are sorted from scratch.
+* @remark
+*   Once findPairs() has been called the broadphase keeps a persistent set of overlapping pairs.
+*   Whenever the insertion sort swaps a lower bound and an upper bound of two elements, their
+*   boxes start or stop overlapping along that axis and the pair is added to or removed from the
+*   set. Only pairs with a new element are found by sweeping the endpoints. A broadphase which is
+*   cleared every frame and only used with findPairs(const SweepAndPrune<U>&, Function) never
+*   keeps the set.
+* @remark
+*   Elements are identified by a caller-supplied key (e.g. an object reference) which should be
+*   small as it is used as an index. The broadphase does not own its elements, they must stay
+*   alive from begin() until the pairs have been found.
+**/
+template<typename T>
+class SweepAndPrune
+{
+public:
+    SweepAndPrune() :
+        _proxies(),
+        _endpoints(),
+        _overlaps(),
+        _updated(),
+        _activeFirst(),
+        _activeSecond(),
+        _pairs(),
+        _grouped(),
+        _counts(),
+        _frame(0),
+        _keepPairs(false)
+    {
+        //ctor
+    }
+
+    /**
+    * @brief
+    *   Removes all proxies and pairs. Use this before begin() for elements which have no
+    *   frame-to-frame coherence, their endpoints are then sorted from scratch.
+    **/
+    void clear()
+    {
+        _proxies.clear();
+        _overlaps.clear();
+        _updated.clear();
+        for(std::vector<Endpoint> &endpoints : _endpoints) {
+            endpoints.clear();
+        }
+    }
+
+    /**
+    * @brief
+    *   Start submitting the bounding boxes for this frame. Proxies of elements which are
+    *   not updated until end() are removed.
+    **/
+    void begin()
+    {
+        _frame++;
+        _updated.clear();
+    }
+
+    /**
+    * @brief
+    *   Submit the bounding box of an element for this frame. Pairs are reported in the
+    *   order in which their elements were updated.
+    * @param key
+    *   unique key of the element
+    **/
+    void update(const size_t key, T *element, const AxisAlignedBox2f &bounds)
+    {
+        if(key >= _proxies.size()) {
+            _proxies.resize(key + 1);
+            _overlaps.resize(key + 1);
+        }
+
+        Proxy &proxy = _proxies[key];
+        if(proxy.frame != _frame) {
+            proxy.order = static_cast<uint32_t>(_updated.size());
+            _updated.push_back(static_cast<uint32_t>(key));
+        }
+        proxy.element = element;
+        proxy.frame = _frame;
+        for(size_t axis = 0; axis < AXES; ++axis) {
+            proxy.min[axis] = bounds.getMin()[axis];
+            proxy.max[axis] = bounds.getMax()[axis];
+        }
+    }
+
+    /**
+    * @brief
+    *   Finish submitting the bounding boxes for this frame, sort the endpoints and update
+    *   the pairs
+    **/
+    void end()
+    {
+        //Remove the proxies which have not been updated together with their pairs
+        const uint32_t frame = _frame;
+        for(const Endpoint &endpoint : _endpoints[kX]) {
+            Proxy &proxy = _proxies[endpoint.key];
+            if(!endpoint.isMax && proxy.frame != frame) {
+                proxy.inserted = false;
+                removePairs(endpoint.key);
+            }
+        }
+
+        for(size_t axis = 0; axis < AXES; ++axis) {
+            std::vector<Endpoint> &endpoints = _endpoints[axis];
+            endpoints.erase(std::remove_if(endpoints.begin(), endpoints.end(), [this](const Endpoint &endpoint) { return !_proxies[endpoint.key].inserted; }), endpoints.end());
+
+            //The kept endpoints are almost sorted, an insertion sort is close to linear.
+            //Every swap of a lower and an upper bound starts or ends an overlap along this axis.
+            for(Endpoint &endpoint : endpoints) {
+                const Proxy &proxy = _proxies[endpoint.key];
+                endpoint.value = endpoint.isMax ? proxy.max[axis] : proxy.min[axis];
+            }
+            for(size_t i = 1; i < endpoints.size(); ++i) {
+                const Endpoint endpoint = endpoints[i];
+                size_t j = i;
+                for(; j > 0 && precedes(endpoint, endpoints[j - 1]); --j) {
+                    const Endpoint &other = endpoints[j - 1];
+                    if(_keepPairs && endpoint.key != other.key) {
+                        if(!endpoint.isMax && other.isMax) {
+                            if(overlaps(_proxies[endpoint.key], _proxies[other.key])) {
+                                addPair(endpoint.key, other.key);
+                            }
+                        }
+                        else if(endpoint.isMax && !other.isMax) {
+                            removePair(endpoint.key, other.key);
+                        }
+                    }
+                    endpoints[j] = other;
+                }
+                endpoints[j] = endpoint;
+            }
+
+            //The endpoints of new proxies are sorted from scratch and merged in
+            const size_t kept = endpoints.size();
+            for(const uint32_t key : _updated) {
+                const Proxy &proxy = _proxies[key];
+                if(!proxy.inserted) {
+                    endpoints.push_back(Endpoint(proxy.min[axis], key, false));
+                    endpoints.push_back(Endpoint(proxy.max[axis], key, true));
+                }
+            }
+            const auto created = endpoints.begin() + kept;
+            std::sort(created, endpoints.end(), precedes<Endpoint, Endpoint>);
+            std::inplace_merge(endpoints.begin(), created, endpoints.end(), precedes<Endpoint, Endpoint>);
+        }
+
+        bool anyCreated = false;
+        for(const uint32_t key : _updated) {
+            if(!_proxies[key].inserted) {
+                _proxies[key].inserted = true;
+                _proxies[key].created = frame;
+                anyCreated = true;
+            }
+        }
+        if(_keepPairs && anyCreated) {
+            findCreatedPairs(false);
+        }
+    }
+
+    /**
+    * @brief
+    *   Find all pairs of elements with overlapping bounding boxes. The first call starts
+    *   keeping the pairs, later calls only report them.
+    * @param function
+    *   function object called with references to both elements (<tt>T&, T&</tt>) of every pair.
+    *   The first element of a pair was updated before the second one and pairs are reported in
+    *   the order in which their first elements were updated, so all pairs of an element are
+    *   consecutive. The pairs of one element are reported in the order in which their overlaps
+    *   started.
+    **/
+    template<typename Function>
+    void findPairs(Function function)
+    {
+        if(!_keepPairs) {
+            _keepPairs = true;
+            findCreatedPairs(true);
+        }
+        for(const uint32_t key : _updated) {
+            const Proxy &proxy = _proxies[key];
+            for(const uint32_t other : _overlaps[key]) {
+                if(_proxies[other].order > proxy.order) {
+                    function(*proxy.element, *_proxies[other].element);
+                }
+            }
+        }
+    }
+
+    /**
+    * @brief
+    *   Find all pairs of an element of this broadphase and an element of another
+    *   broadphase with overlapping bounding boxes
+    * @param other
+    *   the other broadphase, which must have been sorted in this frame as well
+    * @param function
+    *   function object called with references to both elements (<tt>T&, U&</tt>) of every pair.
+    *   Pairs are reported in the order in which their elements in this broadphase were updated,
+    *   so all pairs of an element are consecutive.
+    * @remark
+    *   These pairs are not kept, both endpoint lists along the x-axis are swept every call
+    **/
+    template<typename U, typename Function>
+    void findPairs(const SweepAndPrune<U> &other, Function function)
+    {
+        typedef typename SweepAndPrune<U>::Proxy OtherProxy;
+        const std::vector<Endpoint> &first = _endpoints[kX];
+        const std::vector<typename SweepAndPrune<U>::Endpoint> &second = other._endpoints[kX];
+
+        //Every element is tested against the open elements of the other list when it opens
+        _pairs.clear();
+        _activeFirst.clear();
+        _activeSecond.clear();
+        size_t i = 0, j = 0;
+        while(i < first.size() && j < second.size()) {
+            if(!precedes(second[j], first[i])) {
+                const Endpoint &endpoint = first[i++];
+                if(endpoint.isMax) {
+                    deactivate(_activeFirst, endpoint.key);
+                    continue;
+                }
+                const Proxy &a = _proxies[endpoint.key];
+                for(const uint32_t key : _activeSecond) {
+                    const OtherProxy &b = other._proxies[key];
+                    if(a.min[kY] <= b.max[kY] && b.min[kY] <= a.max[kY]) {
+                        _pairs.push_back(Pair(endpoint.key, key));
+                    }
+                }
+                _activeFirst.push_back(endpoint.key);
+            }
+            else {
+                const typename SweepAndPrune<U>::Endpoint &endpoint = second[j++];
+                if(endpoint.isMax) {
+                    deactivate(_activeSecond, endpoint.key);
+                    continue;
+                }
+                const OtherProxy &b = other._proxies[endpoint.key];
+                for(const uint32_t key : _activeFirst) {
+                    const Proxy &a = _proxies[key];
+                    if(a.min[kY] <= b.max[kY] && b.min[kY] <= a.max[kY]) {
+                        _pairs.push_back(Pair(key, endpoint.key));
+                    }
+                }
+                _activeSecond.push_back(endpoint.key);
+            }
+        }
+
+        //Group the pairs by the update order of their first elements with a counting sort
+        _counts.assign(_updated.size() + 1, 0);
+        for(const Pair &pair : _pairs) {
+            _counts[_proxies[pair.first].order + 1]++;
+        }
+        for(size_t k = 1; k < _counts.size(); ++k) {
+            _counts[k] += _counts[k - 1];
+        }
+        _grouped.resize(_pairs.size());
+        for(const Pair &pair : _pairs) {
+            _grouped[_counts[_proxies[pair.first].order]++] = pair;
+        }
+        for(const Pair &pair : _grouped) {
+            function(*_proxies[pair.first].element, *other._proxies[pair.second].element);
+        }
+    }
+
+private:
+    static const size_t AXES = 2;
+
+    struct Proxy
+    {
+        Proxy() : element(nullptr), order(0), frame(0), created(0), inserted(false), min(), max() {}
+
+        T *element;             //< The element
+        uint32_t order;         //< Position of the element in the update order of this frame
+        uint32_t frame;         //< Last frame this proxy was updated in
+        uint32_t created;       //< Frame the endpoints of this proxy were inserted in
+        bool inserted;          //< If the endpoints of this proxy are in the endpoint lists
+        float min[AXES];        //< Bounding box of the element
+        float max[AXES];
+    };
+
+    struct Endpoint
+    {
+        Endpoint(float value, uint32_t key, bool isMax) : value(value), key(key), isMax(isMax) {}
+
+        float value;            //< Lower or upper bound of a proxy along the axis of the list
+        uint32_t key;           //< Key of the proxy
+        bool isMax;             //< If this is the upper bound
+    };
+
+    typedef std::pair<uint32_t, uint32_t> Pair;    //< Keys of the proxies of a pair
+
+    /**
+    * @brief
+    *   Order of the endpoints in a list. Lower bounds go before upper bounds with the same
+    *   value, so boxes which only touch overlap.
+    **/
+    template<typename A, typename B>
+    static bool precedes(const A &a, const B &b)
+    {
+        return a.value < b.value || (a.value == b.value && !a.isMax && b.isMax);
+    }
+
+    static bool overlaps(const Proxy &a, const Proxy &b)
+    {
+        for(size_t axis = 0; axis < AXES; ++axis) {
+            if(a.max[axis] < b.min[axis] || b.max[axis] < a.min[axis]) {
+                return false;
+            }
+        }
+        return true;
+    }
+
+    static void deactivate(std::vector<uint32_t> &active, const uint32_t key)
+    {
+        const auto it = std::find(active.begin(), active.end(), key);
+        *it = active.back();
+        active.pop_back();
+    }
+
+    void addPair(const uint32_t a, const uint32_t b)
+    {
+        std::vector<uint32_t> &partners = _overlaps[a];
+        if(std::find(partners.begin(), partners.end(), b) == partners.end()) {
+            partners.push_back(b);
+            _overlaps[b].push_back(a);
+        }
+    }
+
+    void removePair(const uint32_t a, const uint32_t b)
+    {
+        std::vector<uint32_t> &partners = _overlaps[a];
+        const auto it = std::find(partners.begin(), partners.end(), b);
+        if(it != partners.end()) {
+            partners.erase(it);
+            std::vector<uint32_t> &others = _overlaps[b];
+            others.erase(std::find(others.begin(), others.end(), a));
+        }
+    }
+
+    void removePairs(const uint32_t key)
+    {
+        for(const uint32_t other : _overlaps[key]) {
+            std::vector<uint32_t> &others = _overlaps[other];
+            others.erase(std::find(others.begin(), others.end(), key));
+        }
+        _overlaps[key].clear();
+    }
+
+    /**
+    * @brief
+    *   Sweep the endpoints along the x-axis and add the pairs with an element created in this
+    *   frame. A new element is tested against all open elements, an old one only against the
+    *   open new ones.
+    * @param all
+    *   treat all elements as new
+    **/
+    void findCreatedPairs(const bool all)
+    {
+        _activeFirst.clear();       //Open new elements
+        _activeSecond.clear();      //Open old elements
+        for(const Endpoint &endpoint : _endpoints[kX]) {
+            const bool isNew = all || _proxies[endpoint.key].created == _frame;
+            if(endpoint.isMax) {
+                deactivate(isNew ? _activeFirst : _activeSecond, endpoint.key);
+                continue;
+            }
+            const Proxy &proxy = _proxies[endpoint.key];
+            for(const uint32_t key : _activeFirst) {
+                if(overlaps(proxy, _proxies[key])) {
+                    addPair(endpoint.key, key);
+                }
+            }
+            if(isNew) {
+                for(const uint32_t key : _activeSecond) {
+                    if(overlaps(proxy, _proxies[key])) {
+                        addPair(endpoint.key, key);
+                    }
+                }
+            }
+            (isNew ? _activeFirst : _activeSecond).push_back(endpoint.key);
+        }
+    }
+
+    template<typename U> friend class SweepAndPrune;
+
+private:
+    std::vector<Proxy> _proxies;                    //< Proxy of each key
+    std::vector<Endpoint> _endpoints[AXES];         //< Bounds of the inserted proxies sorted along each axis
+    std::vector<std::vector<uint32_t>> _overlaps;   //< Keys of the elements overlapping each key, kept once findPairs() was called
+    std::vector<uint32_t> _updated;                 //< Keys updated in the current frame in update order
+    std::vector<uint32_t> _activeFirst;             //< Open elements during a sweep
+    std::vector<uint32_t> _activeSecond;
+    std::vector<Pair> _pairs;                       //< Pairs with another broadphase, kept to reuse their memory
+    std::vector<Pair> _grouped;
+    std::vector<size_t> _counts;
+    uint32_t _frame;                                //< Current frame
+    bool _keepPairs;                                //< If the pairs are kept up to date
+};
+
+template<typename T>
+const size_t SweepAndPrune<T>::AXES;
+
+} //namespace Ego
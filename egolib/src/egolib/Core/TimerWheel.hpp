@@ -0,0 +1,169 @@
+//********************************************************************************************
+//*
+//*    This file is part of Egoboo.
+//*
+//*    Egoboo is free software: you can redistribute it and/or modify it
+//*    under the terms of the GNU General Public License as published by
+//*    the Free Software Foundation, either version 3 of the License, or
+//*    (at your option) any later version.
+//*
+//*    Egoboo is distributed in the hope that it will be useful, but
+//*    WITHOUT ANY WARRANTY; without even the implied warranty of
+//*    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+//*    General Public License for more details.
+//*
+//*    You should have received a copy of the GNU General Public License
+//*    along with Egoboo.  If not, see <http://www.gnu.org/licenses/>.
+//*
+//********************************************************************************************
+
+/// @file   egolib/Core/TimerWheel.hpp
+/// @brief  Hierarchical timer wheel delivering timers on the update frame they expire.
+
+#pragma once
+
+#include "egolib/platform.h"
+
+namespace Ego {
+namespace Core {
+
+/// @brief Timers which expire at a given tick (e.g. update frame) and are delivered once time reaches that tick.
+/// Scheduling a timer and delivering it take constant time, and advancing time only looks at the slots of the
+/// ticks passed: timers do not have to be polled every tick.
+/// @remark The wheel has 6 levels of 64 slots. A timer is stored in the level of the highest 6 bits in which its
+/// deadline differs from the current time; when time reaches its slot, it moves down to a lower level until it
+/// is delivered from level 0 on its deadline. The 6 levels cover the full 32 bit range of the deadlines.
+/// @remark Timers can not be cancelled: the receiver of a timer checks whether it is still of interest.
+/// @code
+/// timers.schedule(update_wld + delay, value);
+/// ...
+/// timers.advance(update_wld, [](T& value) { ... });
+/// @endcode
+template <typename T>
+class TimerWheel : public Id::NonCopyable {
+public:
+    /// @brief Construct this timer wheel.
+    /// @param now the current time
+    TimerWheel(uint32_t now = 0) :
+        _now(now), _size(0), _slots(LEVELS * SLOTS), _scratch() {}
+
+    /// @brief Get the current time.
+    /// @return the current time
+    uint32_t getTime() const {
+        return _now;
+    }
+
+    /// @brief Get the number of timers which were not delivered yet.
+    /// @return the number of timers
+    size_t size() const {
+        return _size;
+    }
+
+    /// @brief Get if there are no timers which were not delivered yet.
+    /// @return @a true if there are no timers, @a false otherwise
+    bool empty() const {
+        return 0 == _size;
+    }
+
+    /// @brief Schedule a timer.
+    /// @param deadline the time at which the timer expires
+    /// @param value the value delivered when the timer expires
+    /// @remark A timer with a deadline not after the current time is delivered by the next tick.
+    /// @remark May be called from within the callback of advance().
+    void schedule(uint32_t deadline, const T& value) {
+        insert(Timer{std::max(deadline, _now + 1), value});
+        _size++;
+    }
+
+    /// @brief Advance the time and deliver the timers expired meanwhile.
+    /// @param now the new time
+    /// @param callback invoked with the value of each expired timer, in the order of their deadlines.
+    /// getTime() is the deadline of the timer during the invocation.
+    /// @remark The new time must not be before the current time.
+    template <typename Callback>
+    void advance(uint32_t now, Callback callback) {
+        while (_now < now) {
+            _now++;
+            // Move the timers of the slots reached down, the highest level first.
+            for (size_t level = LEVELS - 1; level > 0; --level) {
+                const uint32_t lowBits = (uint32_t(1) << (LEVEL_BITS * level)) - 1;
+                if (0 != (_now & lowBits)) {
+                    continue;
+                }
+                std::vector<Timer>& slot = getSlot(level, _now);
+                if (slot.empty()) {
+                    continue;
+                }
+                _scratch.swap(slot);
+                for (const Timer& timer : _scratch) {
+                    insert(timer);
+                }
+                _scratch.clear();
+            }
+            // Deliver the timers of this tick. They are moved out of the slot first, hence
+            // the callback can schedule timers (which are due in later ticks).
+            std::vector<Timer>& slot = getSlot(0, _now);
+            if (slot.empty()) {
+                continue;
+            }
+            _scratch.swap(slot);
+            _size -= _scratch.size();
+            for (Timer& timer : _scratch) {
+                callback(timer.value);
+            }
+            _scratch.clear();
+        }
+    }
+
+    /// @brief Remove all timers.
+    /// @param now the new current time
+    void clear(uint32_t now) {
+        for (std::vector<Timer>& slot : _slots) {
+            slot.clear();
+        }
+        _now = now;
+        _size = 0;
+    }
+
+private:
+    static const size_t LEVEL_BITS = 6;                                         ///< Number of bits of a deadline per level
+    static const size_t SLOTS = size_t(1) << LEVEL_BITS;                        ///< Number of slots per level
+    static const size_t LEVELS = (32 + LEVEL_BITS - 1) / LEVEL_BITS;            ///< Number of levels
+
+    struct Timer {
+        uint32_t deadline;
+        T value;
+    };
+
+    std::vector<Timer>& getSlot(size_t level, uint32_t time) {
+        return _slots[level * SLOTS + ((time >> (LEVEL_BITS * level)) & (SLOTS - 1))];
+    }
+
+    /// @pre timer.deadline >= _now
+    void insert(const Timer& timer) {
+        // Find the highest level in which the deadline differs from the current time.
+        uint32_t difference = timer.deadline ^ _now;
+        size_t level = 0;
+        while (difference >= SLOTS) {
+            difference >>= LEVEL_BITS;
+            level++;
+        }
+        getSlot(level, timer.deadline).push_back(timer);
+    }
+
+private:
+    uint32_t _now;                      ///< Current time
+    size_t _size;                       ///< Number of timers not delivered yet
+    std::vector<std::vector<Timer>> _slots;     ///< Slots of all levels, level by level
+    std::vector<Timer> _scratch;        ///< Timers moved out of a slot while it is processed
+};
+
+template <typename T>
+const size_t TimerWheel<T>::LEVEL_BITS;
+template <typename T>
+const size_t TimerWheel<T>::SLOTS;
+template <typename T>
+const size_t TimerWheel<T>::LEVELS;
+
+} // namespace Core
+} // namespace Ego
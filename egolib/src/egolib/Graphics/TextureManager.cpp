@@ -24,6 +24,7 @@
 #include "egolib/fileutil.h"
 #include "egolib/Graphics/TextureManager.hpp"
 #include "egolib/Image/ImageManager.hpp"
+#include "egolib/Renderer/Renderer.hpp"
 
 /**
  * @brief
@@ -89,6 +90,24 @@ End:
     return retval;
 }
 
+/**
+ * @brief
+ *  Get if the renderer back-end is OpenGL.
+ */
+static bool isOpenGLBackend() {
+    return Ego::RendererBackend::OpenGL == Ego::Core::CreateFunctor<Ego::Renderer>::backend;
+}
+
+/**
+ * @brief
+ *  Get if textures can be created and destroyed on the calling thread.
+ * @remark
+ *  The OpenGL back-end requires the thread owning the OpenGL context, the null back-end works on any thread.
+ */
+static bool canLoadTextures() {
+    return !isOpenGLBackend() || SDL_GL_GetCurrentContext() != nullptr;
+}
+
 
 //--------------------------------------------------------------------------------------------
 
@@ -97,17 +116,21 @@ TextureManager::TextureManager() :
     _deferredLoadingMutex(),
     _requestedLoadDeferredTextures(),
     _notifyDeferredLoadingComplete() {
-    Ego::OpenGL::initializeErrorTextures();
+    if (isOpenGLBackend()) {
+        Ego::OpenGL::initializeErrorTextures();
+    }
 }
 
 TextureManager::~TextureManager() {
     _textureCache.clear();
     _unload.clear();
-    Ego::OpenGL::uninitializeErrorTextures();
+    if (isOpenGLBackend()) {
+        Ego::OpenGL::uninitializeErrorTextures();
+    }
 }
 
 void TextureManager::release_all() {
-    if (SDL_GL_GetCurrentContext() != nullptr) {
+    if (canLoadTextures()) {
         // We are the main OpenGL context thread so we can destroy textures.
         _textureCache.clear();
         _unload.clear();
@@ -132,7 +155,7 @@ void TextureManager::updateDeferredLoading() {
     {
         std::lock_guard<std::mutex> lock(_deferredLoadingMutex);
         for (const std::string &filePath : _requestedLoadDeferredTextures) {
-            std::shared_ptr<Ego::Texture> loadTexture = std::make_shared<Ego::OpenGL::Texture>();
+            std::shared_ptr<Ego::Texture> loadTexture = Ego::Renderer::get().createTexture();
             ego_texture_load_vfs(loadTexture, filePath.c_str());
             _textureCache[filePath] = loadTexture;
         }
@@ -148,9 +171,9 @@ const std::shared_ptr<Texture>& TextureManager::getTexture(const std::string &fi
     const auto &result = _textureCache.find(filePath);
     if (result == _textureCache.end()) {
 
-        if (SDL_GL_GetCurrentContext() != nullptr) {
+        if (canLoadTextures()) {
             //We are the main OpenGL context thread so we can load textures
-            std::shared_ptr<Texture> loadTexture = std::make_shared<OpenGL::Texture>();
+            std::shared_ptr<Texture> loadTexture = Renderer::get().createTexture();
             ego_texture_load_vfs(loadTexture, filePath.c_str());
             _textureCache[filePath] = loadTexture;
         } else {
@@ -0,0 +1,150 @@
+//********************************************************************************************
+//*
+//*    This file is part of Egoboo.
+//*
+//*    Egoboo is free software: you can redistribute it and/or modify it
+//*    under the terms of the GNU General Public License as published by
+//*    the Free Software Foundation, either version 3 of the License, or
+//*    (at your option) any later version.
+//*
+//*    Egoboo is distributed in the hope that it will be useful, but
+//*    WITHOUT ANY WARRANTY; without even the implied warranty of
+//*    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+//*    General Public License for more details.
+//*
+//*    You should have received a copy of the GNU General Public License
+//*    along with Egoboo.  If not, see <http://www.gnu.org/licenses/>.
+//*
+//********************************************************************************************
+/// @file   egolib/Logic/AttributeSet.cpp
+/// @brief  Resolution of the total attribute values of an Object from base values, enchantments and Perks.
+
+#include "egolib/Logic/AttributeSet.hpp"
+#include "egolib/Debug.hpp"
+
+namespace Ego {
+
+constexpr uint8_t AttributeSet::JUMPINFINITE;
+
+AttributeSet::AttributeSet() :
+    _base(),
+    _temp(),
+    _perks(),
+    _total() {
+    _base.fill(0.0f);
+    update();
+}
+
+float AttributeSet::get(const Attribute::AttributeType type) const {
+    EGOBOO_ASSERT(type < _total.size() && type != Attribute::NR_OF_PRIMARY_ATTRIBUTES);
+
+    //Make sure no change of the inputs was missed
+    EGOBOO_ASSERT(_total[type] == compute(type));
+    return _total[type];
+}
+
+float AttributeSet::compute(const Attribute::AttributeType type) const {
+    float attributeValue = _base[type];
+
+    //Try to find temp value in map, but don't create it if it doesn't already exist
+    const auto& result = _temp.find(type);
+    if(result != _temp.end()) {
+
+        //Is this a SET type attribute or a cumulative ADD type attribute?
+        if(Attribute::isOverrideSetAttribute(type)) {
+            return (*result).second;
+        }
+        else {
+            //Total value is base plus temp bonuses from enchants
+            attributeValue += (*result).second;
+        }
+    }
+
+    switch(type) {
+
+        case Attribute::JUMP_POWER:
+            //Special value for flying Objects
+            if(compute(Attribute::FLY_TO_HEIGHT) > 0.0f) {
+                return JUMPINFINITE;
+            }
+
+            //Athletics Perks gives +25% jump power
+            if(hasPerk(Perks::ATHLETICS)) {
+                attributeValue *= 1.25f;
+            }
+
+            //Every point of Might increases jump power by 1%
+            attributeValue *= 1.0f + (compute(Attribute::MIGHT) / 100.0f);
+        break;
+
+        //Limit lowest acceleration to zero
+        case Attribute::ACCELERATION:
+        {
+            if(attributeValue < 0.0f) return 0.0f;
+        }
+        break;
+
+        //Limit lowest base attribute to 1
+        case Attribute::MIGHT:
+        case Attribute::AGILITY:
+        case Attribute::INTELLECT:
+        {
+            if(attributeValue < 1.0f) return 1.0f;
+        }
+        break;
+
+        default:
+            //nothing, keep default case to quench GCC warnings
+        break;
+    }
+
+    return attributeValue;
+}
+
+float AttributeSet::getBase(const Attribute::AttributeType type) const {
+    EGOBOO_ASSERT(type < _base.size() && type != Attribute::NR_OF_PRIMARY_ATTRIBUTES);
+    return _base[type];
+}
+
+void AttributeSet::setBase(const Attribute::AttributeType type, float value) {
+    EGOBOO_ASSERT(type < _base.size() && type != Attribute::NR_OF_PRIMARY_ATTRIBUTES);
+    _base[type] = value;
+    update();
+}
+
+bool AttributeSet::hasTemp(const Attribute::AttributeType type) const {
+    return _temp.find(type) != _temp.end();
+}
+
+void AttributeSet::setTemp(const Attribute::AttributeType type, float value) {
+    _temp[type] = value;
+    update();
+}
+
+void AttributeSet::increaseTemp(const Attribute::AttributeType type, float value) {
+    _temp[type] += value;
+    update();
+}
+
+void AttributeSet::removeTemp(const Attribute::AttributeType type) {
+    _temp.erase(type);
+    update();
+}
+
+bool AttributeSet::hasPerk(const Perks::PerkID perk) const {
+    return perk == Perks::NR_OF_PERKS || _perks[perk];
+}
+
+void AttributeSet::setPerks(const std::bitset<Perks::NR_OF_PERKS>& perks) {
+    _perks = perks;
+    update();
+}
+
+void AttributeSet::update() {
+    for(size_t i = 0; i < _total.size(); ++i) {
+        const Attribute::AttributeType type = static_cast<Attribute::AttributeType>(i);
+        _total[i] = (type == Attribute::NR_OF_PRIMARY_ATTRIBUTES) ? 0.0f : compute(type);
+    }
+}
+
+} // namespace Ego
@@ -0,0 +1,81 @@
+//********************************************************************************************
+//*
+//*    This file is part of Egoboo.
+//*
+//*    Egoboo is free software: you can redistribute it and/or modify it
+//*    under the terms of the GNU General Public License as published by
+//*    the Free Software Foundation, either version 3 of the License, or
+//*    (at your option) any later version.
+//*
+//*    Egoboo is distributed in the hope that it will be useful, but
+//*    WITHOUT ANY WARRANTY; without even the implied warranty of
+//*    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+//*    General Public License for more details.
+//*
+//*    You should have received a copy of the GNU General Public License
+//*    along with Egoboo.  If not, see <http://www.gnu.org/licenses/>.
+//*
+//********************************************************************************************
+/// @file   egolib/Logic/AttributeSet.hpp
+/// @brief  Resolution of the total attribute values of an Object from base values, enchantments and Perks.
+
+#pragma once
+
+#include "egolib/Logic/Attribute.hpp"
+#include "egolib/Logic/Perk.hpp"
+
+namespace Ego {
+
+/// @brief The attributes of an Object. The total value of an attribute is resolved from its base value,
+/// the temporary value written by enchantments and the Perks of the Object. Total values are cached
+/// and resolved again whenever one of these inputs changes.
+/// @remark The Life Regeneration bonus of the Wolverine Perk depends on the items held in hand and is
+/// not part of the set: the Object adds it when reading the attribute.
+class AttributeSet {
+public:
+    /// @brief The jump power of flying Objects.
+    static constexpr uint8_t JUMPINFINITE = 255;
+
+    AttributeSet();
+
+    /// @brief Get the cached total value of an attribute.
+    float get(const Attribute::AttributeType type) const;
+
+    /// @brief Compute the total value of an attribute from the inputs, ignoring the cache.
+    float compute(const Attribute::AttributeType type) const;
+
+    /// @brief Get the base value of an attribute.
+    float getBase(const Attribute::AttributeType type) const;
+
+    /// @brief Set the base value of an attribute.
+    void setBase(const Attribute::AttributeType type, float value);
+
+    /// @brief Get if an enchantment wrote a temporary value of an attribute.
+    bool hasTemp(const Attribute::AttributeType type) const;
+
+    /// @brief Set the temporary value of an attribute.
+    void setTemp(const Attribute::AttributeType type, float value);
+
+    /// @brief Add to the temporary value of an attribute.
+    void increaseTemp(const Attribute::AttributeType type, float value);
+
+    /// @brief Remove the temporary value of an attribute.
+    void removeTemp(const Attribute::AttributeType type);
+
+    /// @brief Get if a Perk modifies the attributes.
+    bool hasPerk(const Perks::PerkID perk) const;
+
+    /// @brief Set the Perks which modify the attributes.
+    void setPerks(const std::bitset<Perks::NR_OF_PERKS>& perks);
+
+private:
+    /// @brief Resolve all total values again.
+    void update();
+
+    std::array<float, Attribute::NR_OF_ATTRIBUTES> _base;                           ///< Base values
+    std::unordered_map<Attribute::AttributeType, float, std::hash<uint8_t>> _temp;  ///< Temporary values of enchantments
+    std::bitset<Perks::NR_OF_PERKS> _perks;                                         ///< Perks which modify the attributes
+    std::array<float, Attribute::NR_OF_ATTRIBUTES> _total;                          ///< Cached total values
+};
+
+} // namespace Ego
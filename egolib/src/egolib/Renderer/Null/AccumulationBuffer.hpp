@@ -0,0 +1,72 @@
+//********************************************************************************************
+//*
+//*    This file is part of Egoboo.
+//*
+//*    Egoboo is free software: you can redistribute it and/or modify it
+//*    under the terms of the GNU General Public License as published by
+//*    the Free Software Foundation, either version 3 of the License, or
+//*    (at your option) any later version.
+//*
+//*    Egoboo is distributed in the hope that it will be useful, but
+//*    WITHOUT ANY WARRANTY; without even the implied warranty of
+//*    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+//*    General Public License for more details.
+//*
+//*    You should have received a copy of the GNU General Public License
+//*    along with Egoboo.  If not, see <http://www.gnu.org/licenses/>.
+//*
+//********************************************************************************************
+
+/// @file   egolib/Renderer/Null/AccumulationBuffer.hpp
+/// @brief  Implementation of an accumulation buffer facade for the null renderer.
+
+#pragma once
+
+#include "egolib/Renderer/Renderer.hpp"
+#include "egolib/Renderer/Null/Statistics.hpp"
+
+namespace Ego {
+namespace Null {
+
+using namespace Math;
+
+class AccumulationBuffer : public Ego::AccumulationBuffer {
+private:
+    /// @brief The colour depth of this accumulation buffer.
+    ColourDepth colourDepth;
+    /// @brief The clear value.
+    Colour4f clearValue;
+    /// @brief The statistics of the renderer this facade belongs to.
+    Statistics& statistics;
+
+public:
+
+    /**
+     * @brief
+     *  Construct this accumulation buffer facade.
+     * @param statistics
+     *  the statistics of the renderer this facade belongs to
+     */
+    AccumulationBuffer(Statistics& statistics);
+
+    /**
+     * @brief
+     *  Destruct this accumulation buffer facade.
+     */
+    virtual ~AccumulationBuffer();
+
+public:
+
+    /** @copydoc Ego::Buffer<Colour4f>::clear */
+    virtual void clear() override;
+
+    /** @copydoc Ego::Buffer<Colour4f>::setClearValue */
+    virtual void setClearValue(const Colour4f& value) override;
+
+    /** @copydoc Ego::AccumulationBuffer::getColourDepth */
+    virtual const ColourDepth& getColourDepth() override;
+
+}; // class AccumulationBuffer
+
+} // namespace Null
+} // namespace Ego
@@ -0,0 +1,49 @@
+//********************************************************************************************
+//*
+//*    This file is part of Egoboo.
+//*
+//*    Egoboo is free software: you can redistribute it and/or modify it
+//*    under the terms of the GNU General Public License as published by
+//*    the Free Software Foundation, either version 3 of the License, or
+//*    (at your option) any later version.
+//*
+//*    Egoboo is distributed in the hope that it will be useful, but
+//*    WITHOUT ANY WARRANTY; without even the implied warranty of
+//*    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+//*    General Public License for more details.
+//*
+//*    You should have received a copy of the GNU General Public License
+//*    along with Egoboo.  If not, see <http://www.gnu.org/licenses/>.
+//*
+//********************************************************************************************
+
+/// @file   egolib/Renderer/Null/ColourBuffer.cpp
+/// @brief  Implementation of a colour buffer facade for the null renderer.
+
+#include "egolib/Renderer/Null/ColourBuffer.hpp"
+
+namespace Ego {
+namespace Null {
+
+ColourBuffer::ColourBuffer(Statistics& statistics) :
+    Ego::ColourBuffer(), colourDepth(32, 8, 8, 8, 8), clearValue(Colour4f::black()), statistics(statistics)
+{}
+
+ColourBuffer::~ColourBuffer()
+{}
+
+void ColourBuffer::clear() {
+    statistics.clears++;
+}
+
+void ColourBuffer::setClearValue(const Colour4f& value) {
+    clearValue = value;
+    statistics.stateChanges++;
+}
+
+const ColourDepth& ColourBuffer::getColourDepth() {
+    return colourDepth;
+}
+
+} // namespace Null
+} // namespace Ego
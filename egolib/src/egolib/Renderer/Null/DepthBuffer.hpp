@@ -0,0 +1,72 @@
+//********************************************************************************************
+//*
+//*    This file is part of Egoboo.
+//*
+//*    Egoboo is free software: you can redistribute it and/or modify it
+//*    under the terms of the GNU General Public License as published by
+//*    the Free Software Foundation, either version 3 of the License, or
+//*    (at your option) any later version.
+//*
+//*    Egoboo is distributed in the hope that it will be useful, but
+//*    WITHOUT ANY WARRANTY; without even the implied warranty of
+//*    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+//*    General Public License for more details.
+//*
+//*    You should have received a copy of the GNU General Public License
+//*    along with Egoboo.  If not, see <http://www.gnu.org/licenses/>.
+//*
+//********************************************************************************************
+
+/// @file   egolib/Renderer/Null/DepthBuffer.hpp
+/// @brief  Implementation of a depth buffer facade for the null renderer.
+
+#pragma once
+
+#include "egolib/Renderer/Renderer.hpp"
+#include "egolib/Renderer/Null/Statistics.hpp"
+
+namespace Ego {
+namespace Null {
+
+using namespace Math;
+
+class DepthBuffer : public Ego::DepthBuffer {
+private:
+    /// @brief The depth of this depth buffer.
+    uint8_t depth;
+    /// @brief The clear value.
+    float clearValue;
+    /// @brief The statistics of the renderer this facade belongs to.
+    Statistics& statistics;
+
+public:
+
+    /**
+     * @brief
+     *  Construct this depth buffer facade.
+     * @param statistics
+     *  the statistics of the renderer this facade belongs to
+     */
+    DepthBuffer(Statistics& statistics);
+
+    /**
+     * @brief
+     *  Destruct this depth buffer facade.
+     */
+    virtual ~DepthBuffer();
+
+public:
+
+    /** @copydoc Ego::Buffer<float>::clear */
+    virtual void clear() override;
+
+    /** @copydoc Ego::Buffer<float>::setClearValue */
+    virtual void setClearValue(const float& value) override;
+
+    /** @copydoc Ego::DepthBuffer::getDepth */
+    virtual uint8_t getDepth() override;
+
+}; // class DepthBuffer
+
+} // namespace Null
+} // namespace Ego
@@ -0,0 +1,277 @@
+//********************************************************************************************
+//*
+//*    This file is part of Egoboo.
+//*
+//*    Egoboo is free software: you can redistribute it and/or modify it
+//*    under the terms of the GNU General Public License as published by
+//*    the Free Software Foundation, either version 3 of the License, or
+//*    (at your option) any later version.
+//*
+//*    Egoboo is distributed in the hope that it will be useful, but
+//*    WITHOUT ANY WARRANTY; without even the implied warranty of
+//*    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+//*    General Public License for more details.
+//*
+//*    You should have received a copy of the GNU General Public License
+//*    along with Egoboo.  If not, see <http://www.gnu.org/licenses/>.
+//*
+//********************************************************************************************
+
+/// @file   egolib/Renderer/Null/Renderer.cpp
+/// @brief  Implementation of a null renderer.
+
+#include "egolib/Renderer/Null/Renderer.hpp"
+
+namespace Ego {
+namespace Null {
+
+Renderer::State::State() :
+    alphaTestEnabled(false), alphaFunction(CompareFunction::AlwaysPass), alphaReference(0.0f),
+    blendingEnabled(false),
+    sourceColour(BlendFunction::One), sourceAlpha(BlendFunction::One),
+    destinationColour(BlendFunction::Zero), destinationAlpha(BlendFunction::Zero),
+    cullingMode(CullingMode::None), depthFunction(CompareFunction::Less),
+    depthTestEnabled(false), depthWriteEnabled(true),
+    scissorRectangle{{0.0f, 0.0f, 0.0f, 0.0f}}, scissorTestEnabled(false),
+    stencilMaskBack(0xffffffff), stencilMaskFront(0xffffffff), stencilTestEnabled(false),
+    viewportRectangle{{0.0f, 0.0f, 0.0f, 0.0f}},
+    windingMode(WindingMode::AntiClockwise),
+    perspectiveCorrectionEnabled(false), ditheringEnabled(true),
+    pointSmoothEnabled(false), lineSmoothEnabled(false),
+    lineWidth(1.0f), pointSize(1.0f),
+    polygonSmoothEnabled(false), multisamplesEnabled(true), lightingEnabled(false),
+    rasterizationMode(RasterizationMode::Solid), gouraudShadingEnabled(true)
+{}
+
+Renderer::Renderer() :
+    Ego::Renderer(),
+    _frameStatistics(), _lastFrameStatistics(), _totalStatistics(), _frames(0),
+    _accumulationBuffer(_frameStatistics), _colourBuffer(_frameStatistics),
+    _depthBuffer(_frameStatistics), _stencilBuffer(_frameStatistics),
+    _textureUnit(_frameStatistics),
+    _info("null", "Egoboo", "1.0"),
+    _state()
+{}
+
+Renderer::~Renderer()
+{}
+
+void Renderer::nextFrame() {
+    _totalStatistics += _frameStatistics;
+    _lastFrameStatistics = _frameStatistics;
+    _frameStatistics.reset();
+    _frames++;
+}
+
+const Statistics& Renderer::getFrameStatistics() const {
+    return _frameStatistics;
+}
+
+const Statistics& Renderer::getLastFrameStatistics() const {
+    return _lastFrameStatistics;
+}
+
+const Statistics& Renderer::getTotalStatistics() const {
+    return _totalStatistics;
+}
+
+size_t Renderer::getNumberOfFrames() const {
+    return _frames;
+}
+
+const Ego::RendererInfo& Renderer::getInfo() {
+    return _info;
+}
+
+Ego::AccumulationBuffer& Renderer::getAccumulationBuffer() {
+    return _accumulationBuffer;
+}
+
+Ego::ColourBuffer& Renderer::getColourBuffer() {
+    return _colourBuffer;
+}
+
+Ego::DepthBuffer& Renderer::getDepthBuffer() {
+    return _depthBuffer;
+}
+
+Ego::StencilBuffer& Renderer::getStencilBuffer() {
+    return _stencilBuffer;
+}
+
+Ego::TextureUnit& Renderer::getTextureUnit() {
+    return _textureUnit;
+}
+
+void Renderer::setAlphaTestEnabled(bool enabled) {
+    change(_state.alphaTestEnabled, enabled);
+}
+
+void Renderer::setAlphaFunction(CompareFunction function, float value) {
+    if (value < 0.0f || value > 1.0f) {
+        throw std::invalid_argument("reference alpha value out of bounds");
+    }
+    if (function == _state.alphaFunction && value == _state.alphaReference) {
+        _frameStatistics.redundantStateChanges++;
+    }
+    _frameStatistics.stateChanges++;
+    _state.alphaFunction = function;
+    _state.alphaReference = value;
+}
+
+void Renderer::setBlendingEnabled(bool enabled) {
+    change(_state.blendingEnabled, enabled);
+}
+
+void Renderer::setBlendFunction(BlendFunction sourceColour, BlendFunction sourceAlpha,
+                                BlendFunction destinationColour, BlendFunction destinationAlpha) {
+    if (sourceColour == _state.sourceColour && sourceAlpha == _state.sourceAlpha &&
+        destinationColour == _state.destinationColour && destinationAlpha == _state.destinationAlpha) {
+        _frameStatistics.redundantStateChanges++;
+    }
+    _frameStatistics.stateChanges++;
+    _state.sourceColour = sourceColour;
+    _state.sourceAlpha = sourceAlpha;
+    _state.destinationColour = destinationColour;
+    _state.destinationAlpha = destinationAlpha;
+}
+
+void Renderer::setColour(const Colour4f& colour) {
+    // The current colour is changed per primitive batch and is not tracked for redundancy.
+    _frameStatistics.stateChanges++;
+}
+
+void Renderer::setCullingMode(CullingMode mode) {
+    change(_state.cullingMode, mode);
+}
+
+void Renderer::setDepthFunction(CompareFunction function) {
+    change(_state.depthFunction, function);
+}
+
+void Renderer::setDepthTestEnabled(bool enabled) {
+    change(_state.depthTestEnabled, enabled);
+}
+
+void Renderer::setDepthWriteEnabled(bool enabled) {
+    change(_state.depthWriteEnabled, enabled);
+}
+
+void Renderer::setScissorTestEnabled(bool enabled) {
+    change(_state.scissorTestEnabled, enabled);
+}
+
+void Renderer::setScissorRectangle(float left, float bottom, float width, float height) {
+    if (width < 0) {
+        throw Id::InvalidArgumentException(__FILE__, __LINE__, "width < 0");
+    }
+    if (height < 0) {
+        throw Id::InvalidArgumentException(__FILE__, __LINE__, "height < 0");
+    }
+    change(_state.scissorRectangle, std::array<float, 4>{{left, bottom, width, height}});
+}
+
+void Renderer::setStencilMaskBack(uint32_t mask) {
+    change(_state.stencilMaskBack, mask);
+}
+
+void Renderer::setStencilMaskFront(uint32_t mask) {
+    change(_state.stencilMaskFront, mask);
+}
+
+void Renderer::setStencilTestEnabled(bool enabled) {
+    change(_state.stencilTestEnabled, enabled);
+}
+
+void Renderer::setViewportRectangle(float left, float bottom, float width, float height) {
+    if (width < 0) {
+        throw std::invalid_argument("width < 0");
+    }
+    if (height < 0) {
+        throw std::invalid_argument("height < 0");
+    }
+    change(_state.viewportRectangle, std::array<float, 4>{{left, bottom, width, height}});
+}
+
+void Renderer::setWindingMode(WindingMode mode) {
+    change(_state.windingMode, mode);
+}
+
+void Renderer::multiplyMatrix(const Matrix4f4f& matrix) {
+    _frameStatistics.stateChanges++;
+}
+
+void Renderer::setPerspectiveCorrectionEnabled(bool enabled) {
+    change(_state.perspectiveCorrectionEnabled, enabled);
+}
+
+void Renderer::setDitheringEnabled(bool enabled) {
+    change(_state.ditheringEnabled, enabled);
+}
+
+void Renderer::setPointSmoothEnabled(bool enabled) {
+    change(_state.pointSmoothEnabled, enabled);
+}
+
+void Renderer::setLineSmoothEnabled(bool enabled) {
+    change(_state.lineSmoothEnabled, enabled);
+}
+
+void Renderer::setLineWidth(float width) {
+    change(_state.lineWidth, width);
+}
+
+void Renderer::setPointSize(float size) {
+    change(_state.pointSize, size);
+}
+
+void Renderer::setPolygonSmoothEnabled(bool enabled) {
+    change(_state.polygonSmoothEnabled, enabled);
+}
+
+void Renderer::setMultisamplesEnabled(bool enabled) {
+    change(_state.multisamplesEnabled, enabled);
+}
+
+void Renderer::setLightingEnabled(bool enabled) {
+    change(_state.lightingEnabled, enabled);
+}
+
+void Renderer::setRasterizationMode(RasterizationMode mode) {
+    change(_state.rasterizationMode, mode);
+}
+
+void Renderer::setGouraudShadingEnabled(bool enabled) {
+    change(_state.gouraudShadingEnabled, enabled);
+}
+
+void Renderer::render(VertexBuffer& vertexBuffer, PrimitiveType primitiveType, size_t index, size_t length) {
+    if (index + length > vertexBuffer.getNumberOfVertices()) {
+        throw std::invalid_argument("out of bounds");
+    }
+    _frameStatistics.drawCalls++;
+    _frameStatistics.vertices += length;
+}
+
+std::shared_ptr<Ego::Texture> Renderer::createTexture() {
+    _frameStatistics.texturesCreated++;
+    return std::make_shared<Texture>();
+}
+
+void Renderer::setProjectionMatrix(const Matrix4f4f& projectionMatrix) {
+    this->Ego::Renderer::setProjectionMatrix(projectionMatrix);
+    _frameStatistics.stateChanges++;
+}
+
+void Renderer::setViewMatrix(const Matrix4f4f& viewMatrix) {
+    this->Ego::Renderer::setViewMatrix(viewMatrix);
+    _frameStatistics.stateChanges++;
+}
+
+void Renderer::setWorldMatrix(const Matrix4f4f& worldMatrix) {
+    this->Ego::Renderer::setWorldMatrix(worldMatrix);
+    _frameStatistics.stateChanges++;
+}
+
+} // namespace Null
+} // namespace Ego
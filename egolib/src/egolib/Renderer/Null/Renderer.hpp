@@ -0,0 +1,286 @@
+//********************************************************************************************
+//*
+//*    This file is part of Egoboo.
+//*
+//*    Egoboo is free software: you can redistribute it and/or modify it
+//*    under the terms of the GNU General Public License as published by
+//*    the Free Software Foundation, either version 3 of the License, or
+//*    (at your option) any later version.
+//*
+//*    Egoboo is distributed in the hope that it will be useful, but
+//*    WITHOUT ANY WARRANTY; without even the implied warranty of
+//*    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+//*    General Public License for more details.
+//*
+//*    You should have received a copy of the GNU General Public License
+//*    along with Egoboo.  If not, see <http://www.gnu.org/licenses/>.
+//*
+//********************************************************************************************
+
+/// @file   egolib/Renderer/Null/Renderer.hpp
+/// @brief  Implementation of a null renderer.
+
+#pragma once
+
+#include "egolib/Renderer/Renderer.hpp"
+#include "egolib/Renderer/Null/Statistics.hpp"
+#include "egolib/Renderer/Null/AccumulationBuffer.hpp"
+#include "egolib/Renderer/Null/ColourBuffer.hpp"
+#include "egolib/Renderer/Null/DepthBuffer.hpp"
+#include "egolib/Renderer/Null/StencilBuffer.hpp"
+#include "egolib/Renderer/Null/TextureUnit.hpp"
+#include "egolib/Renderer/Null/Texture.hpp"
+
+/**
+ * @brief
+ *  The Egoboo null back-end.
+ *  It does not require a graphics device: All state is kept in memory and nothing is drawn.
+ *  It is used to run and profile the CPU side of the rendering on machines without a GPU.
+ */
+namespace Ego {
+namespace Null {
+
+using namespace Math;
+
+class Renderer : public Ego::Renderer
+{
+protected:
+    /// @brief The statistics of the current frame.
+    Statistics _frameStatistics;
+    /// @brief The statistics of the last completed frame.
+    Statistics _lastFrameStatistics;
+    /// @brief The statistics of all completed frames.
+    Statistics _totalStatistics;
+    /// @brief The number of completed frames.
+    size_t _frames;
+
+    /// @brief The accumulation buffer facade.
+    AccumulationBuffer _accumulationBuffer;
+    /// @brief The colour buffer facade.
+    ColourBuffer _colourBuffer;
+    /// @brief The depth buffer facade.
+    DepthBuffer _depthBuffer;
+    /// @brief The stencil buffer facade.
+    StencilBuffer _stencilBuffer;
+    /// @brief The texture unit facade
+    TextureUnit _textureUnit;
+    /// @brief Information about the backend.
+    RendererInfo _info;
+
+    /// @brief The renderer state.
+    struct State {
+        bool alphaTestEnabled;
+        CompareFunction alphaFunction;
+        float alphaReference;
+        bool blendingEnabled;
+        BlendFunction sourceColour, sourceAlpha, destinationColour, destinationAlpha;
+        CullingMode cullingMode;
+        CompareFunction depthFunction;
+        bool depthTestEnabled;
+        bool depthWriteEnabled;
+        std::array<float, 4> scissorRectangle;
+        bool scissorTestEnabled;
+        uint32_t stencilMaskBack;
+        uint32_t stencilMaskFront;
+        bool stencilTestEnabled;
+        std::array<float, 4> viewportRectangle;
+        WindingMode windingMode;
+        bool perspectiveCorrectionEnabled;
+        bool ditheringEnabled;
+        bool pointSmoothEnabled;
+        bool lineSmoothEnabled;
+        float lineWidth;
+        float pointSize;
+        bool polygonSmoothEnabled;
+        bool multisamplesEnabled;
+        bool lightingEnabled;
+        RasterizationMode rasterizationMode;
+        bool gouraudShadingEnabled;
+        State();
+    } _state;
+
+public:
+    /// @brief Construct this null renderer.
+    Renderer();
+
+    /// @brief Destruct this null renderer.
+    virtual ~Renderer();
+
+public:
+    /**
+     * @brief
+     *  Complete the current frame.
+     * @post
+     *  The statistics of the current frame were added to the total statistics
+     *  and became the statistics of the last frame. The statistics of the current frame were reset.
+     */
+    void nextFrame();
+
+    /**
+     * @brief
+     *  Get the statistics of the current (uncompleted) frame.
+     */
+    const Statistics& getFrameStatistics() const;
+
+    /**
+     * @brief
+     *  Get the statistics of the last completed frame.
+     */
+    const Statistics& getLastFrameStatistics() const;
+
+    /**
+     * @brief
+     *  Get the sum of the statistics of all completed frames.
+     */
+    const Statistics& getTotalStatistics() const;
+
+    /**
+     * @brief
+     *  Get the number of completed frames.
+     */
+    size_t getNumberOfFrames() const;
+
+public:
+    /** @copydoc Ego::Renderer::getInfo() */
+    virtual const Ego::RendererInfo& getInfo() override;
+
+public:
+    /** @copydoc Ego::Renderer::getAccumulationBuffer() */
+    virtual Ego::AccumulationBuffer& getAccumulationBuffer() override;
+
+    /** @copydoc Ego::Renderer::getColourBuffer */
+    virtual Ego::ColourBuffer& getColourBuffer() override;
+
+    /** @copydoc Ego::Renderer::getDepthBuffer() */
+    virtual Ego::DepthBuffer& getDepthBuffer() override;
+
+    /** @copydoc Ego::Renderer::getStencilBuffer() */
+    virtual Ego::StencilBuffer& getStencilBuffer() override;
+
+    /** @copydoc Ego::Renderer::getTextureUnit() */
+    virtual Ego::TextureUnit& getTextureUnit() override;
+
+    /** @copydoc Ego::Renderer::setAlphaTestEnabled */
+    virtual void setAlphaTestEnabled(bool enabled) override;
+
+    /** @copydoc Ego::Renderer::setAlphaFunction */
+    virtual void setAlphaFunction(CompareFunction function, float value) override;
+
+    /** @copydoc Ego::Renderer::setBlendingEnabled */
+    virtual void setBlendingEnabled(bool enabled) override;
+
+    /** @copydoc Ego::Renderer::setSourceBlendFunction */
+    virtual void setBlendFunction(BlendFunction sourceColour, BlendFunction sourceAlpha,
+                                  BlendFunction destinationColour, BlendFunction destinationAlpha) override;
+
+    /** @copydoc Ego::Renderer::setColour */
+    virtual void setColour(const Colour4f& colour) override;
+
+    /** @copydoc Ego::Renderer::setCullingMode */
+    virtual void setCullingMode(CullingMode mode) override;
+
+    /** @copydoc Ego::Renderer::setDepthFunction */
+    virtual void setDepthFunction(CompareFunction function) override;
+
+    /** @copydoc Ego::Renderer::setDepthTestEnabled */
+    virtual void setDepthTestEnabled(bool enabled) override;
+
+    /** @copydoc Ego::Renderer::setDepthWriteEnabled */
+    virtual void setDepthWriteEnabled(bool enabled) override;
+
+    /** @copydoc Ego::Renderer::setScissorTestEnabled */
+    virtual void setScissorTestEnabled(bool enabled) override;
+
+    /** @copydoc Ego::Renderer::setScissorRectangle */
+    virtual void setScissorRectangle(float left, float bottom, float width, float height) override;
+
+    /** @copydoc Ego::Renderer::setStencilMaskBack */
+    virtual void setStencilMaskBack(uint32_t mask) override;
+
+    /** @copydoc Ego::Renderer::setStencilMaskFront */
+    virtual void setStencilMaskFront(uint32_t mask) override;
+
+    /** @copydoc Ego::Renderer::setStencilTestEnabled */
+    virtual void setStencilTestEnabled(bool enabled) override;
+
+    /** @copydoc Ego::Renderer::setViewportRectangle */
+    virtual void setViewportRectangle(float left, float bottom, float width, float height) override;
+
+    /** @copydoc Ego::Renderer::setWindingMode */
+    virtual void setWindingMode(WindingMode mode) override;
+
+    /** @copydoc Ego::Renderer::multMatrix */
+    virtual void multiplyMatrix(const Matrix4f4f& matrix) override;
+
+    /** @copydoc Ego::Renderer::setPerspectiveCorrectionEnabled */
+    virtual void setPerspectiveCorrectionEnabled(bool enabled) override;
+
+    /** @copydoc Ego::Renderer::setDitheringEnabled  */
+    virtual void setDitheringEnabled(bool enabled) override;
+
+    /** @copydoc Ego::Renderer::setPointSmoothEnabled */
+    virtual void setPointSmoothEnabled(bool enabled) override;
+
+    /** @copydoc Ego::Renderer::setLineSmoothEnabled */
+    virtual void setLineSmoothEnabled(bool enabled) override;
+
+    /** @copydoc Ego::Renderer::setLineWidth */
+    virtual void setLineWidth(float width) override;
+
+    /** @copydoc Ego::Renderer::setPointSize */
+    virtual void setPointSize(float size) override;
+
+    /** @copydoc Ego::Renderer::setPolygonSmoothEnabled */
+    virtual void setPolygonSmoothEnabled(bool enabled) override;
+
+    /** @copydoc Ego::Renderer::setMultisamplesEnabled */
+    virtual void setMultisamplesEnabled(bool enabled) override;
+
+    /** @copydoc Ego::Renderer::setLightingEnabled */
+    virtual void setLightingEnabled(bool enabled) override;
+
+    /** @copydoc Ego::Renderer::setRasterizationMode */
+    virtual void setRasterizationMode(RasterizationMode mode) override;
+
+    /** @copydoc Ego::Renderer::setGouraudShadingEnabled */
+    virtual void setGouraudShadingEnabled(bool enabled) override;
+
+    /** @copydoc Ego::Renderer::render */
+    virtual void render(VertexBuffer& vertexBuffer, PrimitiveType primitiveType, size_t index, size_t length) override;
+
+    /** @copydoc Ego::Renderer::createTexture */
+    virtual std::shared_ptr<Ego::Texture> createTexture() override;
+
+    /** @copydoc Ego::Renderer::setProjectionMatrix */
+    virtual void setProjectionMatrix(const Matrix4f4f& projectionMatrix) override;
+
+    /** @copydoc Ego::Renderer::setViewMatrix */
+    virtual void setViewMatrix(const Matrix4f4f& viewMatrix) override;
+
+    /** @copydoc Ego::Renderer::setWorldMatrix */
+    virtual void setWorldMatrix(const Matrix4f4f& worldMatrix) override;
+
+private:
+    /**
+     * @brief
+     *  Record a change of a state variable.
+     * @param variable
+     *  the state variable
+     * @param value
+     *  the new value of the state variable
+     * @post
+     *  The change was counted (and also counted as redundant if the value did not change).
+     */
+    template <typename T>
+    void change(T& variable, const T& value) {
+        _frameStatistics.stateChanges++;
+        if (variable == value) {
+            _frameStatistics.redundantStateChanges++;
+        }
+        variable = value;
+    }
+
+}; // class Renderer
+
+} // namespace Null
+} // namespace Ego
@@ -0,0 +1,77 @@
+//********************************************************************************************
+//*
+//*    This file is part of Egoboo.
+//*
+//*    Egoboo is free software: you can redistribute it and/or modify it
+//*    under the terms of the GNU General Public License as published by
+//*    the Free Software Foundation, either version 3 of the License, or
+//*    (at your option) any later version.
+//*
+//*    Egoboo is distributed in the hope that it will be useful, but
+//*    WITHOUT ANY WARRANTY; without even the implied warranty of
+//*    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+//*    General Public License for more details.
+//*
+//*    You should have received a copy of the GNU General Public License
+//*    along with Egoboo.  If not, see <http://www.gnu.org/licenses/>.
+//*
+//********************************************************************************************
+
+/// @file   egolib/Renderer/Null/Statistics.hpp
+/// @brief  Statistics gathered by the null renderer.
+
+#pragma once
+
+#include "egolib/platform.h"
+
+namespace Ego {
+namespace Null {
+
+/**
+ * @brief
+ *  The statistics gathered by the null renderer.
+ */
+struct Statistics {
+    /// @brief The number of calls to Ego::Renderer::render.
+    size_t drawCalls;
+    /// @brief The number of vertices submitted by calls to Ego::Renderer::render.
+    size_t vertices;
+    /// @brief The number of times a texture unit was activated with a texture.
+    size_t textureBinds;
+    /// @brief The number of calls changing the renderer state (including redundant ones).
+    size_t stateChanges;
+    /// @brief The number of calls setting the renderer state to the value it already had.
+    size_t redundantStateChanges;
+    /// @brief The number of buffer clears.
+    size_t clears;
+    /// @brief The number of textures created.
+    size_t texturesCreated;
+
+    Statistics() :
+        drawCalls(0), vertices(0), textureBinds(0), stateChanges(0),
+        redundantStateChanges(0), clears(0), texturesCreated(0)
+    {}
+
+    /**
+     * @brief
+     *  Reset all counters to zero.
+     */
+    void reset() {
+        *this = Statistics();
+    }
+
+    Statistics& operator+=(const Statistics& other) {
+        drawCalls += other.drawCalls;
+        vertices += other.vertices;
+        textureBinds += other.textureBinds;
+        stateChanges += other.stateChanges;
+        redundantStateChanges += other.redundantStateChanges;
+        clears += other.clears;
+        texturesCreated += other.texturesCreated;
+        return *this;
+    }
+
+}; // struct Statistics
+
+} // namespace Null
+} // namespace Ego
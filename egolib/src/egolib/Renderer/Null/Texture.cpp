@@ -0,0 +1,107 @@
+//********************************************************************************************
+//*
+//*    This file is part of Egoboo.
+//*
+//*    Egoboo is free software: you can redistribute it and/or modify it
+//*    under the terms of the GNU General Public License as published by
+//*    the Free Software Foundation, either version 3 of the License, or
+//*    (at your option) any later version.
+//*
+//*    Egoboo is distributed in the hope that it will be useful, but
+//*    WITHOUT ANY WARRANTY; without even the implied warranty of
+//*    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+//*    General Public License for more details.
+//*
+//*    You should have received a copy of the GNU General Public License
+//*    along with Egoboo.  If not, see <http://www.gnu.org/licenses/>.
+//*
+//********************************************************************************************
+
+/// @file   egolib/Renderer/Null/Texture.cpp
+/// @brief  Implementation of textures for the null renderer.
+
+#include "egolib/Renderer/Null/Texture.hpp"
+#include "egolib/Extensions/SDL_GL_extensions.h"
+
+namespace Ego {
+namespace Null {
+
+/// @brief The name of a default texture.
+static const char *DefaultName = "<default texture>";
+
+/// @brief The width and height of a default texture.
+static const int DefaultSize = 8;
+
+/// @brief Get the smallest power of two greater than or equal to a value.
+static int powerOfTwo(int x) {
+    int y = 1;
+    while (y < x) {
+        y <<= 1;
+    }
+    return y;
+}
+
+Texture::Texture() :
+    Ego::Texture
+        (
+            DefaultName,
+            TextureType::_2D,
+            TextureAddressMode::Repeat, TextureAddressMode::Repeat,
+            DefaultSize, DefaultSize,
+            DefaultSize, DefaultSize,
+            nullptr,
+            false
+        )
+{}
+
+Texture::~Texture() {
+    release();
+}
+
+bool Texture::load(const String& name, const SharedPtr<SDL_Surface>& surface) {
+    release();
+
+    if (!surface) {
+        throw Id::InvalidArgumentException(__FILE__, __LINE__, "nullptr == surface");
+    }
+
+    // Mirror the properties the OpenGL back-end derives from the surface.
+    _type = ((1 == surface->h) && (surface->w > 1)) ? TextureType::_1D : TextureType::_2D;
+    _addressModeS = TextureAddressMode::Repeat;
+    _addressModeT = TextureAddressMode::Repeat;
+    _width = powerOfTwo(surface->w);
+    _height = powerOfTwo(surface->h);
+    _source = surface;
+    _sourceWidth = surface->w;
+    _sourceHeight = surface->h;
+    _hasAlpha = Graphics::SDL::testAlpha(surface);
+    _name = name;
+    return true;
+}
+
+bool Texture::load(const SharedPtr<SDL_Surface>& surface) {
+    std::ostringstream stream;
+    stream << "<source " << static_cast<void *>(surface.get()) << ">";
+    return load(stream.str(), surface);
+}
+
+void Texture::release() {
+    if (isDefault()) {
+        return;
+    }
+    _source = nullptr;
+    _type = TextureType::_2D;
+    _addressModeS = TextureAddressMode::Repeat;
+    _addressModeT = TextureAddressMode::Repeat;
+    _width = _sourceWidth = DefaultSize;
+    _height = _sourceHeight = DefaultSize;
+    _name = DefaultName;
+    _hasAlpha = false;
+}
+
+bool Texture::isDefault() const {
+    return nullptr == _source;
+}
+
+} // namespace Null
+} // namespace Ego
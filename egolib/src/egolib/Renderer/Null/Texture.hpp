@@ -0,0 +1,68 @@
+//********************************************************************************************
+//*
+//*    This file is part of Egoboo.
+//*
+//*    Egoboo is free software: you can redistribute it and/or modify it
+//*    under the terms of the GNU General Public License as published by
+//*    the Free Software Foundation, either version 3 of the License, or
+//*    (at your option) any later version.
+//*
+//*    Egoboo is distributed in the hope that it will be useful, but
+//*    WITHOUT ANY WARRANTY; without even the implied warranty of
+//*    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+//*    General Public License for more details.
+//*
+//*    You should have received a copy of the GNU General Public License
+//*    along with Egoboo.  If not, see <http://www.gnu.org/licenses/>.
+//*
+//********************************************************************************************
+
+/// @file   egolib/Renderer/Null/Texture.hpp
+/// @brief  Implementation of textures for the null renderer.
+
+#pragma once
+
+#include "egolib/Renderer/Texture.hpp"
+
+namespace Ego {
+namespace Null {
+
+/**
+ * @brief
+ *  A texture of the null renderer.
+ *  Only the properties of the source image are stored, no texture data is uploaded anywhere.
+ */
+struct Texture : public Ego::Texture {
+
+public:
+    /** @override Ego::Texture::load(const String&, const SharedPtr<SDL_Surface>&) */
+    bool load(const String& name, const SharedPtr<SDL_Surface>& surface) override;
+
+    /** @override Ego::Texture::load(const SharedPtr<SDL_Surface>&) */
+    bool load(const SharedPtr<SDL_Surface>& surface) override;
+
+    /** @override Ego::Texture::release */
+    void release() override;
+
+    /** @override Ego::Texture::isDefault */
+    bool isDefault() const override;
+
+public:
+    /**
+     * @brief
+     *  Construct this texture.
+     * @post
+     *  This texture is a default texture.
+     */
+    Texture();
+
+    /**
+     * @brief
+     *  Destruct this texture.
+     */
+    virtual ~Texture();
+
+};
+
+} // namespace Null
+} // namespace Ego
@@ -23,14 +23,24 @@
 
 #include "egolib/Renderer/Renderer.hpp"
 #include "egolib/Renderer/OpenGL/Renderer.hpp"
+#include "egolib/Renderer/Null/Renderer.hpp"
 
 namespace Ego
 {
 
 namespace Core {
 
+RendererBackend CreateFunctor<Renderer>::backend = RendererBackend::OpenGL;
+
 Renderer *CreateFunctor<Renderer>::operator()() const {
-    return new Ego::OpenGL::Renderer();
+    switch (backend) {
+        case RendererBackend::OpenGL:
+            return new Ego::OpenGL::Renderer();
+        case RendererBackend::Null:
+            return new Ego::Null::Renderer();
+        default:
+            throw Id::UnhandledSwitchCaseException(__FILE__, __LINE__);
+    };
 }
 
 }
@@ -33,6 +33,7 @@
 #include "egolib/Renderer/PrimitiveType.hpp"
 #include "egolib/Renderer/TextureSampler.hpp"
 #include "egolib/Renderer/RendererInfo.hpp"
+#include "egolib/Renderer/RendererBackend.hpp"
 #include "egolib/Graphics/VertexBuffer.hpp"
 #include "egolib/Renderer/Texture.hpp"
 
@@ -277,6 +278,14 @@ namespace Core {
  */
 template <>
 struct CreateFunctor<Renderer> {
+    /**
+     * @brief
+     *  The back-end created by this functor.
+     * @remark
+     *  Default is Ego::RendererBackend::OpenGL.
+     *  Must be set before Ego::Renderer::initialize() is invoked.
+     */
+    static RendererBackend backend;
     Renderer *operator()() const;
 };
 
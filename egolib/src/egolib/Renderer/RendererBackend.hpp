@@ -0,0 +1,49 @@
+//********************************************************************************************
+//*
+//*    This file is part of Egoboo.
+//*
+//*    Egoboo is free software: you can redistribute it and/or modify it
+//*    under the terms of the GNU General Public License as published by
+//*    the Free Software Foundation, either version 3 of the License, or
+//*    (at your option) any later version.
+//*
+//*    Egoboo is distributed in the hope that it will be useful, but
+//*    WITHOUT ANY WARRANTY; without even the implied warranty of
+//*    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+//*    General Public License for more details.
+//*
+//*    You should have received a copy of the GNU General Public License
+//*    along with Egoboo.  If not, see <http://www.gnu.org/licenses/>.
+//*
+//********************************************************************************************
+
+/// @file   egolib/Renderer/RendererBackend.hpp
+/// @brief  An enumeration of renderer back-ends.
+
+#pragma once
+
+namespace Ego {
+
+/**
+ * @brief
+ *  An enumeration of the renderer back-ends.
+ */
+enum class RendererBackend {
+
+    /**
+     * @brief
+     *  The OpenGL 2.1 back-end.
+     */
+    OpenGL,
+
+    /**
+     * @brief
+     *  The null back-end.
+     *  Keeps all state in memory and does not require a graphics device.
+     *  It counts draw calls, vertices, texture binds and state changes.
+     */
+    Null,
+
+}; // enum class RendererBackend
+
+} // namespace Ego
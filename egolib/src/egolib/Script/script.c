@@ -108,12 +108,6 @@ Runtime::~Runtime()
 } // namespace Script
 } // namespace Ego
 
-//--------------------------------------------------------------------------------------------
-//--------------------------------------------------------------------------------------------
-
-static PRO_REF script_error_model = INVALID_PRO_REF;
-static const char * script_error_classname = "UNKNOWN";
-
 //--------------------------------------------------------------------------------------------
 //--------------------------------------------------------------------------------------------
 void scripting_system_begin()
@@ -135,24 +129,15 @@ void scripting_system_end()
 
 //--------------------------------------------------------------------------------------------
 //--------------------------------------------------------------------------------------------
-void scr_run_chr_script(Object *pchr)
+static bool scr_begin_chr_script(Object *pchr, ai_state_t& aiState, const script_info_t& script, script_state_t& state)
 {
-
-    // Make sure that this module is initialized.
-    scripting_system_begin();
-
-    // Do not run scripts of terminated entities.
-    if (pchr->isTerminated())
-    {
-        return;
-    }
-    ai_state_t& aiState = pchr->ai;
-    script_info_t& script = pchr->getProfile()->getAIScript();
+    /// @details Prepare the A.I. state of a character for running its script.
+    /// Returns false if the script must not be run.
 
     // Has the time for this character to die come and gone?
     if (aiState.poof_time >= 0 && aiState.poof_time <= (Sint32)update_wld)
     {
-        return;
+        return false;
     }
 
     // Grab the "changed" value from the last time the script was run.
@@ -162,8 +147,6 @@ void scr_run_chr_script(Object *pchr)
         aiState.changed = false;
     }
 
-    Ego::Time::ClockScope<Ego::Time::ClockPolicy::NonRecursive> scope(*aiState._clock);
-
     // debug a certain script
     // debug_scripts = ( 385 == pself->index && 76 == pchr->profile_ref );
 
@@ -171,11 +154,11 @@ void scr_run_chr_script(Object *pchr)
     aiState.setOldTarget(aiState.getTarget());
 
     // Make life easier
-    script_error_classname = "UNKNOWN";
-    script_error_model = pchr->getProfileID();
-    if (script_error_model < INVALID_PRO_REF)
+    state.errorClassName = "UNKNOWN";
+    state.errorModel = pchr->getProfileID();
+    if (state.errorModel < INVALID_PRO_REF)
     {
-        script_error_classname = ProfileSystem::get().getProfile(script_error_model)->getClassName().c_str();
+        state.errorClassName = ProfileSystem::get().getProfile(state.errorModel)->getClassName().c_str();
     }
 
     if (debug_scripts && debug_script_file)
@@ -183,7 +166,7 @@ void scr_run_chr_script(Object *pchr)
         vfs_FILE * scr_file = debug_script_file;
 
         vfs_printf(scr_file, "\n\n--------\n%s\n", script._name.c_str());
-        vfs_printf(scr_file, "%d - %s\n", REF_TO_INT(script_error_model), script_error_classname);
+        vfs_printf(scr_file, "%d - %s\n", REF_TO_INT(state.errorModel), state.errorClassName);
 
         // who are we related to?
         vfs_printf(scr_file, "\tself   == %" PRIuZ "\n", aiState.getSelf().get());
@@ -232,39 +215,45 @@ void scr_run_chr_script(Object *pchr)
         }
     }
 
-    // Reset the script state.
-    script_state_t my_state;
-
     // Reset the ai.
     aiState.terminate = false;
-    script.indent = 0;
+
+    return true;
+}
+
+static void scr_execute_chr_script(ai_state_t& aiState, script_info_t& script, script_state_t& state)
+{
+    state.indent = 0;
 
     // Run the AI Script.
-    script.set_pos(0);
-    while (!aiState.terminate && script.get_pos() < script._instructions.getNumberOfInstructions())
+    state.set_pos(script, 0);
+    while (!aiState.terminate && state.get_pos() < script._instructions.getNumberOfInstructions())
     {
         // This is used by the Else function
         // it only keeps track of functions.
-        script.indent_last = script.indent;
-        script.indent = script._instructions[script.get_pos()].getDataBits();
+        state.indent_last = state.indent;
+        state.indent = script._instructions[state.get_pos()].getDataBits();
 
         // Was it a function.
-        if (script._instructions[script.get_pos()].isInv())
+        if (script._instructions[state.get_pos()].isInv())
         {
-            if (!my_state.run_function_call(aiState, script))
+            if (!state.run_function_call(aiState, script))
             {
                 break;
             }
         }
         else
         {
-            if (!my_state.run_operation(aiState, script))
+            if (!state.run_operation(aiState, script))
             {
                 break;
             }
         }
     }
+}
 
+static void scr_end_chr_script(Object *pchr, ai_state_t& aiState)
+{
     // Set movement latches
     if (!pchr->isPlayer())
     {
@@ -288,6 +277,34 @@ void scr_run_chr_script(Object *pchr)
     // Clear alerts for next time around
     RESET_BIT_FIELD(aiState.alert);
 }
+
+//--------------------------------------------------------------------------------------------
+void scr_run_chr_script(Object *pchr)
+{
+
+    // Make sure that this module is initialized.
+    scripting_system_begin();
+
+    // Do not run scripts of terminated entities.
+    if (pchr->isTerminated())
+    {
+        return;
+    }
+    ai_state_t& aiState = pchr->ai;
+    script_info_t& script = pchr->getProfile()->getAIScript();
+
+    // Reset the script state.
+    script_state_t my_state;
+
+    Ego::Time::ClockScope<Ego::Time::ClockPolicy::NonRecursive> scope(*aiState._clock);
+
+    if (!scr_begin_chr_script(pchr, aiState, script, my_state))
+    {
+        return;
+    }
+    scr_execute_chr_script(aiState, script, my_state);
+    scr_end_chr_script(pchr, aiState);
+}
 void scr_run_chr_script(const ObjectRef character)
 {
     /// @author ZZ
@@ -304,34 +321,225 @@ void scr_run_chr_script(const ObjectRef character)
     return scr_run_chr_script(pchr);
 }
 
+//--------------------------------------------------------------------------------------------
+bool scr_run_chr_script_concurrent(Object *pchr, ai_state_t& aiState, Ego::Core::CommandBuffer& commands, size_t commandKey)
+{
+    // Do not run scripts of terminated entities.
+    if (pchr->isTerminated())
+    {
+        return false;
+    }
+    script_info_t& script = pchr->getProfile()->getAIScript();
+
+    // Reset the script state, changes of other objects are recorded.
+    script_state_t my_state;
+    my_state.commands = &commands;
+    my_state.commandKey = commandKey;
+
+    Ego::Time::ClockScope<Ego::Time::ClockPolicy::NonRecursive> scope(*aiState._clock);
+
+    if (!scr_begin_chr_script(pchr, aiState, script, my_state))
+    {
+        return false;
+    }
+    scr_execute_chr_script(aiState, script, my_state);
+    return true;
+}
+
+void scr_commit_chr_script(Object *pchr, const ai_state_t& aiState)
+{
+    pchr->ai = aiState;
+    scr_end_chr_script(pchr, pchr->ai);
+}
+
+//--------------------------------------------------------------------------------------------
+static bool scr_is_concurrent_function(uint32_t functionIndex)
+{
+    /// @details Functions which only read other objects and only write the A.I. state, the latches
+    /// or the turn mode of the object running the script, and functions which record their changes
+    /// of other objects if the script runs concurrently. Functions which use random numbers, spawn
+    /// objects or particles, or change other objects directly are not listed.
+    switch (functionIndex)
+    {
+        // Alerts.
+        case ScriptFunctions::IfSpawned:
+        case ScriptFunctions::IfTimeOut:
+        case ScriptFunctions::IfAtWaypoint:
+        case ScriptFunctions::IfAtLastWaypoint:
+        case ScriptFunctions::IfAttacked:
+        case ScriptFunctions::IfBumped:
+        case ScriptFunctions::IfOrdered:
+        case ScriptFunctions::IfCalledForHelp:
+        case ScriptFunctions::IfKilled:
+        case ScriptFunctions::IfTargetKilled:
+        case ScriptFunctions::IfHealed:
+        case ScriptFunctions::IfDropped:
+        case ScriptFunctions::IfGrabbed:
+        case ScriptFunctions::IfTakenOut:
+        case ScriptFunctions::IfHitGround:
+        case ScriptFunctions::IfUsed:
+        case ScriptFunctions::IfScoredAHit:
+        case ScriptFunctions::IfBlocked:
+        case ScriptFunctions::IfNotDropped:
+        case ScriptFunctions::IfInWater:
+        case ScriptFunctions::IfReaffirmed:
+        case ScriptFunctions::IfDisaffirmed:
+        case ScriptFunctions::IfCleanedUp:
+        case ScriptFunctions::IfCrushed:
+        case ScriptFunctions::IfThrown:
+        case ScriptFunctions::IfBored:
+        case ScriptFunctions::IfNotPutAway:
+        case ScriptFunctions::IfHitVulnerable:
+        case ScriptFunctions::IfHitFromBehind:
+        case ScriptFunctions::IfHitFromFront:
+        case ScriptFunctions::IfHitFromLeft:
+        case ScriptFunctions::IfHitFromRight:
+        // Registers and local storage.
+        case ScriptFunctions::SetContent:
+        case ScriptFunctions::GetContent:
+        case ScriptFunctions::IfContentIs:
+        case ScriptFunctions::SetState:
+        case ScriptFunctions::GetState:
+        case ScriptFunctions::IfStateIs:
+        case ScriptFunctions::IfStateIsNot:
+        case ScriptFunctions::IfStateIsOdd:
+        case ScriptFunctions::IfStateIs0:
+        case ScriptFunctions::IfStateIs1:
+        case ScriptFunctions::IfStateIs2:
+        case ScriptFunctions::IfStateIs3:
+        case ScriptFunctions::IfStateIs4:
+        case ScriptFunctions::IfStateIs5:
+        case ScriptFunctions::IfStateIs6:
+        case ScriptFunctions::IfStateIs7:
+        case ScriptFunctions::IfStateIs8:
+        case ScriptFunctions::IfStateIs9:
+        case ScriptFunctions::SetTime:
+        case ScriptFunctions::SetXY:
+        case ScriptFunctions::GetXY:
+        case ScriptFunctions::Compass:
+        case ScriptFunctions::IfXIsLessThanY:
+        case ScriptFunctions::IfYIsLessThanX:
+        case ScriptFunctions::IfXIsEqualToY:
+        case ScriptFunctions::IfDistanceIsMoreThanTurn:
+        case ScriptFunctions::Else:
+        case ScriptFunctions::End:
+        // Targets.
+        case ScriptFunctions::SetTargetToSelf:
+        case ScriptFunctions::SetTargetToOwner:
+        case ScriptFunctions::SetTargetToWhoeverAttacked:
+        case ScriptFunctions::SetTargetToWhoeverBumped:
+        case ScriptFunctions::SetTargetToNearbyEnemy:
+        case ScriptFunctions::SetTargetToWideEnemy:
+        case ScriptFunctions::SetTargetToDistantEnemy:
+        case ScriptFunctions::SetTargetToNearestEnemy:
+        case ScriptFunctions::IfTargetIsOldTarget:
+        case ScriptFunctions::IfTargetIsSelf:
+        case ScriptFunctions::IfTargetIsOwner:
+        case ScriptFunctions::IfTargetIsAlive:
+        case ScriptFunctions::IfTargetIsHurt:
+        case ScriptFunctions::IfTargetIsMale:
+        case ScriptFunctions::IfTargetIsFemale:
+        case ScriptFunctions::IfTargetIsAPlayer:
+        case ScriptFunctions::IfTargetIsAMount:
+        case ScriptFunctions::IfTargetIsFlying:
+        case ScriptFunctions::IfTargetIsAttacking:
+        case ScriptFunctions::IfTargetIsOnHatedTeam:
+        case ScriptFunctions::IfTargetIsOnSameTeam:
+        case ScriptFunctions::IfTargetCanSeeInvisible:
+        case ScriptFunctions::IfTargetHasID:
+        case ScriptFunctions::IfTargetHoldingItemID:
+        case ScriptFunctions::GetTargetArmorPrice:
+        case ScriptFunctions::IfFacingTarget:
+        case ScriptFunctions::IfSitting:
+        // Movement.
+        case ScriptFunctions::ClearWaypoints:
+        case ScriptFunctions::AddWaypoint:
+        case ScriptFunctions::SetTurnModeToVelocity:
+        case ScriptFunctions::SetTurnModeToWatch:
+        case ScriptFunctions::SetTurnModeToSpin:
+        case ScriptFunctions::SetTurnModeToWatchTarget:
+        case ScriptFunctions::PressLatchButton:
+        case ScriptFunctions::Run:
+        case ScriptFunctions::Walk:
+        case ScriptFunctions::Sneak:
+        // Recorded if the script runs concurrently.
+        case ScriptFunctions::IssueOrder:
+        case ScriptFunctions::PlaySound:
+            return true;
+        default:
+            return false;
+    };
+}
+
+bool scr_is_concurrent(const script_info_t& script)
+{
+    const auto& instructions = script._instructions;
+    const auto& constantPool = instructions.getConstantPool();
+    size_t position = 0;
+    while (position < instructions.getNumberOfInstructions())
+    {
+        const auto& instruction = instructions[position];
+        const auto& constant = constantPool.getConstant(instruction.getValueBits());
+        if (instruction.isInv())
+        {
+            // A function call followed by its jump code.
+            if (!scr_is_concurrent_function(constant.getAsInteger()))
+            {
+                return false;
+            }
+            position += 2;
+        }
+        else
+        {
+            // An operation followed by the number of operands and the operands.
+            if (position + 1 >= instructions.getNumberOfInstructions())
+            {
+                break;
+            }
+            size_t operandCount = instructions[position + 1].getBits();
+            for (size_t i = 0; i < operandCount && position + 2 + i < instructions.getNumberOfInstructions(); ++i)
+            {
+                // Random numbers must be drawn in the serial update order.
+                const auto& operand = instructions[position + 2 + i];
+                if (!operand.isLdc() && VARRAND == constantPool.getConstant(operand.getValueBits()).getAsInteger())
+                {
+                    return false;
+                }
+            }
+            position += 2 + operandCount;
+        }
+    }
+    return true;
+}
+
 //--------------------------------------------------------------------------------------------
 bool script_state_t::run_function_call(ai_state_t& aiState, script_info_t& script)
 {
     Uint8  functionreturn;
 
     // check for valid execution pointer
-    if (script.get_pos() >= script._instructions.getNumberOfInstructions()) return false;
+    if (get_pos() >= script._instructions.getNumberOfInstructions()) return false;
 
     // Run the function
     functionreturn = run_function(aiState, script);
 
     // move the execution pointer to the jump code
-    script.increment_pos();
+    increment_pos(script);
     if (functionreturn)
     {
         // move the execution pointer to the next opcode
-        script.increment_pos();
+        increment_pos(script);
     }
     else
     {
         // use the jump code to jump to the right location
-        size_t new_index = script._instructions[script.get_pos()].getBits();
+        size_t new_index = script._instructions[get_pos()].getBits();
 
         // make sure the value is valid
         EGOBOO_ASSERT(new_index <= script._instructions.getNumberOfInstructions());
 
         // actually do the jump
-        script.set_pos(new_index);
+        set_pos(script, new_index);
     }
 
     return true;
@@ -342,9 +550,9 @@ bool script_state_t::run_function_call(ai_state_t& aiState, script_info_t& scrip
 bool script_state_t::run_operation(ai_state_t& aiState, script_info_t& script)
 {
     // check for valid execution pointer
-    if (script.get_pos() >= script._instructions.getNumberOfInstructions()) return false;
+    if (get_pos() >= script._instructions.getNumberOfInstructions()) return false;
 
-    auto constantIndex = script._instructions[script.get_pos()].getValueBits();
+    auto constantIndex = script._instructions[get_pos()].getValueBits();
     const auto& constant = script._instructions.getConstantPool().getConstant(constantIndex);
     uint32_t variableIndex = constant.getAsInteger();
 
@@ -353,7 +561,7 @@ bool script_state_t::run_operation(ai_state_t& aiState, script_info_t& script)
     if (debug_scripts && debug_script_file)
     {
 
-        for (auto i = 0; i < script.indent; i++) { vfs_printf(debug_script_file, "  "); }
+        for (auto i = 0; i < indent; i++) { vfs_printf(debug_script_file, "  "); }
 
         for (auto i = 0; i < Opcodes.size(); i++)
         {
@@ -368,14 +576,14 @@ bool script_state_t::run_operation(ai_state_t& aiState, script_info_t& script)
     }
 
     // Get the number of operands
-    script.increment_pos();
-    auto operand_count = script._instructions[script.get_pos()].getBits();
+    increment_pos(script);
+    auto operand_count = script._instructions[get_pos()].getBits();
 
     // Now run the operation
     operationsum = 0;
-    for (auto i = 0; i < operand_count && script.get_pos() < script._instructions.getNumberOfInstructions(); ++i)
+    for (auto i = 0; i < operand_count && get_pos() < script._instructions.getNumberOfInstructions(); ++i)
     {
-        script.increment_pos();
+        increment_pos(script);
         run_operand(aiState, script);
     }
     if (debug_scripts && debug_script_file)
@@ -387,7 +595,7 @@ bool script_state_t::run_operation(ai_state_t& aiState, script_info_t& script)
     storeVariable(variableIndex);
 
     // go to the next opcode
-    script.increment_pos();
+    increment_pos(script);
 
     return true;
 }
@@ -395,21 +603,26 @@ bool script_state_t::run_operation(ai_state_t& aiState, script_info_t& script)
 //--------------------------------------------------------------------------------------------
 Uint8 script_state_t::run_function(ai_state_t& aiState, script_info_t& script)
 {
-    auto constantIndex = script._instructions[script.get_pos()].getValueBits();
+    auto constantIndex = script._instructions[get_pos()].getValueBits();
     const auto& constant = script._instructions.getConstantPool().getConstant(constantIndex);
     uint32_t functionIndex = constant.getAsInteger();
 
     // Assume that the function will pass, as most do
     uint8_t returnCode = true;
     auto& runtime = Runtime::get();
+    const auto& result = runtime._functionValueCodeToFunctionPointer.find(functionIndex);
+    if (runtime._functionValueCodeToFunctionPointer.cend() == result)
+    {
+        throw RuntimeErrorException(__FILE__, __LINE__, "function not found");
+    }
+    // The runtime clock and statistics are shared by all scripts:
+    // Do not measure functions of scripts running concurrently.
+    if (nullptr != commands)
+    {
+        return result->second(*this, aiState);
+    }
     {
-
         Ego::Time::ClockScope<Ego::Time::ClockPolicy::NonRecursive> scope(runtime.getClock());
-        const auto& result = runtime._functionValueCodeToFunctionPointer.find(functionIndex);
-        if (runtime._functionValueCodeToFunctionPointer.cend() == result)
-        {
-            throw RuntimeErrorException(__FILE__, __LINE__, "function not found");
-        }
         returnCode = result->second(*this, aiState);
     }
     runtime.getStatistics().onFunctionInvoked(functionIndex, runtime.getClock().lst());
@@ -590,10 +803,10 @@ void script_state_t::run_operand(ai_state_t& aiState, script_info_t& script)
     // get the operator
     int32_t iTmp = 0;
 
-    auto constantIndex = script._instructions[script.get_pos()].getValueBits();
+    auto constantIndex = script._instructions[get_pos()].getValueBits();
     const auto& constant = script._instructions.getConstantPool().getConstant(constantIndex);
-    uint8_t operation = script._instructions[script.get_pos()].getDataBits();
-    if (script._instructions[script.get_pos()].isLdc())
+    uint8_t operation = script._instructions[get_pos()].getDataBits();
+    if (script._instructions[get_pos()].isLdc())
     {
         // Load the constant.
         iTmp = constant.getAsInteger();
@@ -656,7 +869,7 @@ void script_state_t::run_operand(ai_state_t& aiState, script_info_t& script)
             else
             {
                 Log::get() << Log::Entry::create(Log::Level::Message, __FILE__, __LINE__, "script error - model = ",
-                                                 REF_TO_INT(script_error_model), " class name == `", script_error_classname,
+                                                 REF_TO_INT(errorModel), " class name == `", errorClassName,
                                                  "`: divide by zero", Log::EndOfEntry);
             }
             break;
@@ -670,14 +883,14 @@ void script_state_t::run_operand(ai_state_t& aiState, script_info_t& script)
             else
             {
                 Log::get() << Log::Entry::create(Log::Level::Message, __FILE__, __LINE__, "script error - model = ",
-                                                 REF_TO_INT(script_error_model), " class name == `", script_error_classname,
+                                                 REF_TO_INT(errorModel), " class name == `", errorClassName,
                                                  "`: modulo by zero", Log::EndOfEntry);
             }
             break;
 
         default:
             Log::get() << Log::Entry::create(Log::Level::Message, __FILE__, __LINE__, "script error - model = ",
-                                             REF_TO_INT(script_error_model), " class name == `", script_error_classname,
+                                             REF_TO_INT(errorModel), " class name == `", errorClassName,
                                              "`: unknown opcode", Log::EndOfEntry);
             break;
     }
@@ -690,9 +903,9 @@ void script_state_t::run_operand(ai_state_t& aiState, script_info_t& script)
 
 //--------------------------------------------------------------------------------------------
 
-bool script_info_t::increment_pos()
+bool script_state_t::increment_pos(const script_info_t& script)
 {
-    if (_position >= _instructions.getNumberOfInstructions())
+    if (_position >= script._instructions.getNumberOfInstructions())
     {
         return false;
     }
@@ -700,14 +913,14 @@ bool script_info_t::increment_pos()
     return true;
 }
 
-size_t script_info_t::get_pos() const
+size_t script_state_t::get_pos() const
 {
     return _position;
 }
 
-bool script_info_t::set_pos(size_t position)
+bool script_state_t::set_pos(const script_info_t& script, size_t position)
 {
-    if (position >= _instructions.getNumberOfInstructions())
+    if (position >= script._instructions.getNumberOfInstructions())
     {
         return false;
     }
@@ -1041,5 +1254,9 @@ void ai_state_t::spawn(ai_state_t& self, const ObjectRef index, const PRO_REF io
 //--------------------------------------------------------------------------------------------
 script_state_t::script_state_t()
     : x(0), y(0), turn(0), distance(0),
-    argument(0), operationsum()
+    argument(0), operationsum(),
+    indent(0), indent_last(0),
+    errorModel(INVALID_PRO_REF), errorClassName("UNKNOWN"),
+    commands(nullptr), commandKey(0),
+    _position(0)
 {}
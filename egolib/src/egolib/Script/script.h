@@ -23,6 +23,7 @@
 
 #include "egolib/typedef.h"
 #include "egolib/Core/Singleton.hpp"
+#include "egolib/Core/CommandBuffer.hpp"
 #include "egolib/Logic/Damage.hpp"
 #include "egolib/IDSZ.hpp"
 #include "egolib/Clock.hpp"
@@ -380,10 +381,8 @@ struct script_info_t
 public:
     script_info_t() :
         _name(),
-        indent(0),
-        indent_last(0),
-        _position(0),
-        _instructions()
+        _instructions(),
+        _concurrent(false)
     {
         //ctor
     }
@@ -405,25 +404,19 @@ public:
 		return _name;
 	}
 
-    uint32_t        indent;
-    uint32_t        indent_last;
-
-
 	/**
 	 * @brief
-	 *	The instruction index.
+	 *	The instruction list.
 	 */
-    size_t _position;
+	InstructionList _instructions;
 
 	/**
 	 * @brief
-	 *	The instruction list.
+	 *	If this script may run concurrently with the scripts of other objects.
+	 * @see
+	 *	scr_is_concurrent
 	 */
-	InstructionList _instructions;
-
-	bool increment_pos();
-	size_t get_pos() const;
-	bool set_pos(size_t position);
+	bool _concurrent;
 
 };
 
@@ -452,7 +445,7 @@ public:
     int            state;         ///< Short term memory for AI
     int            content;       ///< More short term memory
     int            passage;       ///< The passage associated with this character
-    Uint32         timer;         ///< AI Timer
+    Uint32         timer;         ///< AI Timer: the update frame after which IfTimeOut proceeds, it is not counted down
     int            x[STOR_COUNT]; ///< Temporary values...  SetXY
     int            y[STOR_COUNT];
     float          maxSpeed;      ///< Artificial movement speed limit for AI
@@ -507,6 +500,18 @@ struct script_state_t : Id::NonCopyable
     using TaggedValue = Ego::Script::Interpreter::TaggedValue;
     TaggedValue operationsum; /// The result of an arithmetic operation
 
+    uint32_t indent;        ///< The indention of the current function (used by "Else").
+    uint32_t indent_last;   ///< The indention of the previous function (used by "Else").
+
+    PRO_REF     errorModel;     ///< The profile of the object running the script (used in error messages).
+    const char *errorClassName; ///< The class name of the object running the script (used in error messages).
+
+    /// @brief If not null, functions changing other objects record commands into this buffer instead.
+    /// @remark Set if the script runs concurrently with the scripts of other objects.
+    Ego::Core::CommandBuffer *commands;
+    /// @brief The key of the recorded commands.
+    size_t commandKey;
+
 	// public
 	script_state_t();
 
@@ -522,6 +527,14 @@ struct script_state_t : Id::NonCopyable
 	void run_operand(ai_state_t& aiState, script_info_t& script);
 	bool run_operation(ai_state_t& aiState, script_info_t& script);
 	bool run_function_call(ai_state_t& aiState, script_info_t& script);
+
+	bool increment_pos(const script_info_t& script);
+	size_t get_pos() const;
+	bool set_pos(const script_info_t& script, size_t position);
+
+private:
+	/// @brief The instruction index.
+	size_t _position;
 };
 
 //--------------------------------------------------------------------------------------------
@@ -531,6 +544,39 @@ struct script_state_t : Id::NonCopyable
 void scr_run_chr_script(Object *pchr);
 void scr_run_chr_script(const ObjectRef character);
 
+/**
+ * @brief
+ *  Run the script of an object concurrently with the scripts of other objects.
+ * @param pchr
+ *  the object
+ * @param aiState
+ *  a copy of the A.I. state of the object the script runs on
+ * @param commands, commandKey
+ *  the command buffer and the key to record changes of other objects with
+ * @return
+ *  @a true if the script was run and scr_commit_chr_script must be called, @a false otherwise
+ * @remark
+ *  The script must be concurrent (see scr_is_concurrent).
+ *  It only reads other objects and writes the latches and the turn mode of @a pchr.
+ */
+bool scr_run_chr_script_concurrent(Object *pchr, ai_state_t& aiState, Ego::Core::CommandBuffer& commands, size_t commandKey);
+
+/**
+ * @brief
+ *  Commit the result of scr_run_chr_script_concurrent: Store the A.I. state
+ *  in the object and set its movement latches.
+ */
+void scr_commit_chr_script(Object *pchr, const ai_state_t& aiState);
+
+/**
+ * @brief
+ *  Get if a script may run concurrently with the scripts of other objects.
+ * @return
+ *  @a true if the script only invokes functions which do not change other objects
+ *  (or which can defer these changes) and does not use random numbers
+ */
+bool scr_is_concurrent(const script_info_t& script);
+
 void issue_order( const ObjectRef character, Uint32 order );
 void issue_special_order( uint32_t order, const IDSZ2& idsz );
 void set_alerts( const ObjectRef character );
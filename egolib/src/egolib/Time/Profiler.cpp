@@ -0,0 +1,280 @@
+//********************************************************************************************
+//*
+//*    This file is part of Egoboo.
+//*
+//*    Egoboo is free software: you can redistribute it and/or modify it
+//*    under the terms of the GNU General Public License as published by
+//*    the Free Software Foundation, either version 3 of the License, or
+//*    (at your option) any later version.
+//*
+//*    Egoboo is distributed in the hope that it will be useful, but
+//*    WITHOUT ANY WARRANTY; without even the implied warranty of
+//*    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+//*    General Public License for more details.
+//*
+//*    You should have received a copy of the GNU General Public License
+//*    along with Egoboo.  If not, see <http://www.gnu.org/licenses/>.
+//*
+//********************************************************************************************
+
+/// @file   egolib/Time/Profiler.cpp
+/// @brief  A hierarchical zone profiler.
+
+#include "egolib/Time/Profiler.hpp"
+#include "egolib/vfs.h"
+
+namespace Ego {
+namespace Time {
+
+namespace {
+
+/// @brief Get the current point in time in nanoseconds.
+int64_t getTime() {
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::high_resolution_clock::now().time_since_epoch()).count();
+}
+
+/// @brief A zone event.
+struct Event {
+    /// @brief The zone ID.
+    Profiler::ZoneId zoneId;
+    /// @brief The nesting depth of the zone.
+    uint32_t depth;
+    /// @brief The point in time (in nanoseconds since the capture was started) at which the zone was entered.
+    int64_t begin;
+    /// @brief The duration (in nanoseconds) spent in the zone.
+    int64_t duration;
+};
+
+/// @brief A frame marker.
+struct FrameMarker {
+    /// @brief The frame number.
+    uint64_t frame;
+    /// @brief The point in time (in nanoseconds since the capture was started) at which the frame began.
+    int64_t time;
+};
+
+/// @brief The events of a single thread.
+struct ThreadBuffer {
+    /// @brief Guards the events and the zone stack against concurrent access by the exporter.
+    std::mutex mutex;
+    /// @brief The index of the thread (in the order in which threads recorded their first event).
+    uint32_t threadIndex;
+    /// @brief The recorded events.
+    std::vector<Event> events;
+    /// @brief The stack of zones entered by the thread and the points in time at which they were entered.
+    std::vector<std::pair<Profiler::ZoneId, int64_t>> stack;
+    /// @brief The number of events dropped because the event limit was reached.
+    size_t dropped;
+
+    ThreadBuffer(uint32_t threadIndex) :
+        mutex(), threadIndex(threadIndex), events(), stack(), dropped(0) {}
+};
+
+/// @brief The state of the profiler.
+struct State {
+    std::mutex mutex;
+    std::vector<std::string> zoneNames;
+    std::unordered_map<std::string, Profiler::ZoneId> zoneIds;
+    std::vector<std::unique_ptr<ThreadBuffer>> threads;
+    std::vector<FrameMarker> frames;
+    uint64_t frameCounter;
+    /// @brief The point in time (in nanoseconds) at which the capture was started.
+    std::atomic<int64_t> epoch;
+
+    State() :
+        mutex(), zoneNames(), zoneIds(), threads(), frames(), frameCounter(0),
+        epoch(getTime()) {}
+};
+
+State& getState() {
+    static State state;
+    return state;
+}
+
+thread_local ThreadBuffer *t_threadBuffer = nullptr;
+
+ThreadBuffer& getThreadBuffer() {
+    if (!t_threadBuffer) {
+        State& state = getState();
+        std::lock_guard<std::mutex> lock(state.mutex);
+        state.threads.push_back(std::make_unique<ThreadBuffer>(static_cast<uint32_t>(state.threads.size())));
+        t_threadBuffer = state.threads.back().get();
+    }
+    return *t_threadBuffer;
+}
+
+/// @brief Get the current point in time in nanoseconds since the capture was started.
+int64_t now() {
+    return getTime() - getState().epoch.load(std::memory_order_relaxed);
+}
+
+/// @brief Escape a string for use in a JSON string literal.
+std::string escape(const std::string& source) {
+    std::string target;
+    target.reserve(source.size());
+    for (char c : source) {
+        switch (c) {
+            case '"': target += "\\\""; break;
+            case '\\': target += "\\\\"; break;
+            default:
+                if (static_cast<unsigned char>(c) < 0x20) {
+                    target += ' ';
+                } else {
+                    target += c;
+                }
+                break;
+        };
+    }
+    return target;
+}
+
+} // namespace
+
+std::atomic<bool> Profiler::_capturing(false);
+
+const Profiler::ZoneId Profiler::InvalidZoneId;
+
+const size_t Profiler::MaximumEventsPerThread;
+
+Profiler::ZoneId Profiler::getZoneId(const std::string& name) {
+    if (name.empty()) {
+        return InvalidZoneId;
+    }
+    State& state = getState();
+    std::lock_guard<std::mutex> lock(state.mutex);
+    auto it = state.zoneIds.find(name);
+    if (it != state.zoneIds.end()) {
+        return it->second;
+    }
+    ZoneId zoneId = static_cast<ZoneId>(state.zoneNames.size());
+    state.zoneNames.push_back(name);
+    state.zoneIds.emplace(name, zoneId);
+    return zoneId;
+}
+
+void Profiler::startCapture() {
+    State& state = getState();
+    std::lock_guard<std::mutex> lock(state.mutex);
+    _capturing.store(false);
+    for (auto& thread : state.threads) {
+        std::lock_guard<std::mutex> threadLock(thread->mutex);
+        thread->events.clear();
+        thread->stack.clear();
+        thread->dropped = 0;
+    }
+    state.frames.clear();
+    state.epoch.store(getTime());
+    _capturing.store(true);
+}
+
+void Profiler::stopCapture() {
+    _capturing.store(false);
+}
+
+void Profiler::enterZone(ZoneId zoneId) {
+    if (InvalidZoneId == zoneId) {
+        return;
+    }
+    ThreadBuffer& thread = getThreadBuffer();
+    std::lock_guard<std::mutex> lock(thread.mutex);
+    thread.stack.emplace_back(zoneId, now());
+}
+
+void Profiler::leaveZone(ZoneId zoneId) {
+    if (InvalidZoneId == zoneId) {
+        return;
+    }
+    int64_t end = now();
+    ThreadBuffer& thread = getThreadBuffer();
+    std::lock_guard<std::mutex> lock(thread.mutex);
+    // The zone was entered before the capture was started.
+    if (thread.stack.empty() || thread.stack.back().first != zoneId) {
+        return;
+    }
+    int64_t begin = thread.stack.back().second;
+    thread.stack.pop_back();
+    if (thread.events.size() >= MaximumEventsPerThread) {
+        thread.dropped++;
+        return;
+    }
+    thread.events.push_back({zoneId, static_cast<uint32_t>(thread.stack.size()), begin, end - begin});
+}
+
+void Profiler::markFrame() {
+    State& state = getState();
+    std::lock_guard<std::mutex> lock(state.mutex);
+    uint64_t frame = state.frameCounter++;
+    if (isCapturing()) {
+        state.frames.push_back({frame, now()});
+    }
+}
+
+size_t Profiler::getNumberOfEvents() {
+    State& state = getState();
+    std::lock_guard<std::mutex> lock(state.mutex);
+    size_t numberOfEvents = 0;
+    for (const auto& thread : state.threads) {
+        std::lock_guard<std::mutex> threadLock(thread->mutex);
+        numberOfEvents += thread->events.size();
+    }
+    return numberOfEvents;
+}
+
+bool Profiler::writeChromeTrace(const std::string& pathname) {
+    vfs_FILE *file = vfs_openWrite(pathname);
+    if (!file) {
+        Log::get() << Log::Entry::create(Log::Level::Warning, __FILE__, __LINE__, "unable to open profiler trace file ", "`", pathname, "`", Log::EndOfEntry);
+        return false;
+    }
+
+    State& state = getState();
+    std::lock_guard<std::mutex> lock(state.mutex);
+
+    // Timestamps and durations of the Chrome trace event format are in microseconds.
+    std::ostringstream os;
+    os << std::fixed << std::setprecision(3);
+    os << "{\"displayTimeUnit\":\"ms\",\"traceEvents\":[" << std::endl;
+    bool first = true;
+    auto separator = [&os, &first]() {
+        if (!first) {
+            os << "," << std::endl;
+        }
+        first = false;
+    };
+    size_t dropped = 0;
+    for (const auto& thread : state.threads) {
+        std::lock_guard<std::mutex> threadLock(thread->mutex);
+        separator();
+        os << "{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":1,\"tid\":" << thread->threadIndex
+           << ",\"args\":{\"name\":\"thread " << thread->threadIndex << "\"}}";
+        for (const auto& event : thread->events) {
+            separator();
+            os << "{\"name\":\"" << escape(state.zoneNames[event.zoneId]) << "\",\"cat\":\"egoboo\",\"ph\":\"X\""
+               << ",\"ts\":" << event.begin / 1000.0 << ",\"dur\":" << event.duration / 1000.0
+               << ",\"pid\":1,\"tid\":" << thread->threadIndex
+               << ",\"args\":{\"depth\":" << event.depth << "}}";
+        }
+        dropped += thread->dropped;
+    }
+    for (const auto& frame : state.frames) {
+        separator();
+        os << "{\"name\":\"frame " << frame.frame << "\",\"cat\":\"frame\",\"ph\":\"i\",\"s\":\"g\""
+           << ",\"ts\":" << frame.time / 1000.0 << ",\"pid\":1,\"tid\":0}";
+    }
+    os << std::endl << "]}" << std::endl;
+
+    const std::string buffer = os.str();
+    bool success = buffer.size() == vfs_write(buffer.c_str(), 1, buffer.size(), file);
+    vfs_close(file);
+
+    if (dropped > 0) {
+        Log::get() << Log::Entry::create(Log::Level::Warning, __FILE__, __LINE__, dropped, " profiler events were dropped", Log::EndOfEntry);
+    }
+    if (!success) {
+        Log::get() << Log::Entry::create(Log::Level::Warning, __FILE__, __LINE__, "unable to write profiler trace file ", "`", pathname, "`", Log::EndOfEntry);
+    }
+    return success;
+}
+
+} // namespace Time
+} // namespace Ego
@@ -0,0 +1,135 @@
+//********************************************************************************************
+//*
+//*    This file is part of Egoboo.
+//*
+//*    Egoboo is free software: you can redistribute it and/or modify it
+//*    under the terms of the GNU General Public License as published by
+//*    the Free Software Foundation, either version 3 of the License, or
+//*    (at your option) any later version.
+//*
+//*    Egoboo is distributed in the hope that it will be useful, but
+//*    WITHOUT ANY WARRANTY; without even the implied warranty of
+//*    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+//*    General Public License for more details.
+//*
+//*    You should have received a copy of the GNU General Public License
+//*    along with Egoboo.  If not, see <http://www.gnu.org/licenses/>.
+//*
+//********************************************************************************************
+
+/// @file   egolib/Time/Profiler.hpp
+/// @brief  A hierarchical zone profiler.
+#pragma once
+
+#include "egolib/typedef.h"
+
+namespace Ego {
+namespace Time {
+
+/**
+ * @brief
+ *  A hierarchical zone profiler.
+ * @remark
+ *  Every named clock (see Ego::Time::Clock) is a zone. While a capture is running,
+ *  each time a thread enters and leaves a clock, an event holding the thread, the
+ *  nesting depth, the point in time at which the zone was entered and the duration
+ *  spent in the zone is recorded. Frame markers are recorded by Profiler::markFrame.
+ *  A capture can be written to a file in the Chrome trace event format which can be
+ *  viewed in <tt>chrome://tracing</tt>.
+ * @remark
+ *  If no capture is running, the costs of entering and leaving a zone are a single
+ *  relaxed atomic load.
+ */
+class Profiler {
+public:
+    /// @brief The type of a zone ID.
+    using ZoneId = uint32_t;
+
+    /// @brief The zone ID of unnamed clocks. Such zones are not recorded.
+    static const ZoneId InvalidZoneId = std::numeric_limits<ZoneId>::max();
+
+    /// @brief The maximum number of events recorded per thread in a single capture.
+    static const size_t MaximumEventsPerThread = 1 << 20;
+
+    /**
+     * @brief
+     *  Get the zone ID for a zone name.
+     * @param name
+     *  the zone name
+     * @return
+     *  the zone ID. Profiler::InvalidZoneId if the name is empty.
+     */
+    static ZoneId getZoneId(const std::string& name);
+
+    /**
+     * @brief
+     *  Get if a capture is running.
+     */
+    static bool isCapturing() {
+        return _capturing.load(std::memory_order_relaxed);
+    }
+
+    /**
+     * @brief
+     *  Start a capture.
+     * @post
+     *  All events and frame markers of the previous capture were discarded.
+     */
+    static void startCapture();
+
+    /**
+     * @brief
+     *  Stop the capture.
+     * @post
+     *  The events and frame markers of the capture are retained until the next capture is started.
+     */
+    static void stopCapture();
+
+    /**
+     * @brief
+     *  Enter a zone on the calling thread.
+     * @param zoneId
+     *  the zone ID
+     */
+    static void enterZone(ZoneId zoneId);
+
+    /**
+     * @brief
+     *  Leave a zone on the calling thread.
+     * @param zoneId
+     *  the zone ID
+     * @remark
+     *  Leaving a zone which was entered before the capture was started is ignored.
+     */
+    static void leaveZone(ZoneId zoneId);
+
+    /**
+     * @brief
+     *  Mark the beginning of a new frame.
+     */
+    static void markFrame();
+
+    /**
+     * @brief
+     *  Get the number of events recorded by the current or last capture.
+     */
+    static size_t getNumberOfEvents();
+
+    /**
+     * @brief
+     *  Write the events and frame markers of the current or last capture in the Chrome trace event format.
+     * @param pathname
+     *  the virtual pathname of the file to write to
+     * @return
+     *  @a true on success, @a false on failure
+     */
+    static bool writeChromeTrace(const std::string& pathname);
+
+private:
+    /// @brief If a capture is running.
+    static std::atomic<bool> _capturing;
+
+}; // class Profiler
+
+} // namespace Time
+} // namespace Ego
@@ -105,6 +105,7 @@ egoboo_config_t::egoboo_config_t() :
         { "Normal", Ego::GameDifficulty::Normal },
         { "Hard", Ego::GameDifficulty::Hard },
     }),
+    game_concurrentScripts_enable(false, "game.concurrentScripts.enable", "enable/disable running A.I. scripts concurrently"),
     // Camera configuration section.
     camera_control(CameraTurnMode::Auto, "camera.control", "type of camera control",
     {
@@ -192,6 +193,7 @@ egoboo_config_t& egoboo_config_t::operator=(const egoboo_config_t& other)
 
     // Game configuration section.
     game_difficulty = other.game_difficulty;
+    game_concurrentScripts_enable = other.game_concurrentScripts_enable;
     
     // HUD configuration section.
     hud_displayGameTime = other.hud_displayGameTime;
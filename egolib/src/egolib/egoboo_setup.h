@@ -216,6 +216,7 @@ public:
             network_playerName,
             //
             game_difficulty,
+            game_concurrentScripts_enable,
             //
             camera_control,
             //
@@ -617,6 +618,14 @@ public:
      */
     EnumerationVariable<Ego::GameDifficulty> game_difficulty;
 
+    /**
+     * @brief
+     *  Enable/disable running A.I. scripts concurrently.
+     * @remark
+     *  Default value is @a false.
+     */
+    StandardVariable<bool> game_concurrentScripts_enable;
+
     // HUD configuration section.
 
     /**
@@ -32,10 +32,17 @@
 #include "egolib/Core/System.hpp"
 #include "egolib/Core/Singleton.hpp"
 #include "egolib/Core/QuadTree.hpp"
+#include "egolib/Core/LooseGrid.hpp"
+#include "egolib/Core/SpatialHash.hpp"
+#include "egolib/Core/SweepAndPrune.hpp"
+#include "egolib/Core/JobSystem.hpp"
+#include "egolib/Core/CommandBuffer.hpp"
+#include "egolib/Core/TimerWheel.hpp"
 
 //--------------------------------------------------------------------------------------------
 
 #include "egolib/Logic/Attribute.hpp"
+#include "egolib/Logic/AttributeSet.hpp"
 #include "egolib/Logic/PerkHandler.hpp"
 #include "egolib/Logic/ObjectSlot.hpp"
 
@@ -84,6 +91,8 @@
 //--------------------------------------------------------------------------------------------
 
 #include "egolib/AI/AStar.hpp"
+#include "egolib/AI/FlowField.hpp"
+#include "egolib/AI/HierarchicalAStar.hpp"
 #include "egolib/AI/LineOfSight.hpp"
 
 //--------------------------------------------------------------------------------------------
@@ -91,6 +100,7 @@
 #include "egolib/Time/LocalTime.hpp"
 #include "egolib/Time/SlidingWindow.hpp"
 #include "egolib/Time/Stopwatch.hpp"
+#include "egolib/Time/Profiler.hpp"
 
 //--------------------------------------------------------------------------------------------
 
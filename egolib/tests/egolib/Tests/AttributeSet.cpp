@@ -0,0 +1,185 @@
+//********************************************************************************************
+//*
+//*    This file is part of Egoboo.
+//*
+//*    Egoboo is free software: you can redistribute it and/or modify it
+//*    under the terms of the GNU General Public License as published by
+//*    the Free Software Foundation, either version 3 of the License, or
+//*    (at your option) any later version.
+//*
+//*    Egoboo is distributed in the hope that it will be useful, but
+//*    WITHOUT ANY WARRANTY; without even the implied warranty of
+//*    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+//*    General Public License for more details.
+//*
+//*    You should have received a copy of the GNU General Public License
+//*    along with Egoboo.  If not, see <http://www.gnu.org/licenses/>.
+//*
+//********************************************************************************************
+
+#include "EgoTest/EgoTest.hpp"
+#include "egolib/egolib.h"
+
+namespace Ego {
+namespace Test {
+
+using Ego::Attribute::AttributeType;
+
+/// The inputs of an attribute set, tracked next to it.
+struct AttributeInputs {
+    std::array<float, Ego::Attribute::NR_OF_ATTRIBUTES> base;
+    std::map<AttributeType, float> temp;
+    std::bitset<Ego::Perks::NR_OF_PERKS> perks;
+
+    AttributeInputs() : base(), temp(), perks() {
+        base.fill(0.0f);
+    }
+};
+
+/// Compare the cached values of an attribute set with a fresh computation from the same set and with
+/// the values of a new attribute set built from the inputs.
+static bool isResolved(const Ego::AttributeSet& attributes, const AttributeInputs& inputs) {
+    Ego::AttributeSet fresh;
+    for (size_t i = 0; i < Ego::Attribute::NR_OF_ATTRIBUTES; ++i) {
+        if (i == Ego::Attribute::NR_OF_PRIMARY_ATTRIBUTES) continue;
+        fresh.setBase(static_cast<AttributeType>(i), inputs.base[i]);
+    }
+    for (const auto& temp : inputs.temp) {
+        fresh.setTemp(temp.first, temp.second);
+    }
+    fresh.setPerks(inputs.perks);
+    for (size_t i = 0; i < Ego::Attribute::NR_OF_ATTRIBUTES; ++i) {
+        const AttributeType type = static_cast<AttributeType>(i);
+        if (type == Ego::Attribute::NR_OF_PRIMARY_ATTRIBUTES) continue;
+        if (attributes.get(type) != attributes.compute(type)) return false;
+        if (attributes.get(type) != fresh.get(type)) return false;
+        if (attributes.hasTemp(type) != (inputs.temp.count(type) != 0)) return false;
+    }
+    return true;
+}
+
+EgoTest_TestCase(AttributeSet) {
+
+EgoTest_Test(jumpPower) {
+    Ego::AttributeSet attributes;
+    attributes.setBase(Ego::Attribute::JUMP_POWER, 10.0f);
+    attributes.setBase(Ego::Attribute::MIGHT, 50.0f);
+    EgoTest_Assert(attributes.get(Ego::Attribute::JUMP_POWER) == 10.0f * 1.5f);
+
+    // Perk.
+    std::bitset<Ego::Perks::NR_OF_PERKS> perks;
+    perks[Ego::Perks::ATHLETICS] = true;
+    attributes.setPerks(perks);
+    EgoTest_Assert(attributes.get(Ego::Attribute::JUMP_POWER) == 10.0f * 1.25f * 1.5f);
+
+    // Enchantment on an attribute the jump power depends on.
+    attributes.increaseTemp(Ego::Attribute::MIGHT, 50.0f);
+    EgoTest_Assert(attributes.get(Ego::Attribute::JUMP_POWER) == 10.0f * 1.25f * 2.0f);
+    attributes.setTemp(Ego::Attribute::FLY_TO_HEIGHT, 20.0f);
+    EgoTest_Assert(attributes.get(Ego::Attribute::JUMP_POWER) == Ego::AttributeSet::JUMPINFINITE);
+    attributes.removeTemp(Ego::Attribute::FLY_TO_HEIGHT);
+    EgoTest_Assert(attributes.get(Ego::Attribute::JUMP_POWER) == 10.0f * 1.25f * 2.0f);
+}
+
+EgoTest_Test(overrideSet) {
+    Ego::AttributeSet attributes;
+    attributes.setBase(Ego::Attribute::SEE_INVISIBLE, 1.0f);
+    attributes.setTemp(Ego::Attribute::SEE_INVISIBLE, 0.0f);
+    EgoTest_Assert(attributes.get(Ego::Attribute::SEE_INVISIBLE) == 0.0f);
+    attributes.removeTemp(Ego::Attribute::SEE_INVISIBLE);
+    EgoTest_Assert(attributes.get(Ego::Attribute::SEE_INVISIBLE) == 1.0f);
+
+    // Lower bounds.
+    attributes.increaseTemp(Ego::Attribute::MIGHT, -10.0f);
+    EgoTest_Assert(attributes.get(Ego::Attribute::MIGHT) == 1.0f);
+    attributes.increaseTemp(Ego::Attribute::ACCELERATION, -10.0f);
+    EgoTest_Assert(attributes.get(Ego::Attribute::ACCELERATION) == 0.0f);
+}
+
+EgoTest_Test(randomChanges) {
+    // Enchantments are applied and removed, Perks are learned, levels gained and temporary values written
+    // in random order: the cached values must always match a fresh computation.
+    std::mt19937 random(4711);
+    Ego::AttributeSet attributes;
+    AttributeInputs inputs;
+    std::vector<std::pair<AttributeType, float>> enchantments;
+    auto randomType = [&random]() {
+        AttributeType type;
+        do {
+            type = static_cast<AttributeType>(random() % Ego::Attribute::NR_OF_ATTRIBUTES);
+        } while (type == Ego::Attribute::NR_OF_PRIMARY_ATTRIBUTES);
+        return type;
+    };
+    auto randomValue = [&random]() {
+        return static_cast<float>(static_cast<int>(random() % 41) - 20) * 0.5f;
+    };
+    for (size_t i = 0; i < 2000; ++i) {
+        switch (random() % 5) {
+            case 0: {
+                // Apply an enchantment.
+                const AttributeType type = randomType();
+                const float value = randomValue();
+                if (Ego::Attribute::isOverrideSetAttribute(type)) {
+                    attributes.setTemp(type, value);
+                    inputs.temp[type] = value;
+                } else {
+                    attributes.increaseTemp(type, value);
+                    inputs.temp[type] += value;
+                }
+                enchantments.emplace_back(type, value);
+            }
+            break;
+            case 1: {
+                // Remove an enchantment.
+                if (enchantments.empty()) break;
+                const size_t index = random() % enchantments.size();
+                const std::pair<AttributeType, float> enchantment = enchantments[index];
+                enchantments.erase(enchantments.begin() + index);
+                if (Ego::Attribute::isOverrideSetAttribute(enchantment.first)) {
+                    attributes.removeTemp(enchantment.first);
+                    inputs.temp.erase(enchantment.first);
+                } else {
+                    attributes.increaseTemp(enchantment.first, -enchantment.second);
+                    inputs.temp[enchantment.first] -= enchantment.second;
+                }
+            }
+            break;
+            case 2: {
+                // Learn or lose (polymorph) a Perk.
+                const size_t perk = random() % Ego::Perks::NR_OF_PERKS;
+                inputs.perks[perk] = !inputs.perks[perk];
+                attributes.setPerks(inputs.perks);
+            }
+            break;
+            case 3: {
+                // Gain a level.
+                for (size_t j = 0; j < Ego::Attribute::NR_OF_PRIMARY_ATTRIBUTES; ++j) {
+                    const AttributeType type = static_cast<AttributeType>(j);
+                    const float value = attributes.getBase(type) + static_cast<float>(random() % 3);
+                    attributes.setBase(type, value);
+                    inputs.base[j] = value;
+                }
+            }
+            break;
+            case 4: {
+                // Write a base value (skin, profile) or a temporary value.
+                const AttributeType type = randomType();
+                const float value = randomValue();
+                if (random() % 2) {
+                    attributes.setBase(type, value);
+                    inputs.base[type] = value;
+                } else {
+                    attributes.setTemp(type, value);
+                    inputs.temp[type] = value;
+                }
+            }
+            break;
+        }
+        EgoTest_Assert(isResolved(attributes, inputs));
+    }
+}
+
+};
+
+} // namespace Test
+} // namespace Ego
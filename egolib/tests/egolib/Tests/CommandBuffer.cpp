@@ -0,0 +1,60 @@
+//********************************************************************************************
+//*
+//*    This file is part of Egoboo.
+//*
+//*    Egoboo is free software: you can redistribute it and/or modify it
+//*    under the terms of the GNU General Public License as published by
+//*    the Free Software Foundation, either version 3 of the License, or
+//*    (at your option) any later version.
+//*
+//*    Egoboo is distributed in the hope that it will be useful, but
+//*    WITHOUT ANY WARRANTY; without even the implied warranty of
+//*    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+//*    General Public License for more details.
+//*
+//*    You should have received a copy of the GNU General Public License
+//*    along with Egoboo.  If not, see <http://www.gnu.org/licenses/>.
+//*
+//********************************************************************************************
+
+#include "EgoTest/EgoTest.hpp"
+#include "egolib/egolib.h"
+
+namespace Ego {
+namespace Core {
+namespace Test {
+
+EgoTest_TestCase(CommandBuffer) {
+
+EgoTest_Test(order) {
+    Ego::Core::JobSystem::initialize(size_t(3));
+    Ego::Core::CommandBuffer commands;
+    std::vector<size_t> executed;
+    commands.open();
+    Ego::Core::parallel_for(0, 1000, 16, [&commands, &executed](size_t begin, size_t end) {
+        for (size_t i = begin; i < end; ++i) {
+            commands.record(i, [&executed, i]() { executed.push_back(2 * i); });
+            commands.record(i, [&executed, i]() { executed.push_back(2 * i + 1); });
+        }
+    });
+    commands.close();
+    for (size_t i = 0; i < 1000; ++i) {
+        if (i % 2) {
+            commands.discard(i + 1);
+        } else {
+            commands.execute(i + 1);
+        }
+    }
+    EgoTest_Assert(commands.empty());
+    EgoTest_Assert(executed.size() == 1000);
+    for (size_t i = 0; i < executed.size(); ++i) {
+        EgoTest_Assert(executed[i] == (i / 2) * 4 + i % 2);
+    }
+    Ego::Core::JobSystem::uninitialize();
+}
+
+};
+
+} // namespace Test
+} // namespace Core
+} // namespace Ego
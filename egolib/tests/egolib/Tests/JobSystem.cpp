@@ -0,0 +1,87 @@
+//********************************************************************************************
+//*
+//*    This file is part of Egoboo.
+//*
+//*    Egoboo is free software: you can redistribute it and/or modify it
+//*    under the terms of the GNU General Public License as published by
+//*    the Free Software Foundation, either version 3 of the License, or
+//*    (at your option) any later version.
+//*
+//*    Egoboo is distributed in the hope that it will be useful, but
+//*    WITHOUT ANY WARRANTY; without even the implied warranty of
+//*    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+//*    General Public License for more details.
+//*
+//*    You should have received a copy of the GNU General Public License
+//*    along with Egoboo.  If not, see <http://www.gnu.org/licenses/>.
+//*
+//********************************************************************************************
+
+#include "EgoTest/EgoTest.hpp"
+#include "egolib/egolib.h"
+
+namespace Ego {
+namespace Core {
+namespace Test {
+
+EgoTest_TestCase(JobSystem) {
+
+EgoTest_Test(parallel_for) {
+    Ego::Core::JobSystem::initialize(size_t(3));
+    std::vector<int> values(10000, 0);
+    Ego::Core::parallel_for(0, values.size(), 64, [&values](size_t begin, size_t end) {
+        for (size_t i = begin; i < end; ++i) {
+            values[i]++;
+        }
+    });
+    for (int value : values) {
+        EgoTest_Assert(value == 1);
+    }
+    Ego::Core::JobSystem::uninitialize();
+}
+
+EgoTest_Test(nestedTaskGroups) {
+    Ego::Core::JobSystem::initialize(size_t(3));
+    std::atomic<size_t> sum(0);
+    Ego::Core::TaskGroup outer;
+    for (size_t i = 0; i < 16; ++i) {
+        outer.run([&sum]() {
+            Ego::Core::parallel_for(0, 100, 8, [&sum](size_t begin, size_t end) {
+                sum += end - begin;
+            });
+        });
+    }
+    outer.wait();
+    EgoTest_Assert(sum == 1600);
+    Ego::Core::JobSystem::uninitialize();
+}
+
+EgoTest_Test(exception) {
+    Ego::Core::JobSystem::initialize(size_t(3));
+    bool thrown = false;
+    try {
+        Ego::Core::parallel_for(0, 1000, 10, [](size_t begin, size_t end) {
+            if (begin <= 500 && 500 < end) {
+                throw std::runtime_error("task failed");
+            }
+        });
+    } catch (const std::runtime_error&) {
+        thrown = true;
+    }
+    EgoTest_Assert(thrown);
+    Ego::Core::JobSystem::uninitialize();
+}
+
+EgoTest_Test(uninitialized) {
+    size_t count = 0;
+    Ego::Core::parallel_for(0, 1000, 10, [&count](size_t begin, size_t end) {
+        count += end - begin;
+    });
+    EgoTest_Assert(count == 1000);
+}
+
+};
+
+} // namespace Test
+} // namespace Core
+} // namespace Ego
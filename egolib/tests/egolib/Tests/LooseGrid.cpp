@@ -0,0 +1,146 @@
+//********************************************************************************************
+//*
+//*    This file is part of Egoboo.
+//*
+//*    Egoboo is free software: you can redistribute it and/or modify it
+//*    under the terms of the GNU General Public License as published by
+//*    the Free Software Foundation, either version 3 of the License, or
+//*    (at your option) any later version.
+//*
+//*    Egoboo is distributed in the hope that it will be useful, but
+//*    WITHOUT ANY WARRANTY; without even the implied warranty of
+//*    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+//*    General Public License for more details.
+//*
+//*    You should have received a copy of the GNU General Public License
+//*    along with Egoboo.  If not, see <http://www.gnu.org/licenses/>.
+//*
+//********************************************************************************************
+
+#include "EgoTest/EgoTest.hpp"
+#include "egolib/egolib.h"
+
+namespace Ego {
+namespace Test {
+
+EgoTest_TestCase(LooseGrid) {
+    class LooseGridElement {
+    public:
+        LooseGridElement(float x, float y, float size) : _bounds(Point2f(x - size, y - size), Point2f(x + size, y + size)) {
+            //ctor
+        }
+
+        AxisAlignedBox2f& getAxisAlignedBox2D() { return _bounds; }
+
+    private:
+        AxisAlignedBox2f _bounds;
+    };
+
+    static AxisAlignedBox2f anAABFromARect(float centerX, float centerY, float size) {
+        return AxisAlignedBox2f(Point2f(centerX - size, centerY - size), Point2f(centerX + size, centerY + size));
+    }
+
+    EgoTest_Test(findElements) {
+        Ego::LooseGrid<LooseGridElement> grid(64);
+        std::vector<std::shared_ptr<LooseGridElement>> elements;
+
+        //Put a fat element in the middle spanning several cells
+        elements.push_back(std::make_shared<LooseGridElement>(128, 128, 40));
+
+        //Put one element in each corner
+        elements.push_back(std::make_shared<LooseGridElement>(0, 0, 5));
+        elements.push_back(std::make_shared<LooseGridElement>(256, 0, 5));
+        elements.push_back(std::make_shared<LooseGridElement>(0, 256, 5));
+        elements.push_back(std::make_shared<LooseGridElement>(256, 256, 5));
+
+        grid.reset(0, 0, 256, 256);
+        for (size_t i = 0; i < elements.size(); ++i) {
+            EgoTest_Assert(grid.update(i, elements[i]));
+        }
+
+        std::vector<std::shared_ptr<LooseGridElement>> result;
+
+        //Searching outside the grid should produce no results
+        grid.find(anAABFromARect(-50, -50, 20), result);
+        EgoTest_Assert(result.empty());
+
+        //Searching around each corner should find one element
+        grid.find(anAABFromARect(0, 0, 50), result);
+        EgoTest_Assert(result.size() == 1);
+        result.clear();
+
+        grid.find(anAABFromARect(256, 256, 50), result);
+        EgoTest_Assert(result.size() == 1);
+        result.clear();
+
+        //The fat element is found from a neighbouring cell
+        grid.find(anAABFromARect(95, 128, 5), result);
+        EgoTest_Assert(result.size() == 1 && result[0] == elements[0]);
+        result.clear();
+
+        //Searching the whole grid finds every element exactly once
+        grid.find(anAABFromARect(128, 128, 128), result);
+        EgoTest_Assert(result.size() == elements.size());
+        result.clear();
+
+        //Only scan elements that satisfy the predicate
+        grid.find(anAABFromARect(128, 128, 128), result, [&elements](const std::shared_ptr<LooseGridElement>& element) { return element != elements[0]; });
+        EgoTest_Assert(result.size() == elements.size() - 1);
+
+        //Visiting yields the same elements as finding
+        size_t visited = 0;
+        grid.visit(anAABFromARect(128, 128, 128), [&visited](LooseGridElement&) { ++visited; });
+        EgoTest_Assert(visited == elements.size());
+    }
+
+    EgoTest_Test(moveElements) {
+        Ego::LooseGrid<LooseGridElement> grid(64);
+        auto element = std::make_shared<LooseGridElement>(10, 10, 5);
+
+        grid.reset(0, 0, 256, 256);
+        EgoTest_Assert(grid.update(0, element));
+
+        //Moving within the same cell does not change the grid
+        element->getAxisAlignedBox2D() = anAABFromARect(20, 20, 5);
+        EgoTest_Assert(!grid.update(0, element));
+
+        //Moving to another cell does
+        element->getAxisAlignedBox2D() = anAABFromARect(200, 200, 5);
+        EgoTest_Assert(grid.update(0, element));
+
+        std::vector<std::shared_ptr<LooseGridElement>> result;
+        grid.find(anAABFromARect(20, 20, 10), result);
+        EgoTest_Assert(result.empty());
+        grid.find(anAABFromARect(200, 200, 10), result);
+        EgoTest_Assert(result.size() == 1);
+        result.clear();
+
+        //Removed elements are not found anymore
+        grid.remove(0, element.get());
+        grid.find(anAABFromARect(200, 200, 10), result);
+        EgoTest_Assert(result.empty());
+    }
+
+    EgoTest_Test(reuseKey) {
+        Ego::LooseGrid<LooseGridElement> grid(64);
+        auto first = std::make_shared<LooseGridElement>(10, 10, 5);
+        auto second = std::make_shared<LooseGridElement>(10, 10, 5);
+
+        grid.reset(0, 0, 256, 256);
+        grid.update(0, first);
+
+        //A different element with the same key replaces the old one
+        EgoTest_Assert(grid.update(0, second));
+
+        //Removing the old element must not remove the new one
+        grid.remove(0, first.get());
+
+        std::vector<std::shared_ptr<LooseGridElement>> result;
+        grid.find(anAABFromARect(10, 10, 10), result);
+        EgoTest_Assert(result.size() == 1 && result[0] == second);
+    }
+
+};
+
+} // namespace Test
+} // namespace Ego
@@ -121,6 +121,47 @@ EgoTest_TestCase(QuadTree) {
         EgoTest_Assert(result.empty());
     }
 
+    EgoTest_Test(runQuadTreeTestVisit) {
+        Ego::QuadTree<QuadTreeElement> _quadTree;
+        std::vector<std::shared_ptr<QuadTreeElement>> _testElements;
+
+        //Fill the tree with enough elements to subdivide it several times
+        _quadTree.clear(0, 0, 256, 256);
+        for (int i = 0; i < 64; ++i) {
+            _testElements.push_back(std::make_shared<QuadTreeElement>(Random::next(0, 256), Random::next(0, 256), 5));
+        }
+
+        //A fat element is stored in many nodes
+        _testElements.push_back(std::make_shared<QuadTreeElement>(128, 128, 100));
+        for (const std::shared_ptr<QuadTreeElement> &element : _testElements) {
+            _quadTree.insert(element);
+        }
+
+        //Every element is visited exactly once, also on repeated queries
+        for (int i = 0; i < 2; ++i) {
+            std::vector<QuadTreeElement*> visited;
+            _quadTree.visit(anAABFromARect(128, 128, 128), [&visited](QuadTreeElement &element) { visited.push_back(&element); });
+            EgoTest_Assert(visited.size() == _testElements.size());
+            std::sort(visited.begin(), visited.end());
+            EgoTest_Assert(std::unique(visited.begin(), visited.end()) == visited.end());
+        }
+
+        //find() does not report duplicates either
+        std::vector<std::shared_ptr<QuadTreeElement>> result;
+        _quadTree.find(anAABFromARect(128, 128, 128), result);
+        EgoTest_Assert(result.size() == _testElements.size());
+
+        //Queries do not modify the tree, a visitor may query it again
+        size_t outer = 0;
+        _quadTree.visit(anAABFromARect(128, 128, 128), [&_quadTree, &outer](QuadTreeElement &element) {
+            size_t inner = 0;
+            _quadTree.visit(element.getAxisAlignedBox2D(), [&inner](QuadTreeElement&) { inner++; });
+            EgoTest_Assert(inner >= 1);
+            outer++;
+        });
+        EgoTest_Assert(outer == _testElements.size());
+    }
+
 };
 
 } // namespace Test
@@ -0,0 +1,74 @@
+//********************************************************************************************
+//*
+//*    This file is part of Egoboo.
+//*
+//*    Egoboo is free software: you can redistribute it and/or modify it
+//*    under the terms of the GNU General Public License as published by
+//*    the Free Software Foundation, either version 3 of the License, or
+//*    (at your option) any later version.
+//*
+//*    Egoboo is distributed in the hope that it will be useful, but
+//*    WITHOUT ANY WARRANTY; without even the implied warranty of
+//*    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+//*    General Public License for more details.
+//*
+//*    You should have received a copy of the GNU General Public License
+//*    along with Egoboo.  If not, see <http://www.gnu.org/licenses/>.
+//*
+//********************************************************************************************
+
+#include "EgoTest/EgoTest.hpp"
+#include "egolib/egolib.h"
+#include "egolib/Renderer/Null/Renderer.hpp"
+
+namespace Ego {
+namespace Test {
+
+EgoTest_TestCase(NullRenderer) {
+
+EgoTest_Test(statistics) {
+    Ego::Core::CreateFunctor<Ego::Renderer>::backend = Ego::RendererBackend::Null;
+    Ego::Renderer::initialize();
+    auto& renderer = static_cast<Ego::Null::Renderer&>(Ego::Renderer::get());
+
+    Ego::VertexBuffer vertexBuffer(6, Ego::VertexFormatFactory::get<Ego::VertexFormat::P3F>());
+    auto texture = renderer.createTexture();
+
+    renderer.setBlendingEnabled(true);
+    renderer.setBlendingEnabled(true);
+    renderer.getTextureUnit().setActivated(texture.get());
+    renderer.render(vertexBuffer, Ego::PrimitiveType::Triangles, 0, 6);
+    renderer.render(vertexBuffer, Ego::PrimitiveType::Triangles, 3, 3);
+    renderer.getTextureUnit().setActivated(nullptr);
+
+    const auto& frame = renderer.getFrameStatistics();
+    EgoTest_Assert(frame.drawCalls == 2);
+    EgoTest_Assert(frame.vertices == 9);
+    EgoTest_Assert(frame.textureBinds == 1);
+    EgoTest_Assert(frame.stateChanges == 4);
+    EgoTest_Assert(frame.redundantStateChanges == 1);
+    EgoTest_Assert(frame.texturesCreated == 1);
+
+    renderer.nextFrame();
+    EgoTest_Assert(renderer.getFrameStatistics().drawCalls == 0);
+    EgoTest_Assert(renderer.getLastFrameStatistics().drawCalls == 2);
+    EgoTest_Assert(renderer.getTotalStatistics().vertices == 9);
+    EgoTest_Assert(renderer.getNumberOfFrames() == 1);
+
+    bool thrown = false;
+    try {
+        renderer.render(vertexBuffer, Ego::PrimitiveType::Triangles, 3, 6);
+    } catch (const std::invalid_argument&) {
+        thrown = true;
+    }
+    EgoTest_Assert(thrown);
+
+    texture = nullptr;
+    Ego::Renderer::uninitialize();
+    Ego::Core::CreateFunctor<Ego::Renderer>::backend = Ego::RendererBackend::OpenGL;
+}
+
+};
+
+} // namespace Test
+} // namespace Ego
@@ -0,0 +1,92 @@
+//********************************************************************************************
+//*
+//*    This file is part of Egoboo.
+//*
+//*    Egoboo is free software: you can redistribute it and/or modify it
+//*    under the terms of the GNU General Public License as published by
+//*    the Free Software Foundation, either version 3 of the License, or
+//*    (at your option) any later version.
+//*
+//*    Egoboo is distributed in the hope that it will be useful, but
+//*    WITHOUT ANY WARRANTY; without even the implied warranty of
+//*    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+//*    General Public License for more details.
+//*
+//*    You should have received a copy of the GNU General Public License
+//*    along with Egoboo.  If not, see <http://www.gnu.org/licenses/>.
+//*
+//********************************************************************************************
+
+#include "EgoTest/EgoTest.hpp"
+#include "egolib/egolib.h"
+
+namespace Ego {
+namespace Test {
+
+EgoTest_TestCase(SpatialHash) {
+    struct SpatialHashElement {
+        float x, y;
+    };
+
+    static size_t countVisited(const Ego::SpatialHash<SpatialHashElement> &hash, const AxisAlignedBox2f &searchArea) {
+        size_t count = 0;
+        hash.visit(searchArea, [&count](SpatialHashElement&) { ++count; });
+        return count;
+    }
+
+    EgoTest_Test(visitMatchesBruteForce) {
+        Ego::SpatialHash<SpatialHashElement> hash(64);
+        std::vector<SpatialHashElement> elements;
+
+        //Some elements are outside of the bounds and stored in the border cells
+        for (int i = 0; i < 500; ++i) {
+            elements.push_back(SpatialHashElement{static_cast<float>(Random::next(-32, 288)), static_cast<float>(Random::next(-32, 288))});
+        }
+
+        //Rebuild a few times with moving elements
+        for (int frame = 0; frame < 3; ++frame) {
+            hash.clear(0, 0, 256, 256);
+            for (SpatialHashElement &element : elements) {
+                hash.insert(&element, element.x, element.y);
+            }
+            hash.build();
+            EgoTest_Assert(hash.size() == elements.size());
+
+            for (int i = 0; i < 50; ++i) {
+                const float minX = Random::next(-64, 256), minY = Random::next(-64, 256);
+                const AxisAlignedBox2f searchArea(Point2f(minX, minY), Point2f(minX + Random::next(0, 128), minY + Random::next(0, 128)));
+
+                size_t expected = 0;
+                for (const SpatialHashElement &element : elements) {
+                    if (element.x >= searchArea.getMin()[kX] && element.x <= searchArea.getMax()[kX] &&
+                        element.y >= searchArea.getMin()[kY] && element.y <= searchArea.getMax()[kY]) {
+                        ++expected;
+                    }
+                }
+                EgoTest_Assert(countVisited(hash, searchArea) == expected);
+            }
+
+            for (SpatialHashElement &element : elements) {
+                element.x += Random::next(-16, 16);
+            }
+        }
+    }
+
+    EgoTest_Test(clearRemovesElements) {
+        Ego::SpatialHash<SpatialHashElement> hash(64);
+        SpatialHashElement element{10, 10};
+
+        hash.clear(0, 0, 256, 256);
+        hash.insert(&element, element.x, element.y);
+        hash.build();
+        EgoTest_Assert(countVisited(hash, AxisAlignedBox2f(Point2f(0, 0), Point2f(20, 20))) == 1);
+
+        hash.clear(0, 0, 256, 256);
+        hash.build();
+        EgoTest_Assert(countVisited(hash, AxisAlignedBox2f(Point2f(0, 0), Point2f(20, 20))) == 0);
+    }
+
+};
+
+} // namespace Test
+} // namespace Ego
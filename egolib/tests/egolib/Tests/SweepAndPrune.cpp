@@ -0,0 +1,157 @@
+//********************************************************************************************
+//*
+//*    This file is part of Egoboo.
+//*
+//*    Egoboo is free software: you can redistribute it and/or modify it
+//*    under the terms of the GNU General Public License as published by
+//*    the Free Software Foundation, either version 3 of the License, or
+//*    (at your option) any later version.
+//*
+//*    Egoboo is distributed in the hope that it will be useful, but
+//*    WITHOUT ANY WARRANTY; without even the implied warranty of
+//*    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+//*    General Public License for more details.
+//*
+//*    You should have received a copy of the GNU General Public License
+//*    along with Egoboo.  If not, see <http://www.gnu.org/licenses/>.
+//*
+//********************************************************************************************
+
+#include "EgoTest/EgoTest.hpp"
+#include "egolib/egolib.h"
+
+namespace Ego {
+namespace Test {
+
+EgoTest_TestCase(SweepAndPrune) {
+    struct SweepAndPruneElement {
+        size_t id;
+        float minX, minY, maxX, maxY;
+        bool alive;
+    };
+
+    static void randomize(SweepAndPruneElement &element) {
+        element.minX = Random::next(0, 480);
+        element.minY = Random::next(0, 480);
+        element.maxX = element.minX + Random::next(0, 32);
+        element.maxY = element.minY + Random::next(0, 32);
+    }
+
+    static bool overlaps(const SweepAndPruneElement &a, const SweepAndPruneElement &b) {
+        return a.minX <= b.maxX && b.minX <= a.maxX && a.minY <= b.maxY && b.minY <= a.maxY;
+    }
+
+    static void submit(Ego::SweepAndPrune<SweepAndPruneElement> &broadphase, std::vector<SweepAndPruneElement> &elements) {
+        broadphase.begin();
+        for (SweepAndPruneElement &element : elements) {
+            if (element.alive) {
+                broadphase.update(element.id, &element, AxisAlignedBox2f(Point2f(element.minX, element.minY), Point2f(element.maxX, element.maxY)));
+            }
+        }
+        broadphase.end();
+    }
+
+    //Pairs are grouped by their first element, the order of the second elements is not specified
+    static bool matches(std::vector<std::pair<size_t, size_t>> found, const std::vector<std::pair<size_t, size_t>> &expected) {
+        for (size_t i = 1; i < found.size(); ++i) {
+            if (found[i].first < found[i - 1].first) {
+                return false;
+            }
+        }
+        std::sort(found.begin(), found.end());
+        return found == expected;
+    }
+
+    static std::vector<SweepAndPruneElement> createElements(size_t count) {
+        std::vector<SweepAndPruneElement> elements;
+        for (size_t i = 0; i < count; ++i) {
+            SweepAndPruneElement element;
+            element.id = i;
+            element.alive = true;
+            randomize(element);
+            elements.push_back(element);
+        }
+        return elements;
+    }
+
+    EgoTest_Test(selfPairsMatchBruteForce) {
+        Ego::SweepAndPrune<SweepAndPruneElement> broadphase;
+        std::vector<SweepAndPruneElement> elements = createElements(300);
+
+        //Move, remove and re-add elements between updates to exercise the incremental sort and the kept pairs
+        for (int frame = 0; frame < 20; ++frame) {
+            submit(broadphase, elements);
+
+            std::vector<std::pair<size_t, size_t>> expected, found;
+            for (size_t i = 0; i < elements.size(); ++i) {
+                for (size_t j = i + 1; j < elements.size(); ++j) {
+                    if (elements[i].alive && elements[j].alive && overlaps(elements[i], elements[j])) {
+                        expected.emplace_back(i, j);
+                    }
+                }
+            }
+            broadphase.findPairs([&found](SweepAndPruneElement &a, SweepAndPruneElement &b) { found.emplace_back(a.id, b.id); });
+            EgoTest_Assert(matches(found, expected));
+
+            for (SweepAndPruneElement &element : elements) {
+                const float offsetX = Random::next(-8, 8), offsetY = Random::next(-8, 8);
+                element.minX += offsetX;
+                element.maxX += offsetX;
+                element.minY += offsetY;
+                element.maxY += offsetY;
+                if (Random::next(0, 10) == 0) {
+                    element.alive = !element.alive;
+                    randomize(element);
+                }
+            }
+        }
+    }
+
+    EgoTest_Test(bipartitePairsMatchBruteForce) {
+        Ego::SweepAndPrune<SweepAndPruneElement> first, second;
+        std::vector<SweepAndPruneElement> firstElements = createElements(200), secondElements = createElements(100);
+
+        for (int frame = 0; frame < 5; ++frame) {
+            submit(first, firstElements);
+            submit(second, secondElements);
+
+            std::vector<std::pair<size_t, size_t>> expected, found;
+            for (const SweepAndPruneElement &a : firstElements) {
+                for (const SweepAndPruneElement &b : secondElements) {
+                    if (overlaps(a, b)) {
+                        expected.emplace_back(a.id, b.id);
+                    }
+                }
+            }
+            first.findPairs(second, [&found](SweepAndPruneElement &a, SweepAndPruneElement &b) { found.emplace_back(a.id, b.id); });
+            EgoTest_Assert(matches(found, expected));
+
+            for (SweepAndPruneElement &element : secondElements) {
+                randomize(element);
+            }
+        }
+    }
+
+    EgoTest_Test(clearRemovesElements) {
+        Ego::SweepAndPrune<SweepAndPruneElement> broadphase;
+        std::vector<SweepAndPruneElement> elements = createElements(2);
+        elements[1] = elements[0];
+        elements[1].id = 1;
+        submit(broadphase, elements);
+
+        size_t count = 0;
+        broadphase.findPairs([&count](SweepAndPruneElement&, SweepAndPruneElement&) { ++count; });
+        EgoTest_Assert(count == 1);
+
+        broadphase.clear();
+        broadphase.begin();
+        broadphase.end();
+        count = 0;
+        broadphase.findPairs([&count](SweepAndPruneElement&, SweepAndPruneElement&) { ++count; });
+        EgoTest_Assert(count == 0);
+    }
+
+};
+
+} // namespace Test
+} // namespace Ego
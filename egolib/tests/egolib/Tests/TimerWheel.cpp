@@ -0,0 +1,91 @@
+//********************************************************************************************
+//*
+//*    This file is part of Egoboo.
+//*
+//*    Egoboo is free software: you can redistribute it and/or modify it
+//*    under the terms of the GNU General Public License as published by
+//*    the Free Software Foundation, either version 3 of the License, or
+//*    (at your option) any later version.
+//*
+//*    Egoboo is distributed in the hope that it will be useful, but
+//*    WITHOUT ANY WARRANTY; without even the implied warranty of
+//*    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+//*    General Public License for more details.
+//*
+//*    You should have received a copy of the GNU General Public License
+//*    along with Egoboo.  If not, see <http://www.gnu.org/licenses/>.
+//*
+//********************************************************************************************
+
+#include "EgoTest/EgoTest.hpp"
+#include "egolib/egolib.h"
+
+namespace Ego {
+namespace Core {
+namespace Test {
+
+EgoTest_TestCase(TimerWheel) {
+
+EgoTest_Test(deadlines) {
+    // Deadlines within each level and at the level boundaries.
+    std::vector<uint32_t> deadlines = {1, 2, 63, 64, 65, 127, 4095, 4096, 4097, 262143, 262144, 262145,
+                                       300000, 16777215, 16777216, 16777300};
+    std::mt19937 random(4711);
+    for (size_t i = 0; i < 1000; ++i) {
+        deadlines.push_back(1 + random() % 1000000);
+    }
+    Ego::Core::TimerWheel<uint32_t> timers;
+    for (uint32_t deadline : deadlines) {
+        timers.schedule(deadline, deadline);
+    }
+    EgoTest_Assert(timers.size() == deadlines.size());
+    std::vector<uint32_t> delivered;
+    for (uint32_t now = 0; now < 16777300; now += 997) {
+        timers.advance(now, [&timers, &delivered](uint32_t deadline) {
+            EgoTest_Assert(timers.getTime() == deadline);
+            delivered.push_back(deadline);
+        });
+    }
+    timers.advance(16777300, [&timers, &delivered](uint32_t deadline) {
+        EgoTest_Assert(timers.getTime() == deadline);
+        delivered.push_back(deadline);
+    });
+    EgoTest_Assert(timers.empty());
+    std::sort(deadlines.begin(), deadlines.end());
+    EgoTest_Assert(delivered == deadlines);
+}
+
+EgoTest_Test(pastDeadlines) {
+    Ego::Core::TimerWheel<int> timers(100);
+    timers.schedule(50, 1);
+    timers.schedule(100, 2);
+    std::vector<int> delivered;
+    timers.advance(101, [&timers, &delivered](int value) {
+        EgoTest_Assert(timers.getTime() == 101);
+        delivered.push_back(value);
+    });
+    EgoTest_Assert(delivered.size() == 2);
+    EgoTest_Assert(timers.empty());
+}
+
+EgoTest_Test(scheduleFromCallback) {
+    Ego::Core::TimerWheel<int> timers;
+    timers.schedule(10, 0);
+    int count = 0;
+    timers.advance(10000, [&timers, &count](int value) {
+        EgoTest_Assert(value == count);
+        EgoTest_Assert(timers.getTime() == uint32_t(10 + 70 * value));
+        count++;
+        if (count < 100) {
+            timers.schedule(timers.getTime() + 70, count);
+        }
+    });
+    EgoTest_Assert(count == 100);
+    EgoTest_Assert(timers.empty());
+}
+
+};
+
+} // namespace Test
+} // namespace Core
+} // namespace Ego
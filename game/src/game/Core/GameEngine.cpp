@@ -32,6 +32,8 @@
 #include "game/game.h"
 #include "game/Entities/_Include.hpp"
 #include "game/Physics/CollisionSystem.hpp"
+#include "game/Core/HeadlessSimulation.hpp"
+#include "game/Logic/InputReplay.hpp"
 
 //Global singelton
 std::unique_ptr<GameEngine> _gameEngine;
@@ -69,6 +71,9 @@ GameEngine::GameEngine() :
 
     _totalFramesRendered(0),
 
+    _updateClock("engine.update", 512),
+    _renderClock("engine.render", 512),
+
     // Subscriptions
     shown(),
     hidden(),
@@ -183,6 +188,8 @@ void GameEngine::estimateFrameRate()
 
 void GameEngine::updateOneFrame()
 {
+    Ego::Time::ClockScope<Ego::Time::ClockPolicy::NonRecursive> scope(_updateClock);
+
     //Handle clearing the game state stack first. Should be done before any GUI components
     //become locked by the event or rendering loop
     if(_clearGameStateStackRequested) {
@@ -230,6 +237,9 @@ void GameEngine::updateOneFrame()
 
 void GameEngine::renderOneFrame()
 {
+    Ego::Time::Profiler::markFrame();
+    Ego::Time::ClockScope<Ego::Time::ClockPolicy::NonRecursive> scope(_renderClock);
+
     // clear the screen
     gfx_request_clear_screen();
     gfx_do_clear_screen();
@@ -594,17 +604,83 @@ std::shared_ptr<PlayingState> GameEngine::getActivePlayingState() const
  */
 int SDL_main(int argc, char **argv)
 {
+    int exitCode = EXIT_SUCCESS;
     try
     {
+        // A headless simulation runs the game logic of a module without a window.
+        std::string headlessModule;
+        uint32_t headlessUpdateFrames = 0;
+        const bool headless = HeadlessSimulation::parseCommandLine(argc, argv, headlessModule, headlessUpdateFrames);
+        if (headless)
+        {
+            HeadlessSimulation::prepareEnvironment();
+        }
+
+        // The profiler captures from start-up to exit if requested.
+        bool profile = false;
+        for (int i = 1; i < argc; ++i)
+        {
+            if (std::string(argv[i]) == "--profile")
+            {
+                profile = true;
+            }
+        }
+
+        // A session is recorded or played back if requested.
+        InputReplay::Mode replayMode = InputReplay::Mode::None;
+        std::string replayFilename;
+        InputReplay::parseCommandLine(argc, argv, replayMode, replayFilename);
+
         Ego::Core::System::initialize(std::string(argv[0]));
         try
         {
+            if (profile)
+            {
+                Ego::Time::Profiler::startCapture();
+            }
+
+            // Start the worker threads of the job system.
+            Ego::Core::JobSystem::initialize();
+
+            InputReplay::initialize();
+            if (InputReplay::Mode::Recording == replayMode)
+            {
+                InputReplay::get().startRecording(replayFilename);
+            }
+            else if (InputReplay::Mode::Playback == replayMode)
+            {
+                InputReplay::get().startPlayback(replayFilename);
+            }
+
             _gameEngine = std::make_unique<GameEngine>();
 
-            _gameEngine->start();
+            if (headless)
+            {
+                HeadlessSimulation simulation(headlessModule, headlessUpdateFrames);
+                exitCode = simulation.run();
+            }
+            else
+            {
+                _gameEngine->start();
+            }
+
+            // Write the capture before the virtual file system goes down.
+            if (Ego::Time::Profiler::isCapturing())
+            {
+                Ego::Time::Profiler::stopCapture();
+                Ego::Time::Profiler::writeChromeTrace("/debug/profile.json");
+            }
+
+            InputReplay::uninitialize();
+            Ego::Core::JobSystem::uninitialize();
         }
         catch (...)
         {
+            if (InputReplay::isInitialized())
+            {
+                InputReplay::uninitialize();
+            }
+            Ego::Core::JobSystem::uninitialize();
             Ego::Core::System::uninitialize();
             std::rethrow_exception(std::current_exception());
 		}
@@ -645,7 +721,7 @@ int SDL_main(int argc, char **argv)
 
         return EXIT_FAILURE;
     }
-    return EXIT_SUCCESS;
+    return exitCode;
 }
 
 uint32_t GameEngine::getCurrentUpdateFrame() const
@@ -267,6 +267,10 @@ private:
 
     uint32_t _totalFramesRendered; ///< The total number of frames drawn so far
 
+    //Profiling clocks
+    Ego::Time::Clock<Ego::Time::ClockPolicy::NonRecursive> _updateClock;   ///< Time spent in updateOneFrame()
+    Ego::Time::Clock<Ego::Time::ClockPolicy::NonRecursive> _renderClock;   ///< Time spent in renderOneFrame()
+
     //GameEngine Submodules
     std::unique_ptr<Ego::GUI::UIManager> _uiManager;
 };
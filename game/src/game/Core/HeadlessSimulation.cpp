@@ -0,0 +1,240 @@
+//********************************************************************************************
+//*
+//*    This file is part of Egoboo.
+//*
+//*    Egoboo is free software: you can redistribute it and/or modify it
+//*    under the terms of the GNU General Public License as published by
+//*    the Free Software Foundation, either version 3 of the License, or
+//*    (at your option) any later version.
+//*
+//*    Egoboo is distributed in the hope that it will be useful, but
+//*    WITHOUT ANY WARRANTY; without even the implied warranty of
+//*    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+//*    General Public License for more details.
+//*
+//*    You should have received a copy of the GNU General Public License
+//*    along with Egoboo.  If not, see <http://www.gnu.org/licenses/>.
+//*
+//********************************************************************************************
+
+/// @file game/Core/HeadlessSimulation.cpp
+/// @brief Runs the game logic of a module without a window, rendering or audio output.
+
+#include "game/Core/HeadlessSimulation.hpp"
+#include "egolib/Profiles/_Include.hpp"
+#include "game/Core/GameEngine.hpp"
+#include "game/Graphics/CameraSystem.hpp"
+#include "game/Module/Module.hpp"
+#include "game/Physics/CollisionSystem.hpp"
+#include "game/Entities/_Include.hpp"
+#include "game/graphic_billboard.h"
+#include "game/game.h"
+#include "game/link.h"
+
+const uint32_t HeadlessSimulation::DEFAULT_UPDATE_FRAMES;
+
+bool HeadlessSimulation::parseCommandLine(int argc, char **argv, std::string& moduleName, uint32_t& updateFrames)
+{
+    for(int i = 1; i < argc; ++i)
+    {
+        if(std::string(argv[i]) != "--headless") {
+            continue;
+        }
+
+        //Module name is mandatory
+        if(i + 1 >= argc) {
+            throw Id::RuntimeErrorException(__FILE__, __LINE__, "--headless requires a module folder name");
+        }
+        moduleName = argv[i + 1];
+
+        //Number of update frames is optional
+        updateFrames = DEFAULT_UPDATE_FRAMES;
+        if(i + 2 < argc) {
+            const int frames = std::atoi(argv[i + 2]);
+            if(frames > 0) {
+                updateFrames = frames;
+            }
+        }
+        return true;
+    }
+
+    return false;
+}
+
+void HeadlessSimulation::prepareEnvironment()
+{
+    //SDL still has to be initialized (timer, events, keyboard state), but
+    //must not open a window or an audio device
+    SDL_setenv("SDL_VIDEODRIVER", "dummy", 1);
+    SDL_setenv("SDL_AUDIODRIVER", "dummy", 1);
+}
+
+HeadlessSimulation::HeadlessSimulation(const std::string& moduleName, uint32_t updateFrames) :
+    _moduleName(moduleName),
+    _updateFrames(updateFrames)
+{
+    //ctor
+}
+
+int HeadlessSimulation::run()
+{
+    initialize();
+
+    if(!loadModule()) {
+        uninitialize();
+        return EXIT_FAILURE;
+    }
+
+    //Only measure the simulation, not the loading
+    update_ai_timer.reinit();
+    update_all_objects_timer.reinit();
+    move_all_objects_timer.reinit();
+    collision_update_timer.reinit();
+
+    double aiSeconds = 0.0, updateSeconds = 0.0, moveSeconds = 0.0, collisionSeconds = 0.0;
+
+    Ego::Time::Stopwatch stopwatch;
+    stopwatch.start();
+    for(uint32_t i = 0; i < _updateFrames; ++i)
+    {
+        Ego::Time::Profiler::markFrame();
+        update_game();
+
+        //AI is not run on the first update frame
+        if(i > 0) {
+            aiSeconds += update_ai_timer.lst();
+        }
+        updateSeconds += update_all_objects_timer.lst();
+        moveSeconds += move_all_objects_timer.lst();
+        collisionSeconds += collision_update_timer.lst();
+    }
+    stopwatch.stop();
+
+    report(stopwatch.elapsed(), aiSeconds, updateSeconds, moveSeconds, collisionSeconds);
+
+    uninitialize();
+    return EXIT_SUCCESS;
+}
+
+void HeadlessSimulation::initialize()
+{
+    // Initialize the input system (the update loop reads the keyboard and mouse state).
+    Ego::Input::InputSystem::initialize();
+
+    // The camera system is required by the update loop, but no cameras are created.
+    CameraSystem::Singleton::initialize();
+
+    // Initialize the audio system (on top of the SDL dummy audio driver).
+    AudioSystem::initialize();
+
+    // Initialize the particle handler.
+    ParticleHandler::initialize();
+
+    // Initialize the billboard system.
+    BillboardSystem::initialize();
+
+    // Initialize Perks
+    Ego::Perks::PerkHandler::initialize();
+
+    // Initialize the profile system.
+    ProfileSystem::initialize();
+
+    // Initialize the collision system.
+    Ego::Physics::CollisionSystem::initialize();
+
+    // Load all modules
+    ProfileSystem::get().loadModuleProfiles();
+}
+
+void HeadlessSimulation::uninitialize()
+{
+    // Stop the module.
+    game_quit_module();
+
+    // Uninitialize the collision system.
+    Ego::Physics::CollisionSystem::uninitialize();
+
+    // Uninitialize the profile system.
+    ProfileSystem::uninitialize();
+
+    // Uninitialize the billboard system.
+    BillboardSystem::uninitialize();
+
+    // Uninitialize the particle handler.
+    ParticleHandler::uninitialize();
+
+    // Uninitialize the audio system.
+    AudioSystem::uninitialize();
+
+    // Uninitialize the camera system.
+    CameraSystem::Singleton::uninitialize();
+
+    // Uninitialize the input system.
+    Ego::Input::InputSystem::uninitialize();
+}
+
+bool HeadlessSimulation::loadModule()
+{
+    std::shared_ptr<ModuleProfile> module;
+    for(const std::shared_ptr<ModuleProfile> &profile : ProfileSystem::get().getModuleProfiles())
+    {
+        if(profile->getFolderName() == _moduleName) {
+            module = profile;
+            break;
+        }
+    }
+    if(!module) {
+        Log::get() << Log::Entry::create(Log::Level::Warning, __FILE__, __LINE__, "unable to find module ", "`", _moduleName, "`", Log::EndOfEntry);
+        return false;
+    }
+
+    //Make sure all data is cleared first
+    game_quit_module();
+
+    // Linking system
+    if (!link_build_vfs("mp_data/link.txt", LinkList))
+    {
+        Log::get() << Log::Entry::create(Log::Level::Warning, __FILE__, __LINE__, "failed to initialize module linking", Log::EndOfEntry);
+    }
+
+    // Reset all loaded "profiles" in the "profile system".
+    ProfileSystem::get().reset();
+
+    // try to start a new module
+    try {
+        if(!game_begin_module(module)) {
+            Log::get() << Log::Entry::create(Log::Level::Warning, __FILE__, __LINE__, "failed to load module", Log::EndOfEntry);
+            return false;
+        }
+    }
+    catch(const Id::Exception& ex) {
+        Log::get() << Log::Entry::create(Log::Level::Warning, __FILE__, __LINE__, "failed to load module: ", (std::string)ex, Log::EndOfEntry);
+        return false;
+    }
+
+    return true;
+}
+
+void HeadlessSimulation::report(double totalSeconds, double aiSeconds, double updateSeconds, double moveSeconds, double collisionSeconds) const
+{
+    const double updatesPerSecond = totalSeconds > 0.0 ? _updateFrames / totalSeconds : 0.0;
+
+    std::ostringstream os;
+    os << std::fixed << std::setprecision(3);
+    os << "headless simulation of `" << _moduleName << "`: "
+       << _updateFrames << " update frames in " << totalSeconds << " s (" << updatesPerSecond << " updates/sec)" << std::endl;
+
+    //Total and average time per update frame for each phase of update_game()
+    const auto phase = [&os, this](const char *name, double seconds) {
+        os << "  " << std::left << std::setw(20) << name << std::right
+           << std::setw(12) << seconds * 1000.0 << " ms total, "
+           << std::setw(10) << (_updateFrames > 0 ? seconds * 1000.0 / _updateFrames : 0.0) << " ms/update" << std::endl;
+    };
+    phase("ai", aiSeconds);
+    phase("update_all_objects", updateSeconds);
+    phase("move_all_objects", moveSeconds);
+    phase("collisions", collisionSeconds);
+
+    std::cout << os.str();
+    Log::get() << Log::Entry::create(Log::Level::Message, __FILE__, __LINE__, os.str(), Log::EndOfEntry);
+}
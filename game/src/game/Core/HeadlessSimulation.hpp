@@ -0,0 +1,92 @@
+//********************************************************************************************
+//*
+//*    This file is part of Egoboo.
+//*
+//*    Egoboo is free software: you can redistribute it and/or modify it
+//*    under the terms of the GNU General Public License as published by
+//*    the Free Software Foundation, either version 3 of the License, or
+//*    (at your option) any later version.
+//*
+//*    Egoboo is distributed in the hope that it will be useful, but
+//*    WITHOUT ANY WARRANTY; without even the implied warranty of
+//*    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+//*    General Public License for more details.
+//*
+//*    You should have received a copy of the GNU General Public License
+//*    along with Egoboo.  If not, see <http://www.gnu.org/licenses/>.
+//*
+//********************************************************************************************
+
+/// @file game/Core/HeadlessSimulation.hpp
+/// @brief Runs the game logic of a module without a window, rendering or audio output.
+
+#pragma once
+
+#include "egolib/egolib.h"
+
+//Forward declarations
+class ModuleProfile;
+
+/**
+* @brief
+*   A headless simulation loads a module and runs update_game() for a fixed number of update
+*   frames as fast as possible. Nothing is rendered and no window or OpenGL context is created.
+*   It is used to measure the throughput of the game logic separately from rendering.
+* @remark
+*   A headless simulation is started from the command line:
+*   @code
+*   egoboo --headless <module folder name> [<number of update frames>] [--profile]
+*   @endcode
+*   With <tt>--profile</tt>, a profiler capture of the run is written to <tt>/debug/profile.json</tt>.
+**/
+class HeadlessSimulation : public Id::NonCopyable
+{
+public:
+    static const uint32_t DEFAULT_UPDATE_FRAMES = 1000;   ///< Number of update frames if none are specified
+
+    /**
+    * @brief
+    *   Parse the command line arguments for a headless simulation request.
+    * @param moduleName
+    *   receives the folder name of the module to simulate
+    * @param updateFrames
+    *   receives the number of update frames to simulate
+    * @return
+    *   @a true if a headless simulation was requested, @a false otherwise
+    **/
+    static bool parseCommandLine(int argc, char **argv, std::string& moduleName, uint32_t& updateFrames);
+
+    /**
+    * @brief
+    *   Select the SDL dummy video and audio drivers. Must be called before Ego::Core::System
+    *   is initialized.
+    **/
+    static void prepareEnvironment();
+
+    HeadlessSimulation(const std::string& moduleName, uint32_t updateFrames);
+
+    /**
+    * @brief
+    *   Initialize the logic subsystems, load the module and simulate it.
+    * @return
+    *   EXIT_SUCCESS if the module was simulated, EXIT_FAILURE otherwise
+    **/
+    int run();
+
+private:
+    void initialize();
+    void uninitialize();
+
+    /**
+    * @brief
+    *   Load the module in the same way the LoadingState does, skipping all steps
+    *   related to graphics, audio and the user interface.
+    **/
+    bool loadModule();
+
+    void report(double totalSeconds, double aiSeconds, double updateSeconds, double moveSeconds, double collisionSeconds) const;
+
+private:
+    std::string _moduleName;    ///< Folder name of the module to simulate
+    uint32_t _updateFrames;     ///< Number of update frames to simulate
+};
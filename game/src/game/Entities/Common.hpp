@@ -128,11 +128,15 @@ struct PhysicsData
     ObjectRef onwhichplatform_ref; ///< Is the particle on a platform?
     Uint32 onwhichplatform_update; ///< When was the last platform attachment made?
 
+private:
+    Vector3f _ownVelocity;  ///< Storage of the current velocity, unless it is kept outside
+
+public:
     /**
     * @brief
     *  The current velocity of the entity.
     */
-	Vector3f vel;
+	Vector3f& vel;
 
     /**
     * @brief
@@ -146,9 +150,29 @@ struct PhysicsData
         targetplatform_ref(),
         onwhichplatform_ref(),
         onwhichplatform_update(0),
-        vel_old(), 
-        vel()
+        _ownVelocity(),
+        vel(_ownVelocity),
+        vel_old()
+    {
+    }
+
+    /**
+    * @brief
+    *  Constructs the physics data of an entity which keeps its current velocity outside of itself
+    * @param velocity
+    *  the current velocity, must live as long as the entity
+    */
+    explicit PhysicsData(Vector3f& velocity) :
+        phys(),
+        targetplatform_level(0.0f),
+        targetplatform_ref(),
+        onwhichplatform_ref(),
+        onwhichplatform_update(0),
+        _ownVelocity(),
+        vel(velocity),
+        vel_old()
     {
+        vel = Vector3f::zero();
     }
     
     static void reset(PhysicsData *self)
@@ -24,6 +24,7 @@
 #include "Enchant.hpp"
 #include "egolib/Graphics/ModelDescriptor.hpp"
 #include "game/Core/GameEngine.hpp"
+#include "game/game.h"
 
 namespace Ego
 {
@@ -169,11 +170,11 @@ Enchantment::~Enchantment()
             }
             else if(Ego::Attribute::isOverrideSetAttribute(modifier._type)) {
                 //remove effect completely
-                target->getTempAttributes().erase(modifier._type);
+                target->removeTempAttribute(modifier._type);
             }
             else {
                 //remove cumulative bonus/penality
-                target->getTempAttributes()[modifier._type] -= modifier._value;
+                target->increaseTempAttribute(modifier._type, -modifier._value);
             }
         }
     }
@@ -181,8 +182,8 @@ Enchantment::~Enchantment()
     //Remove boost effects from owner
     std::shared_ptr<Object> owner = _owner.lock();
     if(owner != nullptr && !owner->isTerminated()) {
-        owner->getTempAttributes()[Ego::Attribute::MANA_REGEN] -= _ownerManaSustain;
-        owner->getTempAttributes()[Ego::Attribute::LIFE_REGEN] -= _ownerLifeSustain;
+        owner->increaseTempAttribute(Ego::Attribute::MANA_REGEN, -_ownerManaSustain);
+        owner->increaseTempAttribute(Ego::Attribute::LIFE_REGEN, -_ownerLifeSustain);
     }
 }
 
@@ -270,13 +271,6 @@ void Enchantment::update()
             }
         }
     }
-
-    //Decrement the lifetimer
-    if(_lifeTime > 0) {
-        if(_lifeTime == 0) {
-            requestTerminate();
-        }        
-    }
 }
 
 const std::shared_ptr<EnchantProfile>& Enchantment::getProfile() const
@@ -343,7 +337,14 @@ void Enchantment::applyEnchantment(std::shared_ptr<Object> target)
 
     //modify enchant duration with damage resistance (bad resistance actually *increases* duration!)
     if ( _lifeTime > 0 && _enchantProfile->required_damagetype < DAMAGE_COUNT && target ) {
-        _lifeTime -= std::ceil(target->getDamageReduction(_enchantProfile->required_damagetype) * _enchantProfile->lifetime);
+        _lifeTime -= std::ceil(target->getDamageReduction(_enchantProfile->required_damagetype) * _enchantProfile->lifetime * GameEngine::GAME_TARGET_UPS);
+
+        //Resisted for its whole duration (a lifetime of -1 would be permanent)
+        if (_lifeTime <= 0) {
+			Log::get() << Log::Entry::create(Log::Level::Debug, __FILE__, __LINE__, "unable to apply enchant: target resists its whole duration", Log::EndOfEntry);
+            requestTerminate();
+            return;
+        }
     }
 
     // Create an overlay character?
@@ -379,7 +380,7 @@ void Enchantment::applyEnchantment(std::shared_ptr<Object> target)
         }
 
         //Is there no conflict?
-        if(target->getTempAttributes().find(modifier._type) == target->getTempAttributes().end()) {
+        if(!target->hasTempAttribute(modifier._type)) {
             return false;
         }
 
@@ -436,7 +437,7 @@ void Enchantment::applyEnchantment(std::shared_ptr<Object> target)
         //Morph is special and handled differently than others
         if(modifier._type == Ego::Attribute::MORPH) {
             //Store target's original armor
-            target->getTempAttributes()[Ego::Attribute::MORPH] = target->skin;
+            target->setTempAttribute(Ego::Attribute::MORPH, target->skin);
 
             //Transform the object
             target->polymorphObject(_spawnerProfileID, 0);
@@ -444,20 +445,31 @@ void Enchantment::applyEnchantment(std::shared_ptr<Object> target)
 
         //Is it a set type?
         else if(Ego::Attribute::isOverrideSetAttribute(modifier._type)) {
-            target->getTempAttributes()[modifier._type] = modifier._value;
+            target->setTempAttribute(modifier._type, modifier._value);
         }
 
         //It's a cumulative addition
         else {
-            target->getTempAttributes()[modifier._type] += modifier._value;            
+            target->increaseTempAttribute(modifier._type, modifier._value);
         }
     }
 
     //Finally apply boost values to owner as well
     std::shared_ptr<Object> owner = _owner.lock();
     if(owner != nullptr && !owner->isTerminated()) {
-        owner->getTempAttributes()[Ego::Attribute::MANA_REGEN] += _ownerManaSustain;
-        owner->getTempAttributes()[Ego::Attribute::LIFE_REGEN] += _ownerLifeSustain;
+        owner->increaseTempAttribute(Ego::Attribute::MANA_REGEN, _ownerManaSustain);
+        owner->increaseTempAttribute(Ego::Attribute::LIFE_REGEN, _ownerLifeSustain);
+    }
+
+    //End this enchantment when its lifetime is over
+    if(_lifeTime > 0) {
+        std::weak_ptr<Enchantment> enchant = shared_from_this();
+        _currentModule->getTimers().schedule(update_wld + _lifeTime, [enchant]() {
+            std::shared_ptr<Enchantment> self = enchant.lock();
+            if(self) {
+                self->requestTerminate();
+            }
+        });
     }
 
     //Insert this enchantment into the Objects list of active enchants
@@ -488,10 +500,10 @@ void Enchantment::setBoostValues(float ownerManaSustain, float ownerLifeSustain,
     //Update boost effects to owner
     std::shared_ptr<Object> owner = _owner.lock();
     if(owner && !owner->isTerminated()) {
-        owner->getTempAttributes()[Ego::Attribute::MANA_REGEN] -= _ownerManaSustain;
-        owner->getTempAttributes()[Ego::Attribute::LIFE_REGEN] -= _ownerLifeSustain;
-        owner->getTempAttributes()[Ego::Attribute::MANA_REGEN] += ownerManaSustain;
-        owner->getTempAttributes()[Ego::Attribute::LIFE_REGEN] += ownerLifeSustain;
+        owner->increaseTempAttribute(Ego::Attribute::MANA_REGEN, -_ownerManaSustain);
+        owner->increaseTempAttribute(Ego::Attribute::LIFE_REGEN, -_ownerLifeSustain);
+        owner->increaseTempAttribute(Ego::Attribute::MANA_REGEN, ownerManaSustain);
+        owner->increaseTempAttribute(Ego::Attribute::LIFE_REGEN, ownerLifeSustain);
     }
     _ownerManaSustain = ownerManaSustain;
     _ownerLifeSustain = ownerLifeSustain;
@@ -501,14 +513,14 @@ void Enchantment::setBoostValues(float ownerManaSustain, float ownerLifeSustain,
     if(target != nullptr) {
         for(EnchantModifier &modifier : _modifiers) {
             if(modifier._type == Ego::Attribute::MANA_REGEN) {
-                target->getTempAttributes()[Ego::Attribute::MANA_REGEN] -= modifier._value;
+                target->increaseTempAttribute(Ego::Attribute::MANA_REGEN, -modifier._value);
                 modifier._value = -targetManaDrain;
-                target->getTempAttributes()[Ego::Attribute::MANA_REGEN] += modifier._value;
+                target->increaseTempAttribute(Ego::Attribute::MANA_REGEN, modifier._value);
             }
             else if(modifier._type == Ego::Attribute::LIFE_REGEN) {
-                target->getTempAttributes()[Ego::Attribute::LIFE_REGEN] -= modifier._value;
+                target->increaseTempAttribute(Ego::Attribute::LIFE_REGEN, -modifier._value);
                 modifier._value = -targetLifeDrain;
-                target->getTempAttributes()[Ego::Attribute::LIFE_REGEN] += modifier._value;            
+                target->increaseTempAttribute(Ego::Attribute::LIFE_REGEN, modifier._value);
             }
         }        
     }  
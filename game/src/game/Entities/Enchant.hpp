@@ -137,7 +137,7 @@ private:
 
     PRO_REF _spawnerProfileID;        ///< The object  profile index that spawned this enchant
 
-    int _lifeTime;                  ///< Time before end (in game logic frames)
+    int _lifeTime;                  ///< Duration (in game logic frames), ended by a timer of the module
     int _spawnParticlesTimer;       ///< Time before spawning particle effects (in game logic frames)
 
     std::weak_ptr<Object> _target;  ///< Who it enchants
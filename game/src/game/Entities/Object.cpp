@@ -60,7 +60,7 @@ Object::Object(const PRO_REF proRef, ObjectRef objRef) :
     fat_goto(0.0f),
     fat_goto_time(0),
 
-    jump_timer(JUMPDELAY),
+    jump_timer(0),
     jumpnumber(0),
     jumpready(false),
 
@@ -132,8 +132,7 @@ Object::Object(const PRO_REF proRef, ObjectRef objRef) :
 
     _currentLife(0.0f),
     _currentMana(0.0f),
-    _baseAttribute(),
-    _tempAttribute(),
+    _attributes(),
 
     _inventory(),
     _money(0),
@@ -163,9 +162,6 @@ Object::Object(const PRO_REF proRef, ObjectRef objRef) :
     // Grip info
     holdingwhich.fill(ObjectRef::Invalid);
 
-    //Clear initial base attributes
-    _baseAttribute.fill(0.0f);
-
     // pack/inventory info
     equipment.fill(ObjectRef::Invalid);
 
@@ -176,11 +172,15 @@ Object::Object(const PRO_REF proRef, ObjectRef objRef) :
     //Initialize primary attributes
     for(size_t i = 0; i < Ego::Attribute::NR_OF_PRIMARY_ATTRIBUTES; ++i) {
         const Ego::Math::Interval<float>& baseRange = _profile->getAttributeBase(static_cast<Ego::Attribute::AttributeType>(i));
-        _baseAttribute[i] = Random::next(baseRange);
+        _attributes.setBase(static_cast<Ego::Attribute::AttributeType>(i), Random::next(baseRange));
     }
+    updatePerks();
 
     //Initialize timer to a random value
     resetBoredTimer();
+
+    //No jumping right after spawning
+    setTimer(&Object::jump_timer, JUMPDELAY);
 }
 
 Object::~Object()
@@ -223,15 +223,15 @@ bool Object::setSkin(const size_t skinNumber)
 
     //Damage resistance and modifiers from Armour
     for(size_t i = 0; i < DAMAGE_COUNT; ++i) {
-        _baseAttribute[Ego::Attribute::resistFromDamageType(static_cast<DamageType>(i))] = newSkin.damageResistance[i];
-        _baseAttribute[Ego::Attribute::modifierFromDamageType(static_cast<DamageType>(i))] = newSkin.damageModifier[i];
+        _attributes.setBase(Ego::Attribute::resistFromDamageType(static_cast<DamageType>(i)), newSkin.damageResistance[i]);
+        _attributes.setBase(Ego::Attribute::modifierFromDamageType(static_cast<DamageType>(i)), newSkin.damageModifier[i]);
     }
 
     //Armour movement speed
-    _baseAttribute[Ego::Attribute::ACCELERATION] = newSkin.maxAccel;
+    _attributes.setBase(Ego::Attribute::ACCELERATION, newSkin.maxAccel);
 
     //Defence from Armour
-    _baseAttribute[Ego::Attribute::DEFENCE] = newSkin.defence;
+    _attributes.setBase(Ego::Attribute::DEFENCE, newSkin.defence);
 
     //Set new skin
     this->skin = skinNumber;
@@ -347,6 +347,9 @@ int Object::damage(Facing direction, const IPair  damage, const DamageType damag
     int max_damage = std::abs( damage.base ) + std::abs( damage.rand );
     if ( !isAlive() || 0 == max_damage ) return 0;
 
+    // getting hit wakes up a sleeping object
+    getObjectPhysics().wakeUp();
+
     // make a special exception for DAMAGE_DIRECT
     uint8_t damageModifier = ( damagetype >= DAMAGE_COUNT ) ? 0 : getAttribute(Ego::Attribute::modifierFromDamageType(damagetype));
 
@@ -507,7 +510,7 @@ int Object::damage(Facing direction, const IPair  damage, const DamageType damag
                         // Make the character invincible for a limited time only
                         if (setDamageTime)
                         {
-                            damage_timer = DAMAGETIME;
+                            setTimer(&Object::damage_timer, DAMAGETIME);
                         }
                     }
                 }
@@ -732,6 +735,10 @@ void Object::update()
 
     //Don't do items that are inside an inventory
     if (isInsideInventory()) {
+        //Their timers are on hold
+        updateTimer(&Object::reload_timer);
+        updateTimer(&Object::jump_timer);
+        updateTimer(&Object::damage_timer);
         return;
     }
 
@@ -801,9 +808,6 @@ void Object::update()
 
     //---- Do timers and such
 
-    // reduce attack cooldowns
-    if ( reload_timer > 0 ) reload_timer--;
-
     // decrement the dismount timer
     if ( dismount_timer > 0 ) dismount_timer--;
 
@@ -811,14 +815,9 @@ void Object::update()
         dismount_object = ObjectRef::Invalid;
     }
 
-    // Down jump timer
-    if(jump_timer > 0) {
-        if (isBeingHeld() || getObjectPhysics().isTouchingGround() || jumpnumber > 0) { 
-            jump_timer--;
-        }
-    }
-    // Down that ol' damage timer
-    if ( damage_timer > 0 ) damage_timer--;
+    // The reload, jump and damage timers end with events of the timer wheel,
+    // only the jump timer is on hold while we can not jump
+    updateTimer(&Object::jump_timer);
 
     // Do "Be careful!" delay
     if ( careful_timer > 0 ) careful_timer--;
@@ -887,92 +886,71 @@ void Object::update()
 
         //Give Rally bonus to friends within 6 tiles
         if(hasPerk(Ego::Perks::RALLY)) {
-            std::vector<std::shared_ptr<Object>> nearbyObjects = _currentModule->getObjectHandler().findObjects(getPosX(), getPosY(), WIDE, false);
-            for(const std::shared_ptr<Object> &object : nearbyObjects)
+            _currentModule->getObjectHandler().visitObjects(getPosX(), getPosY(), WIDE, false, [this](Object &object)
             {
                 //Only valid objects that are on our team
-                if(object->isTerminated() || object->getTeam() != getTeam()) continue;
+                if(object.isTerminated() || object.getTeam() != getTeam()) return;
 
                 //Don't give bonus to ourselves!
-                if(object.get() == this) continue;
+                if(&object == this) return;
 
-                object->_reallyDuration = update_wld + GameEngine::GAME_TARGET_UPS*3;    //Apply bonus for 3 seconds
-            }
+                object._reallyDuration = update_wld + GameEngine::GAME_TARGET_UPS*3;    //Apply bonus for 3 seconds
+            });
         }
     }
 
     //Try to detect any hidden objects every so often (unless we are scenery object) 
-    if(!isScenery() && isAlive() && !isBeingHeld() && inst.getCurrentAnimation() != ACTION_MK) {  //ACTION_MK = sleeping
-        if(update_wld > _observationTimer) 
+    if(isLookingForHiddenObjects()) {
+        _observationTimer = update_wld + ONESECOND;
+
+        //Check for nearby enemies until one is detected
+        bool detected = false;
+        _currentModule->getObjectHandler().visitObjects(getPosX(), getPosY(), WIDE, false, [this, &detected](Object &target)
         {
-            _observationTimer = update_wld + ONESECOND;
-
-            //Setup line of sight data
-            line_of_sight_info_t lineOfSightInfo;
-            lineOfSightInfo.x0         = getPosX();
-            lineOfSightInfo.y0         = getPosY();
-            lineOfSightInfo.z0         = getPosZ() + std::max(1.0f, bump.height);
-            lineOfSightInfo.stopped_by = stoppedby;
-
-            //Check for nearby enemies
-            std::vector<std::shared_ptr<Object>> nearbyObjects = _currentModule->getObjectHandler().findObjects(getPosX(), getPosY(), WIDE, false);
-            for(const std::shared_ptr<Object> &target : nearbyObjects) {
-                //Valid objects only
-                if(target->isTerminated() || target->isHidden()) continue;
-
-                //Only look for stealthed objects
-                if(!target->isStealthed()) continue;
-
-                //Are they a enemy of us?
-                if(!target->getTeam().hatesTeam(getTeam())) {
-                    continue;
-                }
+            if(detected) return;
 
-                //Can we see them?
-                lineOfSightInfo.x1 = target->getPosX();
-                lineOfSightInfo.y1 = target->getPosY();
-                lineOfSightInfo.z1 = target->getPosZ() + std::max(1.0f, target->bump.height);
-                if (line_of_sight_info_t::blocked(lineOfSightInfo, _currentModule->getMeshPointer())) {
-                    continue;
-                }
+            //Can we see them?
+            if(!isHiddenObjectInSight(target)) {
+                return;
+            }
 
-                //Sense Invisible = automatic detection
-                if(target->canSeeInvisible()) {
-                    target->deactivateStealth();
-                    target->_stealthTimer = ONESECOND * 6; //6 second timeout
-                    break;
-                }
+            //Sense Invisible = automatic detection
+            if(target.canSeeInvisible()) {
+                target.deactivateStealth();
+                target._stealthTimer = ONESECOND * 6; //6 second timeout
+                detected = true;
+                return;
+            }
 
-                //Check for detection chance, Base chance 20%
-                int chance = 20;
+            //Check for detection chance, Base chance 20%
+            int chance = 20;
 
-                //+0.5% per Intellect
-                chance += getAttribute(Ego::Attribute::INTELLECT)*0.5f;
+            //+0.5% per Intellect
+            chance += getAttribute(Ego::Attribute::INTELLECT)*0.5f;
 
-                //-0.5% per target Agility
-                chance -= target->getAttribute(Ego::Attribute::AGILITY)*0.5f;
+            //-0.5% per target Agility
+            chance -= target.getAttribute(Ego::Attribute::AGILITY)*0.5f;
 
-                //-5% per tile distance
-                chance -= 5 * ((getPosition()-target->getPosition()).length() / Info<float>::Grid::Size());
+            //-5% per tile distance
+            chance -= 5 * ((getPosition()-target.getPosition()).length() / Info<float>::Grid::Size());
 
-                //Perceptive Perk doubles chance
-                if(target->hasPerk(Ego::Perks::PERCEPTIVE)) {
-                    chance *= 2;
-                }
+            //Perceptive Perk doubles chance
+            if(target.hasPerk(Ego::Perks::PERCEPTIVE)) {
+                chance *= 2;
+            }
 
-                //If they are not looking towards us, then halve detection chance
-                if(!target->isFacingLocation(getPosX(), getPosY())) {
-                    chance /= 2;
-                }
+            //If they are not looking towards us, then halve detection chance
+            if(!target.isFacingLocation(getPosX(), getPosY())) {
+                chance /= 2;
+            }
 
-                //Were they detected by us?
-                if(Random::getPercent() <= chance) {
-                    target->deactivateStealth();
-                    target->_stealthTimer = ONESECOND * 6; //6 second timeout
-                    break;
-                }
+            //Were they detected by us?
+            if(Random::getPercent() <= chance) {
+                target.deactivateStealth();
+                target._stealthTimer = ONESECOND * 6; //6 second timeout
+                detected = true;
             }
-        }
+        });
     }
 
     //Generate movement and attacks from input latches
@@ -982,6 +960,38 @@ void Object::update()
     updateResize();
 }
 
+bool Object::isLookingForHiddenObjects() const
+{
+    //Not for scenery objects, sleeping (ACTION_MK) or held objects and only every so often
+    return !isScenery() && isAlive() && !isBeingHeld() && inst.getCurrentAnimation() != ACTION_MK
+        && update_wld > _observationTimer;
+}
+
+bool Object::isHiddenObjectInSight(const Object &target) const
+{
+    //Valid objects only
+    if(target.isTerminated() || target.isHidden()) return false;
+
+    //Only look for stealthed objects
+    if(!target.isStealthed()) return false;
+
+    //Are they a enemy of us?
+    if(!target.getTeam().hatesTeam(getTeam())) {
+        return false;
+    }
+
+    //Can we see them?
+    line_of_sight_info_t lineOfSightInfo;
+    lineOfSightInfo.x0         = getPosX();
+    lineOfSightInfo.y0         = getPosY();
+    lineOfSightInfo.z0         = getPosZ() + std::max(1.0f, bump.height);
+    lineOfSightInfo.x1         = target.getPosX();
+    lineOfSightInfo.y1         = target.getPosY();
+    lineOfSightInfo.z1         = target.getPosZ() + std::max(1.0f, target.bump.height);
+    lineOfSightInfo.stopped_by = stoppedby;
+    return !line_of_sight_info_t::blocked(lineOfSightInfo, _currentModule->getMeshPointer());
+}
+
 void Object::updateResize()
 {
     if (fat_goto_time < 0) {
@@ -1352,7 +1362,8 @@ void Object::checkLevelUp()
 
             //Primary Attribute increase
             for(size_t i = 0; i < Ego::Attribute::NR_OF_PRIMARY_ATTRIBUTES; ++i) {
-                _baseAttribute[i] += Random::next(getProfile()->getAttributeGain(static_cast<Ego::Attribute::AttributeType>(i)));
+                const Ego::Attribute::AttributeType type = static_cast<Ego::Attribute::AttributeType>(i);
+                _attributes.setBase(type, _attributes.getBase(type) + Random::next(getProfile()->getAttributeGain(type)));
             }
 
             //Grab random Perk? (ZF> just uncomment if we want to do this for AI characters as well)
@@ -1880,7 +1891,7 @@ void Object::respawn()
 
     platform        = profile->isPlatform();
     canuseplatforms = profile->canUsePlatforms();
-    _baseAttribute[Ego::Attribute::FLY_TO_HEIGHT] = profile->getFlyHeight();
+    _attributes.setBase(Ego::Attribute::FLY_TO_HEIGHT, profile->getFlyHeight());
     phys.bumpdampen = profile->getBumpDampen();
 
     ai.alert = ALERTIF_CLEANEDUP;
@@ -2002,92 +2013,47 @@ float Object::getDamageReduction(const DamageType type, const bool includeArmor)
 
 float Object::getBaseAttribute(const Ego::Attribute::AttributeType type) const
 {
-    EGOBOO_ASSERT(type < _baseAttribute.size() && type != Ego::Attribute::NR_OF_PRIMARY_ATTRIBUTES);
-    return _baseAttribute[type];
+    return _attributes.getBase(type);
 }
 
 void Object::setBaseAttribute(const Ego::Attribute::AttributeType type, float value)
 {
-    EGOBOO_ASSERT(type < _baseAttribute.size() && type != Ego::Attribute::NR_OF_PRIMARY_ATTRIBUTES);
-    _baseAttribute[type] = value;
+    _attributes.setBase(type, value);
 }
 
 float Object::getAttribute(const Ego::Attribute::AttributeType type) const 
 { 
-    EGOBOO_ASSERT(type < _baseAttribute.size() && type != Ego::Attribute::NR_OF_PRIMARY_ATTRIBUTES);
-
-    float attributeValue = _baseAttribute[type];
+    float attributeValue = _attributes.get(type);
 
-    //Try to find temp value in map, but don't create it if it doesn't already exist
-    const auto& result = _tempAttribute.find(type);
-    if(result != _tempAttribute.end()) {
-
-        //Is this a SET type attribute or a cumulative ADD type attribute?
-        if(isOverrideSetAttribute(type)) {
-            return (*result).second;
-        }
-        else {
-            //Total value is base plus temp bonuses from enchants
-            attributeValue += (*result).second;
-        }
+    //Wolverine perk gives +0.25 Life Regeneration while holding a Claw weapon
+    //(depends on the items held in hand, which are not tracked by the attributes)
+    if(type == Ego::Attribute::LIFE_REGEN && hasPerk(Ego::Perks::WOLVERINE)) {
+        if( (getLeftHandItem() && getLeftHandItem()->getProfile()->getIDSZ(IDSZ_PARENT).equals('C','L','A','W'))
+         || (getRightHandItem() && getRightHandItem()->getProfile()->getIDSZ(IDSZ_PARENT).equals('C','L','A','W')))
+         {
+            attributeValue += 0.25f;
+         }
     }
 
-    switch(type) {
-
-        //Wolverine perk gives +0.25 Life Regeneration while holding a Claw weapon
-        case Ego::Attribute::LIFE_REGEN:
-            if(hasPerk(Ego::Perks::WOLVERINE)) {
-                if( (getLeftHandItem() && getLeftHandItem()->getProfile()->getIDSZ(IDSZ_PARENT).equals('C','L','A','W'))
-                 || (getRightHandItem() && getRightHandItem()->getProfile()->getIDSZ(IDSZ_PARENT).equals('C','L','A','W')))
-                 {
-                    attributeValue += 0.25f;
-                 }                
-            }
-        break;
-
-        case Ego::Attribute::JUMP_POWER:
-            //Special value for flying Objects
-            if(getAttribute(Ego::Attribute::FLY_TO_HEIGHT) > 0.0f) {
-                return Object::JUMPINFINITE;
-            }
-
-            //Athletics Perks gives +25% jump power
-            if(hasPerk(Ego::Perks::ATHLETICS)) {
-                attributeValue *= 1.25f;
-            }
-
-            //Every point of Might increases jump power by 1%
-            attributeValue *= 1.0f + (getAttribute(Ego::Attribute::MIGHT) / 100.0f);
-        break;
-
-        //Limit lowest acceleration to zero
-        case Ego::Attribute::ACCELERATION:
-        {
-            if(attributeValue < 0.0f) return 0.0f;
-        }
-        break;
+    return attributeValue;
+}
 
-        //Limit lowest base attribute to 1
-        case Ego::Attribute::MIGHT:
-        case Ego::Attribute::AGILITY:
-        case Ego::Attribute::INTELLECT:
-        {
-            if(attributeValue < 1.0f) return 1.0f;
+void Object::updatePerks()
+{
+    //@note ZF> We also have to check our profile in case we are polymorphed and gain new
+    //          skills from our new form (e.g Lumpkin form allows gunplay)
+    std::bitset<Ego::Perks::NR_OF_PERKS> perks = _perks;
+    for(size_t i = 0; i < Ego::Perks::NR_OF_PERKS; ++i) {
+        if(getProfile()->beginsWithPerk(static_cast<Ego::Perks::PerkID>(i))) {
+            perks[i] = true;
         }
-        break;
-
-        default:
-            //nothing, keep default case to quench GCC warnings
-        break;
     }
-
-    return attributeValue; 
+    _attributes.setPerks(perks);
 }
 
 void Object::increaseBaseAttribute(const Ego::Attribute::AttributeType type, float value)
 {
-    EGOBOO_ASSERT(type < _baseAttribute.size() && type != Ego::Attribute::NR_OF_PRIMARY_ATTRIBUTES);
-    _baseAttribute[type] = Ego::Math::constrain(_baseAttribute[type] + value, 0.0f, 255.0f);
+    _attributes.setBase(type, Ego::Math::constrain(_attributes.getBase(type) + value, 0.0f, 255.0f));
 
     //Handle current life and mana increase as well
     if(type == Ego::Attribute::MAX_LIFE) {
@@ -2144,6 +2110,7 @@ void Object::addPerk(Ego::Perks::PerkID perk)
 {
     if(perk == Ego::Perks::NR_OF_PERKS) return;
     _perks[perk] = true;
+    updatePerks();
 }
 
 float Object::getLife() const
@@ -2214,9 +2181,24 @@ bool Object::disenchant()
     return oneRemoved;
 }
 
-std::unordered_map<Ego::Attribute::AttributeType, float, std::hash<uint8_t>>& Object::getTempAttributes()
+bool Object::hasTempAttribute(const Ego::Attribute::AttributeType type) const
 {
-    return _tempAttribute;
+    return _attributes.hasTemp(type);
+}
+
+void Object::setTempAttribute(const Ego::Attribute::AttributeType type, float value)
+{
+    _attributes.setTemp(type, value);
+}
+
+void Object::increaseTempAttribute(const Ego::Attribute::AttributeType type, float value)
+{
+    _attributes.increaseTemp(type, value);
+}
+
+void Object::removeTempAttribute(const Ego::Attribute::AttributeType type)
+{
+    _attributes.removeTemp(type);
 }
 
 bool Object::isFlying() const
@@ -2271,6 +2253,9 @@ void Object::polymorphObject(const PRO_REF profileID, const SKIN_T newSkin)
     _profileID = profileID;
     _profile = ProfileSystem::get().getProfile(_profileID);
 
+    //Perks of the new form
+    updatePerks();
+
     //Exit stealth if we change form
     deactivateStealth();
 
@@ -2287,7 +2272,7 @@ void Object::polymorphObject(const PRO_REF profileID, const SKIN_T newSkin)
         if ( isMount() )
         {
             leftItem->vel[kZ]    = DISMOUNTZVEL;
-            leftItem->jump_timer = JUMPDELAY;
+            leftItem->setTimer(&Object::jump_timer, JUMPDELAY);
             leftItem->movePosition(0.0f, 0.0f, DISMOUNTZVEL);
         }
     }
@@ -2301,7 +2286,7 @@ void Object::polymorphObject(const PRO_REF profileID, const SKIN_T newSkin)
         if ( isMount() )
         {
             rightItem->vel[kZ]    = DISMOUNTZVEL;
-            rightItem->jump_timer = JUMPDELAY;
+            rightItem->setTimer(&Object::jump_timer, JUMPDELAY);
             rightItem->movePosition(0.0f, 0.0f, DISMOUNTZVEL);
         }
     }
@@ -2341,7 +2326,7 @@ void Object::polymorphObject(const PRO_REF profileID, const SKIN_T newSkin)
     canuseplatforms = _profile->canUsePlatforms();
     isitem          = _profile->isItem();
     invictus        = _profile->isInvincible();
-    jump_timer      = JUMPDELAY;
+    setTimer(&Object::jump_timer, JUMPDELAY);
     reaffirm_damagetype = _profile->getReaffirmDamageType();
 
     //Physics
@@ -2802,7 +2787,7 @@ void Object::dropMoney(int amount)
 
     // Give the character a time-out from interacting with particles so it
     // doesn't just grab the money again
-    damage_timer = DAMAGETIME;
+    setTimer(&Object::damage_timer, DAMAGETIME);
 
     // count and spawn the various denominations
     for (size_t cnt = 0; amount > 0 && cnt < vals.size(); cnt++)
@@ -2982,6 +2967,95 @@ void Object::resetBoredTimer()
     bore_timer = Random::next<uint16_t>(250, 800);
 }
 
+uint32_t Object::getTimer(uint32_t Object::*timer) const
+{
+    const uint32_t deadline = this->*timer;
+    if(0 == deadline) {
+        return 0;
+    }
+
+    //A timer on hold in the update frame it should have ended is ended by a later update
+    const uint32_t now = _currentModule->getTimers().getTime();
+    return deadline > now ? deadline - now : 1;
+}
+
+void Object::setTimer(uint32_t Object::*timer, uint32_t frames)
+{
+    if(0 == frames) {
+        this->*timer = 0;
+        return;
+    }
+
+    //The time of the timer wheel is the update frame of the last update of all objects
+    const uint32_t deadline = _currentModule->getTimers().getTime() + frames;
+
+    //The event of a running timer which does not end earlier now moves to the new end itself
+    const bool scheduled = 0 != this->*timer && this->*timer <= deadline;
+    this->*timer = deadline;
+    if(!scheduled) {
+        scheduleTimer(timer, deadline);
+    }
+}
+
+void Object::scheduleTimer(uint32_t Object::*timer, uint32_t deadline)
+{
+    const ObjectRef ref = getObjRef();
+    _currentModule->getTimers().schedule(deadline, [ref, timer]() {
+        Object *object = _currentModule->getObjectHandler().get(ref);
+        if(object) {
+            object->expireTimer(timer);
+        }
+    });
+}
+
+void Object::expireTimer(uint32_t Object::*timer)
+{
+    uint32_t &deadline = this->*timer;
+
+    //Stopped
+    if(0 == deadline) {
+        return;
+    }
+
+    //Restarted or moved by updateTimer()
+    const uint32_t now = _currentModule->getTimers().getTime();
+    if(deadline > now) {
+        scheduleTimer(timer, deadline);
+        return;
+    }
+
+    //Counts down its last update frame later
+    if(isTimerOnHold(timer)) {
+        scheduleTimer(timer, now + 1);
+        return;
+    }
+
+    deadline = 0;
+}
+
+bool Object::isTimerOnHold(uint32_t Object::*timer) const
+{
+    //Items inside an inventory are not updated
+    if(isInsideInventory()) {
+        return true;
+    }
+
+    //The jump timer only counts down while we could jump
+    if(&Object::jump_timer == timer) {
+        return !(isBeingHeld() || _objectPhysics.isTouchingGround() || jumpnumber > 0);
+    }
+
+    return false;
+}
+
+void Object::updateTimer(uint32_t Object::*timer)
+{
+    //A timer ending in this update frame was already checked by its event
+    if(this->*timer > _currentModule->getTimers().getTime() && isTimerOnHold(timer)) {
+        this->*timer += 1;
+    }
+}
+
 const std::shared_ptr<const Ego::Texture> Object::getSkinTexture() const
 {
     return getProfile()->getSkin(this->skin).get_ptr();
@@ -3011,7 +3085,7 @@ void Object::updateLatchButtons()
             detatchFromHolder(true, true);
             getObjectPhysics().detachFromPlatform();
 
-            jump_timer = Object::JUMPDELAY;
+            setTimer(&Object::jump_timer, Object::JUMPDELAY);
             if ( isFlying() )
             {
                 vel.z() += Object::DISMOUNTZVEL / 3.0f;
@@ -3044,11 +3118,11 @@ void Object::updateLatchButtons()
                 // Make the character jump
                 float jumpPower = getAttribute(Ego::Attribute::JUMP_POWER);
                 hitready = true;
-                jump_timer = Object::JUMPDELAY;
+                setTimer(&Object::jump_timer, Object::JUMPDELAY);
 
                 //To prevent 'bunny jumping' in water
                 if (isSubmerged() || getObjectPhysics().floorIsSlippy()) {
-                    jump_timer *= hasPerk(Ego::Perks::ATHLETICS) ? 2 : 4;       
+                    setTimer(&Object::jump_timer, getTimer(&Object::jump_timer) * (hasPerk(Ego::Perks::ATHLETICS) ? 2 : 4));
                     jumpPower *= 0.5f;
                 }
 
@@ -3074,18 +3148,18 @@ void Object::updateLatchButtons()
     }
     if ( _inputLatchesPressed[LATCHBUTTON_PACKLEFT] && inst.canBeInterrupted() && 0 == reload_timer )
     {
-        reload_timer = Inventory::PACKDELAY;
+        setTimer(&Object::reload_timer, Inventory::PACKDELAY);
         Inventory::swap_item( ichr, getInventory().getFirstFreeSlotNumber(), SLOT_LEFT, false );
     }
     if ( _inputLatchesPressed[LATCHBUTTON_PACKRIGHT] && inst.canBeInterrupted() && 0 == reload_timer )
     {
-        reload_timer = Inventory::PACKDELAY;
+        setTimer(&Object::reload_timer, Inventory::PACKDELAY);
         Inventory::swap_item( ichr, getInventory().getFirstFreeSlotNumber(), SLOT_RIGHT, false );
     }
 
     if ( _inputLatchesPressed[LATCHBUTTON_ALTLEFT] && inst.canBeInterrupted() && 0 == reload_timer )
     {
-        reload_timer = GRABDELAY;
+        setTimer(&Object::reload_timer, GRABDELAY);
         if ( !getLeftHandItem() )
         {
             // Grab left
@@ -3106,7 +3180,7 @@ void Object::updateLatchButtons()
 
     if (_inputLatchesPressed[LATCHBUTTON_ALTRIGHT] && inst.canBeInterrupted() && 0 == reload_timer)
     {
-        reload_timer = GRABDELAY;
+        setTimer(&Object::reload_timer, GRABDELAY);
         if ( !getRightHandItem() )
         {
             // Grab right
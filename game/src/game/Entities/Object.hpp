@@ -28,6 +28,7 @@
 
 #include "egolib/Script/script.h"
 #include "egolib/Logic/Team.hpp"
+#include "egolib/Logic/AttributeSet.hpp"
 #include "egolib/InputControl/InputDevice.hpp"
 
 #include "game/egoboo.h"
@@ -105,7 +106,7 @@ public:
     static constexpr int SIZETIME = 100;                    //< Time it takes to resize a character
     static constexpr uint16_t MAXMONEY = 9999;              ///< Maximum money a character can carry
     static constexpr float DROPZVEL = 7;                    //< Vertical velocity of dropped items
-    static constexpr uint8_t JUMPINFINITE = 255;            ///< Flying character TODO> deprecated?
+    static constexpr uint8_t JUMPINFINITE = Ego::AttributeSet::JUMPINFINITE; ///< Flying character TODO> deprecated?
     static constexpr uint8_t JUMPDELAY = 20;                ///< Time between jumps (game updates)
     static constexpr uint32_t PHYS_DISMOUNT_TIME = 50;      ///< time delay for full object-object interaction (approximately 1 second)
     static constexpr float DISMOUNTZVEL = 12;               //< Vertical velocity when jumping off mounts
@@ -575,6 +576,8 @@ public:
     * @brief
     *   Get total value for the specified attribute. Includes bonuses from Enchants, Perks
     *   and other active boni or penalties.
+    * @remark
+    *   The total values are resolved whenever one of their inputs changes, so this is an array load.
     **/
     float getAttribute(const Ego::Attribute::AttributeType type) const;
 
@@ -681,7 +684,29 @@ public:
     **/
     bool setSkin(const size_t skinNumber);
 
-    std::unordered_map<Ego::Attribute::AttributeType, float, std::hash<uint8_t>>& getTempAttributes();
+    /**
+    * @return
+    *   true if an Enchant has set or modified the specified attribute
+    **/
+    bool hasTempAttribute(const Ego::Attribute::AttributeType type) const;
+
+    /**
+    * @brief
+    *   Set the temporary value of the specified attribute (used by Enchants)
+    **/
+    void setTempAttribute(const Ego::Attribute::AttributeType type, float value);
+
+    /**
+    * @brief
+    *   Add a bonus (or penalty if negative) to the temporary value of the specified attribute (used by Enchants)
+    **/
+    void increaseTempAttribute(const Ego::Attribute::AttributeType type, float value);
+
+    /**
+    * @brief
+    *   Remove the temporary value of the specified attribute (used by Enchants)
+    **/
+    void removeTempAttribute(const Ego::Attribute::AttributeType type);
 
     std::shared_ptr<Ego::Enchantment> getLastEnchantmentSpawned() const;
 
@@ -808,6 +833,28 @@ public:
     **/
     void resetBoredTimer();
 
+    /**
+    * @brief
+    *   Get the number of update frames until a timer of this Object ends
+    * @param timer
+    *   &Object::reload_timer, &Object::damage_timer or &Object::jump_timer. The member itself
+    *   is 0 if the timer is not running and the update frame in which it ends otherwise
+    * @return
+    *   the number of update frames or 0 if the timer is not running
+    **/
+    uint32_t getTimer(uint32_t Object::*timer) const;
+
+    /**
+    * @brief
+    *   Start or stop a timer of this Object. The timer is not counted down every update,
+    *   it ends with an event of the timer wheel of the module
+    * @param timer
+    *   &Object::reload_timer, &Object::damage_timer or &Object::jump_timer
+    * @param frames
+    *   the number of update frames until the timer ends, 0 stops the timer
+    **/
+    void setTimer(uint32_t Object::*timer, uint32_t frames);
+
     void resetInputCommands();
 
     /**
@@ -847,6 +894,51 @@ private:
 
     void updateLatchButtons();
 
+    /**
+    * @brief
+    *   Checks if this Object looks for hidden enemies in this update loop
+    **/
+    bool isLookingForHiddenObjects() const;
+
+    /**
+    * @brief
+    *   Checks if a target is a stealthed enemy which is in the line of sight of this Object
+    **/
+    bool isHiddenObjectInSight(const Object &target) const;
+
+    /**
+    * @brief
+    *   Schedule the event which ends a timer of this Object in an update frame
+    **/
+    void scheduleTimer(uint32_t Object::*timer, uint32_t deadline);
+
+    /**
+    * @brief
+    *   Ends a timer of this Object when its event is delivered, unless it was restarted,
+    *   stopped or is on hold
+    **/
+    void expireTimer(uint32_t Object::*timer);
+
+    /**
+    * @brief
+    *   Checks if a timer of this Object does not count down in this update loop. Timers of
+    *   items inside an inventory are on hold, like the jump timer while the Object can not jump
+    **/
+    bool isTimerOnHold(uint32_t Object::*timer) const;
+
+    /**
+    * @brief
+    *   Moves the end of a running timer of this Object one update frame later if it is on hold
+    **/
+    void updateTimer(uint32_t Object::*timer);
+
+    /**
+    * @brief
+    *   Hand the Perks known by this Object and the Perks of its profile to the attributes.
+    *   Must be called after a Perk or the profile of this Object changed.
+    **/
+    void updatePerks();
+
 public:
     chr_spawn_data_t  spawn_data;
 
@@ -876,7 +968,7 @@ public:
     int16_t        fat_goto_time;                 ///< Time left in size change
 
     // jump stuff
-    uint8_t          jump_timer;                    ///< Delay until next jump
+    uint32_t         jump_timer;                    ///< Delay until next jump (see getTimer())
     uint8_t          jumpnumber;                    ///< Number of jumps remaining
     bool             jumpready;                     ///< For standing on a platform character
 
@@ -915,8 +1007,8 @@ public:
     int16_t         daze_timer;                    ///< Daze timer
     int16_t         bore_timer;                    ///< Boredom timer
     uint8_t         careful_timer;                 ///< "You hurt me!" timer
-    uint16_t        reload_timer;                  ///< Time before another shot
-    uint8_t         damage_timer;                  ///< Invincibility timer
+    uint32_t        reload_timer;                  ///< Time before another shot (see getTimer())
+    uint32_t        damage_timer;                  ///< Invincibility timer (see getTimer())
 
     // graphical info
     bool         draw_icon;       ///< Show the icon?
@@ -986,8 +1078,7 @@ private:
     //Attributes
     float _currentLife;
     float _currentMana;
-    std::array<float, Ego::Attribute::NR_OF_ATTRIBUTES> _baseAttribute; ///< Character attributes
-    std::unordered_map<Ego::Attribute::AttributeType, float, std::hash<uint8_t>> _tempAttribute; ///< Character attributes with enchants
+    Ego::AttributeSet _attributes;                       ///< Character attributes with enchants and Perks
 
     Inventory _inventory;
     uint16_t  _money;                                    ///< Money
@@ -33,21 +33,32 @@ bool INGAME_PCHR(const Object *pobj)
     return (nullptr != pobj) && !pobj->isTerminated();
 }
 
+const size_t ObjectHandler::SLOT_BITS;
+const size_t ObjectHandler::SLOT_MASK;
+
 ObjectHandler::ObjectHandler() :
-	_internalCharacterList(),
+    _slots(),
+    _freeSlots(),
     _iteratorList(),
     _allocateList(),
 
     _semaphore(0),
     _deletedCharacters(0),
-    _totalCharactersSpawned(0),
-    _dynamicObjects(),
-    _staticObjects(),
-    _updateStaticTreeClock(0)
+    _spatialGrid(Info<float>::Block::Size())
 {
     _iteratorList.reserve(OBJECTS_MAX);
 }
 
+const std::shared_ptr<Object>& ObjectHandler::find(ObjectRef ref) const
+{
+    // ObjectRef::Invalid never matches, it is not handed out to any slot.
+    const size_t slot = getSlot(ref);
+    if (slot >= _slots.size() || _slots[slot].ref != ref) {
+        return Object::INVALID_OBJECT;
+    }
+    return _slots[slot].object;
+}
+
 bool ObjectHandler::remove(ObjectRef ref) {
 	if (!exists(ref)) {
 		return false;
@@ -57,32 +68,26 @@ bool ObjectHandler::remove(ObjectRef ref) {
 	chr_log_script_time(ref.get());
 #endif
 
+	const std::shared_ptr<Object> object = find(ref);
+
 	//Remove us from any holder first
-	_internalCharacterList[ref]->detatchFromHolder(true, false);
+	object->detatchFromHolder(true, false);
 
 	// If we are inside a list loop, do not actually change the length of the
 	// list. Else this can cause some problems later.
-	_internalCharacterList[ref]->_terminateRequested = true; //bad: private access
+	object->_terminateRequested = true; //bad: private access
 	_deletedCharacters++;
 
-	// We can safely modify the map, it is not iterable from the outside.
-	_internalCharacterList.erase(ref);
+	// The reference becomes stale now, but the slot is only reused once the
+	// object was removed from the iterator list (see maybeRunDeferred()).
+	_slots[getSlot(ref)].object = nullptr;
 
 	return true;
 }
 
 bool ObjectHandler::exists(ObjectRef ref) const {
-	if (ref == ObjectRef::Invalid || ref.get() >= _totalCharactersSpawned) {
-		return false;
-	}
-
-	// Check if object exists in map.
-	const auto& result = _internalCharacterList.find(ref);
-	if (result == _internalCharacterList.end()) {
-		return false;
-	}
-
-	return !(*result).second->isTerminated();
+	const std::shared_ptr<Object>& object = find(ref);
+	return nullptr != object && !object->isTerminated();
 }
 
 std::shared_ptr<Object> ObjectHandler::insert(const PRO_REF profileRef, ObjectRef overrideRef)
@@ -100,31 +105,69 @@ std::shared_ptr<Object> ObjectHandler::insert(const PRO_REF profileRef, ObjectRe
 	}
 
 	ObjectRef objRef = ObjectRef::Invalid;
+	size_t slot;
 
 	if (ObjectRef::Invalid != overrideRef) {
-		if (!exists(overrideRef)) {
-			objRef = overrideRef;
-		} else {
+		if (exists(overrideRef)) {
 			Log::get() << Log::Entry::create(Log::Level::Warning, __FILE__, __LINE__, "failed to override a object ", overrideRef.get(), ": object already spawned", Log::EndOfEntry);
 			return nullptr;
 		}
+		slot = getSlot(overrideRef);
+		if (slot >= SLOT_MASK) {
+			Log::get() << Log::Entry::create(Log::Level::Warning, __FILE__, __LINE__, "failed to override a object ", overrideRef.get(), ": invalid object reference", Log::EndOfEntry);
+			return nullptr;
+		}
+		while (_slots.size() <= slot) {
+			_freeSlots.push_back(_slots.size());
+			_slots.push_back({ObjectRef(_slots.size()), nullptr});
+		}
+
+		// The slot must be free, i.e. not used by another object and not waiting for
+		// a removed object to leave the iterator list. This is rare, so a linear search is fine.
+		auto it = std::find(_freeSlots.begin(), _freeSlots.end(), slot);
+		if (it == _freeSlots.end()) {
+			Log::get() << Log::Entry::create(Log::Level::Warning, __FILE__, __LINE__, "failed to override a object ", overrideRef.get(), ": object slot in use", Log::EndOfEntry);
+			return nullptr;
+		}
+		_freeSlots.erase(it);
+
+		// References to earlier objects of the slot must stay stale, the generation only grows.
+		objRef = overrideRef;
+		if ((objRef.get() >> SLOT_BITS) <= (_slots[slot].ref.get() >> SLOT_BITS)) {
+			objRef = nextGeneration(_slots[slot].ref);
+		}
 	}
 	// No override specified, generate new reference.
+	else if (!_freeSlots.empty())
+	{
+		// Reuse a slot with the next generation.
+		slot = _freeSlots.back();
+		_freeSlots.pop_back();
+		objRef = nextGeneration(_slots[slot].ref);
+	}
 	else
 	{
-		// Increment counter.
-		objRef = ObjectRef(_totalCharactersSpawned++);
+		// Append a new slot.
+		slot = _slots.size();
+		if (slot >= SLOT_MASK) {
+			Log::get() << Log::Entry::create(Log::Level::Warning, __FILE__, __LINE__, "no free object slots available", Log::EndOfEntry);
+			return nullptr;
+		}
+		objRef = ObjectRef(slot);
+		_slots.push_back({objRef, nullptr});
 	}
 
 	if (ObjectRef::Invalid != objRef) {
 		const std::shared_ptr<Object> objPtr = std::make_shared<Object>(profileRef, objRef);
 		if (!objPtr) {
             Log::get() << Log::Entry::create(Log::Level::Warning, __FILE__, __LINE__, "unable to create object", Log::EndOfEntry);
+			_freeSlots.push_back(slot);
 			return nullptr;
 		}
 
-		// Allocate the new one (we can safely modify the internal map, it isn't iterable from outside).
-		_internalCharacterList[objRef] = objPtr;
+		// Allocate the new one (we can safely modify the slots, they are not iterable from outside).
+		_slots[slot].ref = objRef;
+		_slots[slot].object = objPtr;
 
 		// Wait to adding it to the iterable list.
 		_allocateList.push_back(objPtr);
@@ -134,42 +177,32 @@ std::shared_ptr<Object> ObjectHandler::insert(const PRO_REF profileRef, ObjectRe
 	return nullptr;
 }
 
-Object *ObjectHandler::get(ObjectRef ref) const {
-	if (ref == ObjectRef::Invalid || ref.get() >= _totalCharactersSpawned) {
-		return nullptr;
-	}
-
-	// Check if object exists in map.
-	const auto& result = _internalCharacterList.find(ref);
-	if (result == _internalCharacterList.end()) {
-		return nullptr;
+ObjectRef ObjectHandler::nextGeneration(ObjectRef last)
+{
+	ObjectRef ref = ObjectRef(last.get() + (size_t(1) << SLOT_BITS));
+	if (ObjectRef::Invalid == ref) {
+		ref = ObjectRef(ref.get() + (size_t(1) << SLOT_BITS));
 	}
+	return ref;
+}
 
-	return (*result).second.get();
+Object *ObjectHandler::get(ObjectRef ref) const {
+	return find(ref).get();
 }
 
 const std::shared_ptr<Object>& ObjectHandler::operator[] (ObjectRef ref)
 {
-	if (ref == ObjectRef::Invalid || ref.get() >= _totalCharactersSpawned) {
-		return Object::INVALID_OBJECT;
-	}
-
-	// Check if object exists in map.
-	const auto& result = _internalCharacterList.find(ref);
-	if (result == _internalCharacterList.end()) {
-		return Object::INVALID_OBJECT;
-	}
-
-	return (*result).second;
+	return find(ref);
 }
 
 void ObjectHandler::clear()
 {
-	_internalCharacterList.clear();
+	_slots.clear();
+	_freeSlots.clear();
 	_iteratorList.clear();
-    _dynamicObjects.clear(0, 0, 0, 0);
+	_allocateList.clear();
+    _spatialGrid.reset(0, 0, 0, 0);
     _deletedCharacters = 0;
-    _totalCharactersSpawned = 0;
 }
 
 void ObjectHandler::lock()
@@ -240,6 +273,8 @@ void ObjectHandler::maybeRunDeferred()
                 {
                     //Delete this character
                     _deletedCharacters--;
+                    _spatialGrid.remove(getSlot(element->getObjRef()), element.get());
+                    _freeSlots.push_back(getSlot(element->getObjRef()));
 
                     // Make sure everyone knows it died
                     for (const std::shared_ptr<Object>& chr : _iteratorList)
@@ -298,48 +333,43 @@ size_t ObjectHandler::getObjectCount() const
     return _iteratorList.size() + _allocateList.size() - _deletedCharacters;
 }
 
-void ObjectHandler::updateQuadTree(float minX, float minY, float maxX, float maxY)
+void ObjectHandler::updateSpatialGrid(float minX, float minY, float maxX, float maxY)
 {
-    //Reset quad-tree
-    _dynamicObjects.clear(minX, minY, maxX, maxY);
-
-    //Rebuild the static quad tree only once per second
-    bool updateStaticQuadTree = false;
-    if(_updateStaticTreeClock <= 0) {
-        _updateStaticTreeClock = ONESECOND;
-        updateStaticQuadTree = true;
-        _staticObjects.clear(minX, minY, maxX, maxY);
-    }
-    else {
-        _updateStaticTreeClock--;
+    //Start over if the level size changed
+    if(!_spatialGrid.hasBounds(minX, minY, maxX, maxY)) {
+        _spatialGrid.reset(minX, minY, maxX, maxY);
     }
 
-    //Rebuild quad-tree
+    //Move objects that changed cell
     for(const std::shared_ptr<Object> &object : _iteratorList) {
         //Do not add objects that cannot interact with the rest of the world
-        if(object->isTerminated() || object->isHidden()) continue;
-
-        if(object->isScenery()) {
-            if(updateStaticQuadTree) {
-                _staticObjects.insert(object);
-            }
-        }
-        else {
-            _dynamicObjects.insert(object);
+        if(object->isTerminated() || object->isHidden()) {
+            _spatialGrid.remove(getSlot(object->getObjRef()), object.get());
+            continue;
         }
+
+        _spatialGrid.update(getSlot(object->getObjRef()), object);
     }
 }
 
 std::vector<std::shared_ptr<Object>> ObjectHandler::findObjects(const float x, const float y, const float distance, bool includeSceneryObjects) const { 
     std::vector<std::shared_ptr<Object>> result;
 	AxisAlignedBox2f searchArea = AxisAlignedBox2f(Point2f(x-distance, y-distance), Point2f(x+distance, y+distance));
-    _dynamicObjects.find(searchArea, result);
-    if(includeSceneryObjects) _staticObjects.find(searchArea, result);
+    findObjects(searchArea, result, includeSceneryObjects);
     return result;
 }
 
+bool ObjectHandler::isScenery(const Object &object)
+{
+    return object.isScenery();
+}
+
 void ObjectHandler::findObjects(const AxisAlignedBox2f &searchArea, std::vector<std::shared_ptr<Object>> &result, bool includeSceneryObjects) const
 {
-    if(includeSceneryObjects) _staticObjects.find(searchArea, result);
-    return _dynamicObjects.find(searchArea, result);
+    if(includeSceneryObjects) {
+        _spatialGrid.find(searchArea, result);
+    }
+    else {
+        _spatialGrid.find(searchArea, result, [](const std::shared_ptr<Object> &object) { return !object->isScenery(); });
+    }
 }
@@ -27,7 +27,7 @@
 #endif
 
 #include "game/egoboo.h"
-#include "egolib/Core/QuadTree.hpp"
+#include "egolib/Core/LooseGrid.hpp"
 
 //Forward declarations
 class Object;
@@ -150,11 +150,20 @@ public:
 	 */
 	Object *get(ObjectRef ref) const;
 
+	/**
+	 * @brief
+	 *	Get the storage slot of an object reference. Slots are dense and reused once a removed
+	 *	object has left the iterator list, so they can be used as keys of arrays (e.g. the spatial grid).
+	 *	At any time, at most one object in the iterator list has a given slot.
+	 * @return
+	 *	the storage slot of the object reference
+	 */
+	static size_t getSlot(ObjectRef ref) { return ref.get() & SLOT_MASK; }
+
 
 	/**
 	* @brief
-	*	Find all elements that are within range of a specified point in this QuadTree's
-	*	bounding box
+	*	Find all elements that are within range of a specified point
 	* @param x
 	*	x position of point to search from
 	* @param y
@@ -182,12 +191,50 @@ public:
 
 	/**
 	* @brief
-	* 	Clear and rebuild the quad tree for this update frame
+	*	Visit all objects that collide with a 2D bounding box area. Unlike findObjects(),
+	*	this does not allocate memory and does not copy any std::shared_ptr. Each object
+	*	is visited at most once. Safe to call from several threads at the same time.
+	*	The caller must hold an iterator() so no object is removed while visiting.
+	* @param searchArea
+	*	The bounding box to scan
+	* @param includeSceneryObjects
+	*	if true, it will also include Scenery objects in the search as defined by Object::isScenery()
+	* @param visitor
+	*	function object called with a reference to each object (<tt>Object&</tt>)
+	**/
+	template<typename Visitor>
+	void visitObjects(const AxisAlignedBox2f &searchArea, bool includeSceneryObjects, Visitor visitor) const
+	{
+		if(includeSceneryObjects) {
+			_spatialGrid.visit(searchArea, visitor);
+		}
+		else {
+			_spatialGrid.visit(searchArea, [&visitor](Object &object) {
+				if(!isScenery(object)) visitor(object);
+			});
+		}
+	}
+
+	/**
+	* @brief
+	*	Visit all objects that are within range of a specified point
+	* @see visitObjects(const AxisAlignedBox2f&, bool, Visitor)
+	**/
+	template<typename Visitor>
+	void visitObjects(const float x, const float y, const float distance, bool includeSceneryObjects, Visitor visitor) const
+	{
+		visitObjects(AxisAlignedBox2f(Point2f(x-distance, y-distance), Point2f(x+distance, y+distance)), includeSceneryObjects, visitor);
+	}
+
+	/**
+	* @brief
+	* 	Update the spatial grid for this update frame. Only objects which changed cell
+	*	since the last update are moved, the grid is rebuilt only if the bounds change.
 	*	This function is NOT thread-safe
 	* @param minX, minY, maxX, maxY
-	*	Sets the bounds of this quad tree (size of the entire current level)
+	*	Sets the bounds of the spatial grid (size of the entire current level)
 	**/
-	void updateQuadTree(float minX, float minY, float maxX, float maxY);
+	void updateSpatialGrid(float minX, float minY, float maxX, float maxY);
 
 	/**
 	* @return
@@ -222,12 +269,49 @@ private:
 	void dumpAllocateList();
 #endif
 
+	/**
+	 * @brief
+	 *	Object::isScenery() for the visitObjects() templates, Object is incomplete in this header.
+	 */
+	static bool isScenery(const Object &object);
+
+	/**
+	 * @brief
+	 *	Look up the object in the slot of the object reference.
+	 * @return
+	 *	the object or Object::INVALID_OBJECT if the slot was reused or its object was removed
+	 */
+	const std::shared_ptr<Object>& find(ObjectRef ref) const;
+
 private:
-	Ego::QuadTree<Object> _dynamicObjects;			//Objects that can move (Creatures, moving platforms, etc.)
-	Ego::QuadTree<Object> _staticObjects;			//Objects that rarely move - if ever (Trees, pillars, chairs)
-	int _updateStaticTreeClock;
+	/**
+	 * @brief
+	 *	An object reference is the slot of the object in its low SLOT_BITS bits and
+	 *	the generation of that slot in the remaining bits. The generation is incremented
+	 *	each time a slot is reused, so stale object references are detected.
+	 */
+	static const size_t SLOT_BITS = 16;
+	static const size_t SLOT_MASK = (size_t(1) << SLOT_BITS) - 1;
+
+	struct Slot
+	{
+		ObjectRef ref;					///< Object reference of the current (or last) object in this slot
+		std::shared_ptr<Object> object;	///< The object or nullptr if it was removed
+	};
+
+	/**
+	 * @brief
+	 *	Get the object reference of the next generation of a slot.
+	 * @param last
+	 *	the object reference of the last object in the slot
+	 */
+	static ObjectRef nextGeneration(ObjectRef last);
 
-	std::unordered_map<ObjectRef, std::shared_ptr<Object>> _internalCharacterList; ///< Maps object references to shared pointers to objects
+	Ego::LooseGrid<Object> _spatialGrid;			//All objects that can interact with the world, keyed on their slot
+
+	// A deque: operator[] and find() return references into the slots, they must stay valid when slots are added.
+	std::deque<Slot> _slots;											///< Objects indexed by the slot of their object reference
+	std::vector<size_t> _freeSlots;										///< Slots which can be reused
 	std::vector<std::shared_ptr<Object>> _iteratorList;					///< For iterating, contains only valid objects (unsorted)
 
 	std::vector<std::shared_ptr<Object>> _allocateList;					///< List of all objects that should be added
@@ -235,7 +319,5 @@ private:
 	size_t _semaphore;
 	size_t _deletedCharacters;
 
-	size_t _totalCharactersSpawned;										///< Total count of characters spawned (includes removed)
-
 	friend class ObjectIterator;
 };
@@ -35,7 +35,14 @@ namespace Ego
 {
 const std::shared_ptr<Particle> Particle::INVALID_PARTICLE = nullptr;
 
-Particle::Particle() :
+Particle::Particle(ParticleHotData& hotData, size_t slot) :
+    PhysicsData(hotData.velocity[slot]),
+    Collidable(hotData.position[slot]),
+    size(hotData.size[slot]),
+    size_add(hotData.size_add[slot]),
+    alpha(hotData.alpha[slot]),
+    lifetime_end(hotData.lifetime_end[slot]),
+    _slot(slot),
     _particleID(),
     _particlePhysics(*this),
     _collidedObjects(),
@@ -84,13 +91,14 @@ void Particle::reset(ParticleRef ref)
     size_stt = 0;
     size = 0;
     size_add = 0;
+    alpha = 0.0f;
 
     _image.reset();
 
     // "no lifetime" = "eternal"
     is_eternal = false;
     lifetime_total = std::numeric_limits<size_t>::max();
-    lifetime_remaining = lifetime_total;
+    lifetime_end = 0;
     frames_total = std::numeric_limits<size_t>::max();
     frames_remaining = frames_total;
 
@@ -295,6 +303,10 @@ void Particle::update()
 
     // If the particle is hidden, there is nothing else to do.
     if(isHidden()) {
+        //Its lifetime is on hold
+        if(!is_eternal) {
+            lifetime_end++;
+        }
         return;
     }
 
@@ -339,17 +351,7 @@ void Particle::update()
     //Damage whomever we are attached to
     updateAttachedDamage();
 
-    // down the remaining lifetime of the particle
-    if (!is_eternal)
-    {
-        if (lifetime_remaining > 0) {
-            lifetime_remaining--;
-        }
-        else {
-            //end of life
-            requestTerminate();
-        }
-    }
+    //The end of the lifetime is an event of the timer wheel, see startLifetime()
 }
 
 void Particle::updateWater()
@@ -729,6 +731,11 @@ void Particle::destroy()
 }
 
 void Particle::playSound(int8_t sound)
+{
+    playSound(sound, getPosition());
+}
+
+void Particle::playSound(int8_t sound, const Vector3f& position)
 {
     //Invalid sound?
     if(sound < 0) {
@@ -738,14 +745,14 @@ void Particle::playSound(int8_t sound)
     //If we were spawned by an Object, then use that Object's sound pool
     const std::shared_ptr<ObjectProfile> &profile = ProfileSystem::get().getProfile(_spawnerProfile);
     if (profile) {
-        AudioSystem::get().playSound(getPosition(), profile->getSoundID(sound));
+        AudioSystem::get().playSound(position, profile->getSoundID(sound));
     }
 
     //Else we are a global particle and use global particle sounds
     else if (sound >= 0 && sound < GSND_COUNT)
     {
         GlobalSound globalSound = static_cast<GlobalSound>(sound);
-        AudioSystem::get().playSound(getPosition(), AudioSystem::get().getGlobalSound(globalSound));
+        AudioSystem::get().playSound(position, AudioSystem::get().getGlobalSound(globalSound));
     }
 }
 
@@ -1035,7 +1042,6 @@ bool Particle::initialize(const ParticleRef particleID, const Vector3f& spawnPos
 
     // make the particle exists for AT LEAST one update
     lifetime_total = std::max<size_t>(1, lifetime_total);
-    lifetime_remaining = lifetime_total;
 
     // set the frame counters
     // make the particle display AT LEAST one frame, regardless of how many updates
@@ -1065,11 +1071,11 @@ bool Particle::initialize(const ParticleRef particleID, const Vector3f& spawnPos
     }
 
     // set up the particle transparency
-    inst.alpha = 0xFF;
+    alpha = 0xFF;
     switch (inst.type)
     {
         case SPRITE_SOLID: break;
-        case SPRITE_ALPHA: inst.alpha = 0x80; break;    //#define PRT_TRANS 0x80
+        case SPRITE_ALPHA: alpha = 0x80; break;    //#define PRT_TRANS 0x80
         case SPRITE_LIGHT: break;
     }
 
@@ -1133,7 +1139,7 @@ bool Particle::initialize(const ParticleRef particleID, const Vector3f& spawnPos
         "\tobjectProfile == %d(\"%s\")\n"
         "\n",
         _particleID,
-        update_wld, static_cast<int>(lifetime_remaining),
+        update_wld, static_cast<int>(lifetime_total),
         loc_chr_origin, _currentModule->getObjectHandler().exists( loc_chr_origin ) ? _currentModule->getObjectHandler().get(loc_chr_origin)->Name : "INVALID",
         _particleProfileID, getProfile()->getName().c_str(), 
         getProfile()->comment,
@@ -1286,6 +1292,52 @@ bool Particle::isEternal() const
     return is_eternal;
 }
 
+size_t Particle::getLifetimeRemaining() const
+{
+    //Not active yet
+    if(0 == lifetime_end) {
+        return lifetime_total;
+    }
+
+    const uint32_t now = _currentModule->getTimers().getTime();
+    return lifetime_end > now ? lifetime_end - now : 0;
+}
+
+void Particle::startLifetime(uint32_t firstUpdate)
+{
+    if(is_eternal) {
+        return;
+    }
+
+    //The particle gets lifetime_total updates, the event ends it before the next one
+    lifetime_end = firstUpdate + static_cast<uint32_t>(lifetime_total);
+    scheduleLifetimeEnd(lifetime_end);
+}
+
+void Particle::scheduleLifetimeEnd(uint32_t frame)
+{
+    const ParticleRef ref = _particleID;
+    _currentModule->getTimers().schedule(frame, [ref]() {
+        const std::shared_ptr<Particle> &particle = ParticleHandler::get()[ref];
+        if(particle) {
+            particle->expireLifetime();
+        }
+    });
+}
+
+void Particle::expireLifetime()
+{
+    //Moved by updates while hidden
+    const uint32_t now = _currentModule->getTimers().getTime();
+    if(lifetime_end > now) {
+        scheduleLifetimeEnd(lifetime_end);
+        return;
+    }
+
+    //end of life
+    requestTerminate();
+}
+
 bool Particle::canCollide() const
 {
     if(isTerminated()) {
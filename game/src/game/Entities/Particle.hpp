@@ -86,6 +86,33 @@ struct prt_environment_t
     }
 };
 
+/**
+ * @brief
+ *  The fields of all particles which are used in every update, one array per field indexed by
+ *  the storage slot of a particle. A particle refers to its entries, everything else is kept
+ *  in the particle itself.
+ */
+struct ParticleHotData
+{
+    explicit ParticleHotData(size_t capacity) :
+        position(capacity, Vector3f::zero()),
+        velocity(capacity, Vector3f::zero()),
+        size(capacity, 0),
+        size_add(capacity, 0),
+        alpha(capacity, 0.0f),
+        lifetime_end(capacity, 0)
+    {
+        //ctor
+    }
+
+    std::vector<Vector3f> position;         ///< Current position (Collidable::getPosition())
+    std::vector<Vector3f> velocity;         ///< Current velocity (PhysicsData::vel)
+    std::vector<UFP8_T> size;               ///< Particle::size
+    std::vector<SFP8_T> size_add;           ///< Particle::size_add
+    std::vector<float> alpha;               ///< Particle::alpha
+    std::vector<uint32_t> lifetime_end;     ///< Particle::lifetime_end
+};
+
 /**
  * @brief
  *  The definition of the particle entity.
@@ -93,7 +120,21 @@ struct prt_environment_t
 class Particle : public PhysicsData, public Id::NonCopyable, public Ego::Physics::Collidable
 {
 public:
-    Particle();
+    /**
+    * @brief
+    *   Construct the particle in a storage slot
+    * @param hotData
+    *   the hot data of all particles, the particle keeps its entries of it
+    * @param slot
+    *   the storage slot of the particle
+    **/
+    Particle(ParticleHotData& hotData, size_t slot);
+
+    /**
+    * @return
+    *   the storage slot of this Particle, the index of its entries in the hot data
+    **/
+    size_t getSlot() const { return _slot; }
 
     /**
     * @return
@@ -248,6 +289,12 @@ public:
     **/
     void playSound(int8_t soundID);
 
+    /**
+    * @brief
+    *   Same as playSound(int8_t) except that the sound is played at the specified position
+    **/
+    void playSound(int8_t soundID, const Vector3f& position);
+
     /**
     * @brief
     *   Sets wheter this Particle is control of its own motion and should
@@ -275,6 +322,12 @@ public:
     **/
     bool isEternal() const;
 
+    /**
+    * @return
+    *   the number of updates until this Particle times out
+    **/
+    size_t getLifetimeRemaining() const;
+
 
     /**
     * @author BB
@@ -319,7 +372,30 @@ public:
     **/
     void destroy();
 
+    /**
+    * @brief
+    *   Start counting down the lifetime of this Particle when it becomes active
+    * @param firstUpdate
+    *   the update frame of the first update of this Particle
+    * @note
+    *   Should only ever be used by the ParticleHandler! *Do not use*
+    **/
+    void startLifetime(uint32_t firstUpdate);
+
 private:
+    /**
+    * @brief
+    *   Schedule the event which ends the lifetime of this Particle
+    **/
+    void scheduleLifetimeEnd(uint32_t frame);
+
+    /**
+    * @brief
+    *   Ends this Particle when the event of its lifetime is delivered, unless it has been
+    *   moved by hidden updates
+    **/
+    void expireLifetime();
+
     /**
      * @brief
      *  Handle the particle interaction with water
@@ -390,8 +466,10 @@ public:
     Facing          rotate_add;              ///< Rotation rate
 
     UFP8_T            size_stt;                ///< The initial size of particle (8.8 fixed point)
-    UFP8_T            size;                    ///< Size of particle (8.8 fixed point)
-    SFP8_T            size_add;                ///< Change in size (8.8 fixed point)
+    UFP8_T&           size;                    ///< Size of particle (8.8 fixed point), in the hot data
+    SFP8_T&           size_add;                ///< Change in size (8.8 fixed point), in the hot data
+
+    float&            alpha;                   ///< Base alpha, in the hot data
 
     /// The state of a 2D animation used for rendering the particle.
     AnimationLoop _image;
@@ -411,11 +489,11 @@ public:
     size_t lifetime_total;
     /**
      * @brief
-     *  The remaining lifetime in updates.
-     * @todo
-     *  Use a count-down timer.
+     *  The update frame in which the particle times out, 0 until it is active. It is not
+     *  counted down, an event of the timer wheel of the module ends the particle. Every
+     *  update the particle is hidden moves it one frame later. In the hot data.
      */
-    size_t lifetime_remaining;
+    uint32_t& lifetime_end;
 
     /**
     * @brief
@@ -473,6 +551,7 @@ public:
     Ego::prt_environment_t enviro;                  ///< the particle's environment
 
 private:
+    size_t _slot;                            ///< Storage slot
     ParticleRef _particleID;                 ///< Unique identifier
 
     //Collisions
@@ -24,6 +24,10 @@
 #include "game/Entities/ParticleHandler.hpp"
 #include "game/Entities/_Include.hpp"
 #include "egolib/Logic/Team.hpp"
+#include "game/Graphics/CameraSystem.hpp"
+#include "game/game.h"
+
+constexpr float ParticleHandler::EVICTION_DISTANCE;
 
 std::shared_ptr<Ego::Particle> ParticleHandler::spawnLocalParticle(const Vector3f& pos, const Facing& facing, const PRO_REF iprofile, const LocalParticleProfileRef& pip_index,
                                                                    const ObjectRef chr_attach, Uint16 vrt_offset, const TEAM_REF team,
@@ -120,6 +124,22 @@ std::shared_ptr<Ego::Particle> ParticleHandler::spawnParticle(const Vector3f& sp
     return particle;
 }
 
+std::shared_ptr<Ego::Particle> ParticleHandler::createStorage(Ego::ParticleHotData& hotData)
+{
+    std::allocator<Ego::Particle> allocator;
+    Ego::Particle *particles = allocator.allocate(PARTICLES_MAX);
+    for(size_t slot = 0; slot < PARTICLES_MAX; ++slot) {
+        new (particles + slot) Ego::Particle(hotData, slot);
+    }
+
+    return std::shared_ptr<Ego::Particle>(particles, [](Ego::Particle *particles) {
+        for(size_t slot = 0; slot < PARTICLES_MAX; ++slot) {
+            particles[slot].~Particle();
+        }
+        std::allocator<Ego::Particle>().deallocate(particles, PARTICLES_MAX);
+    });
+}
+
 std::shared_ptr<Ego::Particle> ParticleHandler::getFreeParticle(bool force)
 {
     std::shared_ptr<Ego::Particle> particle = Ego::Particle::INVALID_PARTICLE;
@@ -131,46 +151,29 @@ std::shared_ptr<Ego::Particle> ParticleHandler::getFreeParticle(bool force)
 
     //Is this a high priority particle? If so, replace a less important particle
     if(getCount() >= _maxParticles && force) {
-        bool spaceFreed = false;
 
-        //Find a pending particle first
-        for(size_t i = 0; i < _pendingParticles.size(); ++i) {
+        //Replace the least important active particle
+        if(!evictParticle()) {
 
-            //Do not replace other critical particles!
-            if(_pendingParticles[i]->getProfile()->force) {
-                continue;
-            }
-
-            //Just remove an unimportant particle that hasnt been activated yet
-            _pendingParticles[i]->requestTerminate();
-            spaceFreed = true;
-            break;
-        }
-
-        //Nothing cleared? Search active particles then
-        if(!spaceFreed) {
-            for(size_t i = 0; i < _activeParticles.size(); ++i) {
+            //Nothing cleared? Search pending particles then
+            for(size_t i = 0; i < _pendingParticles.size(); ++i) {
 
                 //Do not replace other critical particles!
-                if(_activeParticles[i]->getProfile()->force) {
+                if(_pendingParticles[i]->isTerminated() || _pendingParticles[i]->getProfile()->force) {
                     continue;
                 }
 
-                //Ignore terminated particles, we want to free something else
-                if(_activeParticles[i]->isTerminated()) {
-                    continue;
-                }
-
-                //Remove the first one found (oldest in the list)
-                _activeParticles[i]->requestTerminate();
+                //Just remove an unimportant particle that hasnt been activated yet
+                _pendingParticles[i]->requestTerminate();
                 break;
             }
         }
     }
 
-    //If we have no free particles in the memory pool but we are allowed to allocate new memory
-    if(_unusedPool.empty() && getCount() < _maxParticles) {
-        return std::make_shared<Ego::Particle>();
+    //If we have no free particles in the memory pool but there are particles left in the storage
+    if(_unusedPool.empty() && getCount() < _maxParticles && _storageUsed < PARTICLES_MAX) {
+        //Shares ownership of the storage, so the particle stays valid as long as someone refers to it
+        return std::shared_ptr<Ego::Particle>(_storage, _storage.get() + _storageUsed++);
     }
 
     //Get a free, unused particle from the particle pool
@@ -184,6 +187,81 @@ std::shared_ptr<Ego::Particle> ParticleHandler::getFreeParticle(bool force)
     return particle;
 }
 
+bool ParticleHandler::evictParticle()
+{
+    if(!_evictionOrderBuilt) {
+        buildEvictionOrder();
+    }
+
+    const auto byScore = [](const EvictionCandidate &a, const EvictionCandidate &b) { return a.score < b.score; };
+    while(!_evictionOrder.empty()) {
+        std::pop_heap(_evictionOrder.begin(), _evictionOrder.end(), byScore);
+        const EvictionCandidate candidate = _evictionOrder.back();
+        _evictionOrder.pop_back();
+
+        //Skip particles which were terminated or replaced by a new particle since the order was built
+        if(candidate.particle->isTerminated() || candidate.particle->getParticleID() != candidate.particleID) {
+            continue;
+        }
+
+        candidate.particle->requestTerminate();
+        return true;
+    }
+
+    return false;
+}
+
+void ParticleHandler::buildEvictionOrder()
+{
+    //Where the cameras are looking at
+    std::array<Vector3f, MAX_CAMERAS> cameraPositions;
+    size_t cameraCount = 0;
+    if(CameraSystem::get().isInitialized()) {
+        for(const std::shared_ptr<Camera> &camera : CameraSystem::get().getCameraList()) {
+            if(cameraCount == cameraPositions.size()) break;
+            cameraPositions[cameraCount++] = camera->getTrackPosition();
+        }
+    }
+
+    _evictionOrder.clear();
+    for(const std::shared_ptr<Ego::Particle> &particle : _activeParticles) {
+        //Do not replace other critical particles!
+        if(particle->isTerminated() || particle->getProfile()->force) {
+            continue;
+        }
+        _evictionOrder.push_back({getEvictionScore(*particle, cameraPositions.data(), cameraCount), particle->getParticleID(), particle.get()});
+    }
+
+    std::make_heap(_evictionOrder.begin(), _evictionOrder.end(), [](const EvictionCandidate &a, const EvictionCandidate &b) { return a.score < b.score; });
+    _evictionOrderBuilt = true;
+}
+
+float ParticleHandler::getEvictionScore(const Ego::Particle &particle, const Vector3f *cameraPositions, size_t cameraCount) const
+{
+    //Particles that deal damage, spawn something or seek a target matter to the game and are always
+    //kept longer than purely cosmetic particles (the other terms are both in [0, 1])
+    const bool cosmetic = 0 == particle.damage.base && 0 == particle.damage.rand && !particle.is_bumpspawn && !particle.isHoming()
+                       && Ego::Particle::SPAWNNOCHARACTER == particle.endspawn_characterstate;
+    float score = cosmetic ? 2.0f : 0.0f;
+
+    //Far from all cameras
+    if(cameraCount > 0) {
+        const Vector3f& position = _hotData.position[particle.getSlot()];
+        float distance = EVICTION_DISTANCE;
+        for(size_t i = 0; i < cameraCount; ++i) {
+            distance = std::min(distance, (position - cameraPositions[i]).length());
+        }
+        score += distance / EVICTION_DISTANCE;
+    }
+
+    //Nearly expired
+    if(!particle.isEternal()) {
+        score += 1.0f - static_cast<float>(particle.getLifetimeRemaining()) / static_cast<float>(particle.lifetime_total);
+    }
+
+    return score;
+}
+
 void ParticleHandler::download(egoboo_config_t& cfg) {
     setDisplayLimit(cfg.graphic_simultaneousParticles_max.getValue());
 }
@@ -216,6 +294,9 @@ void ParticleHandler::unlock()
 
     //All locks disengaged?
     if(_semaphoreLock == 0) {
+        //Effects of the parallel physics update (sounds)
+        _deferredCommands.execute();
+
         auto condition = [this](const std::shared_ptr<Ego::Particle> &particle) 
         {
             if(!particle->isTerminated()) {
@@ -233,18 +314,66 @@ void ParticleHandler::unlock()
         };
 
         //Remove dead particles from the active list and add them to the free pool
+        const size_t activeCount = _activeParticles.size();
         _activeParticles.erase(std::remove_if(_activeParticles.begin(), _activeParticles.end(), condition), _activeParticles.end());
+        const bool changed = activeCount != _activeParticles.size() || !_pendingParticles.empty();
+
+        //New particles are first updated by the next updateAllParticles(), their lifetime starts there
+        const uint32_t firstUpdate = _lastUpdateFrame == update_wld ? update_wld + 1 : update_wld;
+        for(const std::shared_ptr<Ego::Particle> &particle : _pendingParticles) {
+            particle->startLifetime(firstUpdate);
+        }
 
-        //Add new particles that are pending to be added
+        //Add new particles that are pending to be added, keeping the active list sorted by storage slot
+        //(the address in the storage) so every loop over the active particles streams through the storage
+        const auto bySlot = [](const std::shared_ptr<Ego::Particle> &a, const std::shared_ptr<Ego::Particle> &b) { return a.get() < b.get(); };
+        std::sort(_pendingParticles.begin(), _pendingParticles.end(), bySlot);
+        const size_t mergeFrom = _activeParticles.size();
         _activeParticles.insert(_activeParticles.end(), _pendingParticles.begin(), _pendingParticles.end());
+        std::inplace_merge(_activeParticles.begin(), _activeParticles.begin() + mergeFrom, _activeParticles.end(), bySlot);
         _pendingParticles.clear();
+
+        if(changed) {
+            updateAttachmentIndex();
+        }
+    }
+}
+
+void ParticleHandler::updateAttachmentIndex()
+{
+    _attachedParticles.clear();
+    for(const std::shared_ptr<Ego::Particle> &particle : _activeParticles) {
+        if(particle->getAttachedObjectID() != ObjectRef::Invalid) {
+            _attachedParticles.emplace_back(particle->getAttachedObjectID(), particle.get());
+        }
+    }
+
+    //Stable, so particles attached to the same object keep their order in the active list
+    std::stable_sort(_attachedParticles.begin(), _attachedParticles.end(),
+                     [](const std::pair<ObjectRef, Ego::Particle*> &a, const std::pair<ObjectRef, Ego::Particle*> &b) { return a.first < b.first; });
+}
+
+void ParticleHandler::updateSpatialHash(float minX, float minY, float maxX, float maxY)
+{
+    _spatialHash.clear(minX, minY, maxX, maxY);
+    for(const std::shared_ptr<Ego::Particle> &particle : _activeParticles) {
+        if(particle->isTerminated()) {
+            continue;
+        }
+        const Vector3f& position = _hotData.position[particle->getSlot()];
+        _spatialHash.insert(particle.get(), position.x(), position.y());
     }
+    _spatialHash.build();
 }
 
 void ParticleHandler::updateAllParticles()
 {
+    //Particles are added and removed after the iterator is released
+    ParticleIterator particles = iterator();
+    _lastUpdateFrame = update_wld;
+
     //Update every active particle
-    for(const std::shared_ptr<Ego::Particle> &particle : iterator())
+    for(const std::shared_ptr<Ego::Particle> &particle : particles)
     {
         if(particle->isTerminated()) {
             continue;
@@ -252,6 +381,41 @@ void ParticleHandler::updateAllParticles()
 
         particle->update();
     }
+
+    //Scores changed, the eviction order is built again if needed
+    _evictionOrder.clear();
+    _evictionOrderBuilt = false;
+}
+
+void ParticleHandler::updateAllPhysics()
+{
+    //Particles are added and removed after the iterator is released
+    ParticleIterator particles = iterator();
+    const auto first = particles.begin();
+    const size_t count = particles.end() - first;
+
+    //Update the particles which only change themselves in parallel
+    static const size_t GRAIN_SIZE = 64;
+    _deferredCommands.open();
+    Ego::Core::parallel_for(0, count, GRAIN_SIZE, [&first, this](size_t begin, size_t end) {
+        for(size_t i = begin; i < end; ++i) {
+            Ego::Physics::ParticlePhysics &physics = first[i]->getParticlePhysics();
+            if(!first[i]->isTerminated() && physics.isConcurrent()) {
+                physics.updatePhysicsConcurrent(_deferredCommands, i);
+            }
+        }
+    });
+    _deferredCommands.close();
+
+    //Homing particles and particles with a gravity pull are updated in order
+    for(size_t i = 0; i < count; ++i)
+    {
+        const std::shared_ptr<Ego::Particle> &particle = first[i];
+        if(particle->isTerminated() || particle->getParticlePhysics().isConcurrent()) {
+            continue;
+        }
+        particle->getParticlePhysics().updatePhysics();
+    }
 }
 
 void ParticleHandler::clear()
@@ -263,7 +427,13 @@ void ParticleHandler::clear()
     _pendingParticles.clear();
     _activeParticles.clear();
     _unusedPool.clear();
+    _storageUsed = 0;
+    _evictionOrder.clear();
+    _evictionOrderBuilt = false;
+    _lastUpdateFrame = std::numeric_limits<uint32_t>::max();
     _particleMap.clear();
+    _attachedParticles.clear();
+    _spatialHash.clear(0, 0, 0, 0);
     _totalParticlesSpawned = 0;
 }
 
@@ -295,7 +465,7 @@ void ParticleHandler::spawnDefencePing(const std::shared_ptr<Object> &object, co
 
     spawnGlobalParticle(object->getPosition(), object->ori.facing_z, LocalParticleProfileRef(PIP_DEFEND), 0);
 
-    object->damage_timer = DEFENDTIME;
+    object->setTimer(&Object::damage_timer, DEFENDTIME);
     SET_BIT(object->ai.alert, ALERTIF_BLOCKED);
 
     // For the ones attacking a shield
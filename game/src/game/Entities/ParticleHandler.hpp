@@ -89,10 +89,18 @@ public:
         _maxParticles(0),
         _semaphoreLock(0),
         _totalParticlesSpawned(0),
+        _hotData(PARTICLES_MAX),
+        _storage(createStorage(_hotData)),
+        _storageUsed(0),
+        _evictionOrder(),
+        _evictionOrderBuilt(false),
+        _lastUpdateFrame(std::numeric_limits<uint32_t>::max()),
         _unusedPool(),
         _activeParticles(),
         _particleMap(),
-        
+        _deferredCommands(),
+        _spatialHash(Info<float>::Block::Size()),
+        _attachedParticles(),
         _transparentParticleTexture("mp_data/globalparticles/particle_trans"),
         _lightParticleTexture("mp_data/globalparticles/particle_light")
     {
@@ -110,10 +118,68 @@ public:
 
     /**
     * @brief
-    *   Updates all particles and free particles that have been marked as terminated
+    *   Updates all particles and free particles that have been marked as terminated.
+    *   Active particles are kept in storage order, so this streams through the particle storage.
     **/
     void updateAllParticles();
 
+    /**
+    * @return
+    *   the fields of all particles used in every update, indexed by Ego::Particle::getSlot().
+    *   Loops over the active particles read these arrays in storage order.
+    **/
+    const Ego::ParticleHotData& getHotData() const { return _hotData; }
+
+    /**
+    * @brief
+    *   Updates the physics of all particles. Particles which can be updated concurrently
+    *   are updated in parallel first, the remaining particles are updated afterwards in order.
+    *   Sounds triggered by the parallel update are deferred to the next unlock(),
+    *   as are the end spawns of terminated particles.
+    **/
+    void updateAllPhysics();
+
+    /**
+    * @brief
+    *   Rebuild the spatial hash of all active particles from their current positions.
+    *   Called once per update frame after all particles have moved.
+    * @param minX, minY, maxX, maxY
+    *   the bounds of the spatial hash (size of the entire current level)
+    **/
+    void updateSpatialHash(float minX, float minY, float maxX, float maxY);
+
+    /**
+    * @brief
+    *   Visit all particles which were within a 2D area at the last updateSpatialHash()
+    *   and have not been terminated since.
+    * @param visitor
+    *   function object called with a reference to each particle (<tt>Ego::Particle&</tt>)
+    **/
+    template<typename Visitor>
+    void visitParticles(const AxisAlignedBox2f &searchArea, Visitor visitor) const
+    {
+        _spatialHash.visit(searchArea, [&visitor](Ego::Particle &particle) {
+            if(!particle.isTerminated()) visitor(particle);
+        });
+    }
+
+    /**
+    * @brief
+    *   Visit all active particles which are attached to an object and have not been terminated
+    * @param visitor
+    *   function object called with a reference to each particle (<tt>Ego::Particle&</tt>)
+    **/
+    template<typename Visitor>
+    void visitAttachedParticles(ObjectRef objectRef, Visitor visitor) const
+    {
+        auto range = std::equal_range(_attachedParticles.begin(), _attachedParticles.end(), std::make_pair(objectRef, static_cast<Ego::Particle*>(nullptr)),
+                                      [](const std::pair<ObjectRef, Ego::Particle*> &a, const std::pair<ObjectRef, Ego::Particle*> &b) { return a.first < b.first; });
+        for(auto it = range.first; it != range.second; ++it) {
+            //Particles can be detached, but never attached to another object
+            if(!it->second->isTerminated() && it->second->getAttachedObjectID() == objectRef) visitor(*it->second);
+        }
+    }
+
     void download(egoboo_config_t& cfg);
 
     void upload(egoboo_config_t& cfg);
@@ -219,24 +285,84 @@ public:
     void spawnDefencePing(const std::shared_ptr<Object> &object, const std::shared_ptr<Object> &attacker);
 
 private:
+    /**
+    * @brief
+    *   An active particle which may be replaced by a forced spawn
+    **/
+    struct EvictionCandidate
+    {
+        float score;                ///< The higher, the earlier the particle is replaced
+        ParticleRef particleID;     ///< To detect particles which were replaced since the order was built
+        Ego::Particle *particle;
+    };
+
     std::shared_ptr<Ego::Particle> getFreeParticle(bool force);
 
+    /**
+    * @brief
+    *   Construct all PARTICLES_MAX particles in one contiguous block, each bound to its slot in the hot data
+    **/
+    static std::shared_ptr<Ego::Particle> createStorage(Ego::ParticleHotData& hotData);
+
+    /**
+    * @brief
+    *   Terminate the active particle which is least important to the game to make room for a forced spawn.
+    *   Cosmetic particles are replaced before particles relevant to the gameplay, particles far from all
+    *   cameras before near ones and nearly expired particles before fresh ones. Particles spawned with
+    *   ParticleProfile::force are never replaced.
+    * @return
+    *   true if a particle was terminated
+    **/
+    bool evictParticle();
+
+    /**
+    * @brief
+    *   Build the eviction order of the active particles, called at most once per update frame
+    *   and only if a particle has to be replaced.
+    **/
+    void buildEvictionOrder();
+
+    /**
+    * @return
+    *   the eviction score of a particle, see EvictionCandidate::score
+    **/
+    float getEvictionScore(const Ego::Particle &particle, const Vector3f *cameraPositions, size_t cameraCount) const;
+
     void lock();
 
     void unlock();
 
+    /**
+    * @brief
+    *   Rebuild the index of active particles by the object they are attached to.
+    *   Called whenever the list of active particles changed.
+    **/
+    void updateAttachmentIndex();
+
 private:
     static constexpr uint8_t DEFENDTIME = 24;   ///< Invincibility time after blocking an attack
+    static constexpr float EVICTION_DISTANCE = 16.0f * Info<float>::Grid::Size();  ///< Beyond this distance from all cameras, particles are equally far
 
     size_t _maxParticles;   ///< Maximum allowed active particles to be alive at the same time
     std::atomic<size_t> _semaphoreLock;
     std::atomic<size_t> _totalParticlesSpawned;
 
+    Ego::ParticleHotData _hotData;                                   //Fields of the particles used in every update, by storage slot
+    std::shared_ptr<Ego::Particle> _storage;                         //All particles in one contiguous block, PARTICLES_MAX in total
+    size_t _storageUsed;                                             //Number of particles in the storage which have been handed out
+    std::vector<EvictionCandidate> _evictionOrder;                   //Heap of replaceable particles, the highest score on top
+    bool _evictionOrderBuilt;                                        //Has _evictionOrder been built during this update frame?
+    uint32_t _lastUpdateFrame;                                       //Update frame of the last updateAllParticles()
+
     std::vector<std::shared_ptr<Ego::Particle>> _unusedPool;         //Particles currently unused
-    std::vector<std::shared_ptr<Ego::Particle>> _activeParticles;    //List of all particles that are active ingame
+    std::vector<std::shared_ptr<Ego::Particle>> _activeParticles;    //List of all particles that are active ingame, sorted by storage slot
     std::vector<std::shared_ptr<Ego::Particle>> _pendingParticles;   //Particles that will be added to the active list as soon as it is unlocked
 
     std::unordered_map<ParticleRef, std::shared_ptr<Ego::Particle>> _particleMap; //Mapping from PRT_REF to Particle
+    Ego::Core::CommandBuffer _deferredCommands;                      //Effects of the parallel physics update, executed when unlocked
+
+    Ego::SpatialHash<Ego::Particle> _spatialHash;                    //Active particles by position, rebuilt every update frame
+    std::vector<std::pair<ObjectRef, Ego::Particle*>> _attachedParticles; //Active attached particles sorted by the object they are attached to
 
     Ego::DeferredTexture _transparentParticleTexture;
     Ego::DeferredTexture _lightParticleTexture;
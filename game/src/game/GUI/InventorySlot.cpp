@@ -76,7 +76,7 @@ bool InventorySlot::notifyMouseButtonPressed(const Events::MouseButtonPressedEve
 
         // Make it take a little time
         pchr->inst.playAction(ACTION_MG, false);
-        pchr->reload_timer = Inventory::PACKDELAY;
+        pchr->setTimer(&Object::reload_timer, Inventory::PACKDELAY);
         return true;
     }
 
@@ -86,10 +86,14 @@ void MapEditorState::update()
     // Get immediate mode state for the rest of the game
     Ego::Input::InputSystem::get().update();
 
-    //Rebuild the quadtree for fast object lookup
-    _currentModule->getObjectHandler().updateQuadTree(0.0f, 0.0f, _currentModule->getMeshPointer()->_info.getTileCountX()*Info<float>::Grid::Size(),
+    //Update the spatial grid for fast object lookup
+    _currentModule->getObjectHandler().updateSpatialGrid(0.0f, 0.0f, _currentModule->getMeshPointer()->_info.getTileCountX()*Info<float>::Grid::Size(),
 		                                                          _currentModule->getMeshPointer()->_info.getTileCountY()*Info<float>::Grid::Size());
 
+    //Update the spatial hash for fast particle lookup
+    ParticleHandler::get().updateSpatialHash(0.0f, 0.0f, _currentModule->getMeshPointer()->_info.getTileCountX()*Info<float>::Grid::Size(),
+                                                         _currentModule->getMeshPointer()->_info.getTileCountY()*Info<float>::Grid::Size());
+
     //Always reveal all invisible monsters and objects in Map Editor mode
     local_stats.seeinvis_level = 100;
     local_stats.seeinvis_mag = std::exp(0.32f * local_stats.seeinvis_level);
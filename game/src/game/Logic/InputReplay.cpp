@@ -0,0 +1,252 @@
+//********************************************************************************************
+//*
+//*    This file is part of Egoboo.
+//*
+//*    Egoboo is free software: you can redistribute it and/or modify it
+//*    under the terms of the GNU General Public License as published by
+//*    the Free Software Foundation, either version 3 of the License, or
+//*    (at your option) any later version.
+//*
+//*    Egoboo is distributed in the hope that it will be useful, but
+//*    WITHOUT ANY WARRANTY; without even the implied warranty of
+//*    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+//*    General Public License for more details.
+//*
+//*    You should have received a copy of the GNU General Public License
+//*    along with Egoboo.  If not, see <http://www.gnu.org/licenses/>.
+//*
+//********************************************************************************************
+
+/// @file game/Logic/InputReplay.cpp
+/// @brief Recording and playback of the player input of a session.
+
+#include "game/Logic/InputReplay.hpp"
+#include "game/game.h"
+
+const uint32_t InputReplay::Magic;
+const uint32_t InputReplay::Version;
+const uint8_t InputReplay::ModuleTag;
+const uint8_t InputReplay::FrameTag;
+
+InputReplay::InputReplay() :
+    _mode(Mode::None),
+    _filename(),
+    _file(nullptr)
+{
+    //ctor
+}
+
+InputReplay::~InputReplay()
+{
+    stop();
+}
+
+void InputReplay::parseCommandLine(int argc, char **argv, Mode& mode, std::string& filename)
+{
+    mode = Mode::None;
+    for(int i = 1; i < argc; ++i)
+    {
+        const std::string argument = argv[i];
+        if(argument != "--record" && argument != "--playback") {
+            continue;
+        }
+
+        //File name is mandatory
+        if(i + 1 >= argc) {
+            throw Id::RuntimeErrorException(__FILE__, __LINE__, argument + " requires a file name");
+        }
+        mode = (argument == "--record") ? Mode::Recording : Mode::Playback;
+        filename = argv[i + 1];
+    }
+}
+
+bool InputReplay::startRecording(const std::string& filename)
+{
+    stop();
+
+    _file = vfs_openWrite(filename);
+    if(!_file) {
+        Log::get() << Log::Entry::create(Log::Level::Warning, __FILE__, __LINE__, "unable to open replay file ", "`", filename, "`", " for writing", Log::EndOfEntry);
+        return false;
+    }
+    vfs_write<Uint32>(*_file, Magic);
+    vfs_write<Uint32>(*_file, Version);
+
+    _mode = Mode::Recording;
+    _filename = filename;
+    Log::get() << Log::Entry::create(Log::Level::Info, __FILE__, __LINE__, "recording session to ", "`", filename, "`", Log::EndOfEntry);
+    return true;
+}
+
+bool InputReplay::startPlayback(const std::string& filename)
+{
+    stop();
+
+    _file = vfs_openRead(filename);
+    if(!_file) {
+        Log::get() << Log::Entry::create(Log::Level::Warning, __FILE__, __LINE__, "unable to open replay file ", "`", filename, "`", Log::EndOfEntry);
+        return false;
+    }
+
+    Uint32 magic = 0, version = 0;
+    vfs_read_Uint32(*_file, &magic);
+    vfs_read_Uint32(*_file, &version);
+    if(Magic != magic || Version != version) {
+        Log::get() << Log::Entry::create(Log::Level::Warning, __FILE__, __LINE__, "`", filename, "`", " is not a replay file of version ", Version, Log::EndOfEntry);
+        vfs_close(_file);
+        _file = nullptr;
+        return false;
+    }
+
+    _mode = Mode::Playback;
+    _filename = filename;
+    Log::get() << Log::Entry::create(Log::Level::Info, __FILE__, __LINE__, "playing back session from ", "`", filename, "`", Log::EndOfEntry);
+    return true;
+}
+
+void InputReplay::stop()
+{
+    if(_file) {
+        vfs_close(_file);
+        _file = nullptr;
+    }
+    _mode = Mode::None;
+}
+
+InputReplay::Mode InputReplay::getMode() const
+{
+    return _mode;
+}
+
+void InputReplay::beginModule(const std::string& moduleName, uint32_t& seed)
+{
+    switch(_mode)
+    {
+        case Mode::None:
+        break;
+
+        case Mode::Recording:
+        {
+            vfs_write<Uint8>(*_file, ModuleTag);
+            vfs_write<Uint32>(*_file, moduleName.size());
+            vfs_write(moduleName.data(), 1, moduleName.size(), _file);
+            vfs_write<Uint32>(*_file, seed);
+            vfs_flush(_file);
+        }
+        break;
+
+        case Mode::Playback:
+        {
+            Uint8 tag = 0;
+            Uint32 length = 0;
+            if(0 == vfs_read_Uint8(*_file, &tag) || ModuleTag != tag || 0 == vfs_read_Uint32(*_file, &length)) {
+                endPlayback("no further module recorded");
+                return;
+            }
+            std::string recordedName(length, '\0');
+            Uint32 recordedSeed = 0;
+            if(length != vfs_read(&recordedName[0], 1, length, _file) || 0 == vfs_read_Uint32(*_file, &recordedSeed)) {
+                endPlayback("module record truncated");
+                return;
+            }
+            if(recordedName != moduleName) {
+                endPlayback("recorded module `" + recordedName + "` does not match module `" + moduleName + "`");
+                return;
+            }
+            seed = recordedSeed;
+        }
+        break;
+    }
+}
+
+void InputReplay::updateInput(const std::vector<std::shared_ptr<Ego::Player>>& players, std::vector<Ego::Player::InputSample>& inputs)
+{
+    inputs.resize(players.size());
+
+    if(Mode::Playback == _mode)
+    {
+        Uint8 tag = 0, count = 0;
+        Uint32 frame = 0;
+        if(0 == vfs_read_Uint8(*_file, &tag) || FrameTag != tag || 0 == vfs_read_Uint32(*_file, &frame) || 0 == vfs_read_Uint8(*_file, &count)) {
+            endPlayback("no further update frame recorded");
+        }
+        else if(frame != update_wld || count != players.size()) {
+            endPlayback("recording is out of sync");
+        }
+        else {
+            for(Ego::Player::InputSample& input : inputs) {
+                if(!readInput(input)) {
+                    endPlayback("update frame record truncated");
+                    break;
+                }
+            }
+        }
+
+        if(Mode::Playback == _mode) {
+            return;
+        }
+    }
+
+    // Poll the input devices.
+    for(size_t i = 0; i < players.size(); ++i) {
+        inputs[i] = players[i]->sampleInput();
+    }
+
+    if(Mode::Recording == _mode)
+    {
+        vfs_write<Uint8>(*_file, FrameTag);
+        vfs_write<Uint32>(*_file, update_wld);
+        vfs_write<Uint8>(*_file, inputs.size());
+        for(const Ego::Player::InputSample& input : inputs) {
+            writeInput(input);
+        }
+    }
+}
+
+void InputReplay::writeInput(const Ego::Player::InputSample& input)
+{
+    const bool hasMovement = input.joystick != Vector2f::zero() || input.movement != Vector2f::zero();
+    Uint8 flags = 0;
+    if(input.valid) flags |= Valid;
+    if(input.respawn) flags |= Respawn;
+    if(hasMovement) flags |= Movement;
+
+    vfs_write<Uint8>(*_file, flags);
+    if(input.valid) {
+        vfs_write<Uint32>(*_file, input.buttons);
+    }
+    if(hasMovement) {
+        vfs_write<float>(*_file, input.joystick.x());
+        vfs_write<float>(*_file, input.joystick.y());
+        vfs_write<float>(*_file, input.movement.x());
+        vfs_write<float>(*_file, input.movement.y());
+    }
+}
+
+bool InputReplay::readInput(Ego::Player::InputSample& input)
+{
+    input = Ego::Player::InputSample();
+
+    Uint8 flags = 0;
+    if(0 == vfs_read_Uint8(*_file, &flags)) {
+        return false;
+    }
+    input.valid = 0 != (flags & Valid);
+    input.respawn = 0 != (flags & Respawn);
+    if(input.valid && 0 == vfs_read_Uint32(*_file, &input.buttons)) {
+        return false;
+    }
+    if(0 != (flags & Movement)) {
+        if(0 == vfs_read_float(*_file, &input.joystick.x()) || 0 == vfs_read_float(*_file, &input.joystick.y()) ||
+           0 == vfs_read_float(*_file, &input.movement.x()) || 0 == vfs_read_float(*_file, &input.movement.y())) {
+            return false;
+        }
+    }
+    return true;
+}
+
+void InputReplay::endPlayback(const std::string& reason)
+{
+    Log::get() << Log::Entry::create(Log::Level::Info, __FILE__, __LINE__, "playback of ", "`", _filename, "`", " ended: ", reason, Log::EndOfEntry);
+    stop();
+}
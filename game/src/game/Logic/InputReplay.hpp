@@ -0,0 +1,148 @@
+//********************************************************************************************
+//*
+//*    This file is part of Egoboo.
+//*
+//*    Egoboo is free software: you can redistribute it and/or modify it
+//*    under the terms of the GNU General Public License as published by
+//*    the Free Software Foundation, either version 3 of the License, or
+//*    (at your option) any later version.
+//*
+//*    Egoboo is distributed in the hope that it will be useful, but
+//*    WITHOUT ANY WARRANTY; without even the implied warranty of
+//*    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+//*    General Public License for more details.
+//*
+//*    You should have received a copy of the GNU General Public License
+//*    along with Egoboo.  If not, see <http://www.gnu.org/licenses/>.
+//*
+//********************************************************************************************
+
+/// @file game/Logic/InputReplay.hpp
+/// @brief Recording and playback of the player input of a session.
+
+#pragma once
+
+#include "egolib/egolib.h"
+#include "game/Logic/Player.hpp"
+
+/**
+* @brief
+*   Records the module seeds and the player input of every update frame of a session to a
+*   file and plays them back. As the seed determines all randomness and the player input is
+*   the only other input of the game logic, a recorded session replays bit-for-bit, also in
+*   a headless simulation.
+* @remark
+*   A session is recorded or played back if requested on the command line:
+*   @code
+*   egoboo --record <virtual filename>
+*   egoboo --playback <virtual filename>
+*   @endcode
+* @remark
+*   File format (all integers little endian):
+*   @code
+*   header: uint32 magic, uint32 version
+*   module: uint8 ModuleTag, uint32 length, char[length] module folder name, uint32 seed
+*   frame:  uint8 FrameTag, uint32 update_wld, uint8 number of players,
+*           per player: uint8 flags, [uint32 buttons], [float joystick x, y, movement x, y]
+*   @endcode
+*   The buttons are present if the player has a valid input sample and the movement if it is non-zero.
+**/
+class InputReplay : public Ego::Core::Singleton<InputReplay>
+{
+protected:
+    friend Ego::Core::Singleton<InputReplay>::CreateFunctorType;
+    friend Ego::Core::Singleton<InputReplay>::DestroyFunctorType;
+
+    InputReplay();
+    virtual ~InputReplay();
+
+public:
+    enum class Mode
+    {
+        None,       ///< Neither recording nor playing back
+        Recording,  ///< Recording a session
+        Playback    ///< Playing back a session
+    };
+
+    /**
+    * @brief
+    *   Parse the command line arguments for a recording or playback request.
+    * @param mode
+    *   receives the requested mode
+    * @param filename
+    *   receives the virtual filename of the recording
+    **/
+    static void parseCommandLine(int argc, char **argv, Mode& mode, std::string& filename);
+
+    /**
+    * @brief
+    *   Start recording a session.
+    * @return
+    *   true on success, false if the file could not be opened
+    **/
+    bool startRecording(const std::string& filename);
+
+    /**
+    * @brief
+    *   Start playing back a session.
+    * @return
+    *   true on success, false if the file could not be opened or is not a recording
+    **/
+    bool startPlayback(const std::string& filename);
+
+    /**
+    * @brief
+    *   Stop recording or playing back.
+    **/
+    void stop();
+
+    Mode getMode() const;
+
+    /**
+    * @brief
+    *   Called when a module is started.
+    * @param moduleName
+    *   the folder name of the module
+    * @param seed
+    *   the seed of the module. Replaced by the recorded seed when playing back.
+    **/
+    void beginModule(const std::string& moduleName, uint32_t& seed);
+
+    /**
+    * @brief
+    *   Get the input of all players for the current update frame and record it if recording.
+    * @param players
+    *   the players
+    * @param inputs
+    *   receives one input sample per player. When playing back, the recorded samples are
+    *   returned. Otherwise the samples are polled from the players.
+    **/
+    void updateInput(const std::vector<std::shared_ptr<Ego::Player>>& players, std::vector<Ego::Player::InputSample>& inputs);
+
+private:
+    static const uint32_t Magic = 0x50524745;   ///< "EGRP"
+    static const uint32_t Version = 1;
+    static const uint8_t ModuleTag = 1;
+    static const uint8_t FrameTag = 2;
+
+    enum InputFlags : uint8_t
+    {
+        Valid = 1 << 0,
+        Respawn = 1 << 1,
+        Movement = 1 << 2
+    };
+
+    void writeInput(const Ego::Player::InputSample& input);
+    bool readInput(Ego::Player::InputSample& input);
+
+    /**
+    * @brief
+    *   Stop playback because the recording ended or does not match the session.
+    **/
+    void endPlayback(const std::string& reason);
+
+private:
+    Mode _mode;
+    std::string _filename;
+    vfs_FILE *_file;
+};
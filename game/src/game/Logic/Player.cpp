@@ -64,52 +64,101 @@ Ego::QuestLog& Player::getQuestLog()
     return _questLog;
 }
 
-void Player::updateLatches()
+Player::InputSample::InputSample() :
+    valid(false),
+    respawn(false),
+    buttons(0),
+    joystick(Vector2f::zero()),
+    movement(Vector2f::zero())
+{
+}
+
+bool Player::InputSample::isButtonPressed(const Ego::Input::InputDevice::InputButton button) const
+{
+    return 0 != (buttons & (1u << static_cast<uint32_t>(button)));
+}
+
+Player::InputSample Player::sampleInput() const
 {
+    InputSample input;
+
     //Ensure this player is controlling a valid object
     std::shared_ptr<Object> object = getObject();
     if(!object || object->isTerminated()) {
-        return;
+        return input;
     }
-    object->resetInputCommands();
 
     // find the camera that is following this character
     const auto &pcam = CameraSystem::get().getCamera(object->getObjRef());
     if (!pcam) {
-        return;
+        return input;
+    }
+    input.valid = true;
+
+    //Press space to respawn!
+    input.respawn = Ego::Input::InputSystem::get().isKeyDown(SDLK_SPACE);
+
+    for(uint32_t i = 0; i < static_cast<uint32_t>(Ego::Input::InputDevice::InputButton::COUNT); ++i) {
+        if(getInputDevice().isButtonPressed(static_cast<Ego::Input::InputDevice::InputButton>(i))) {
+            input.buttons |= 1u << i;
+        }
     }
 
     // fast camera turn if it is enabled and there is only 1 local player
     bool fast_camera_turn = ( 1 == local_stats.player_count ) && ( CameraTurnMode::Good == pcam->getTurnMode() );
 
-    // Clear the player's latch buffers
-    Vector2f movementInput = Vector2f::zero();
-    Vector2f joy_pos = Vector2f::zero();
-
     // generate the transforms relative to the camera
     // this needs to be changed for multicamera
     float fsin = std::sin(pcam->getOrientation().facing_z);
     float fcos = std::cos(pcam->getOrientation().facing_z);
 
-    if(fast_camera_turn || !getInputDevice().isButtonPressed(Ego::Input::InputDevice::InputButton::CAMERA_CONTROL))
+    if(fast_camera_turn || !input.isButtonPressed(Ego::Input::InputDevice::InputButton::CAMERA_CONTROL))
     {
-        joy_pos = getInputDevice().getInputMovement();
+        input.joystick = getInputDevice().getInputMovement();
 
         //Rotate movement input from body frame to earth frame
-        movementInput.x() = ( joy_pos[XX] * fcos + joy_pos[YY] * fsin );
-        movementInput.y() = ( -joy_pos[XX] * fsin + joy_pos[YY] * fcos );
+        input.movement.x() = ( input.joystick[XX] * fcos + input.joystick[YY] * fsin );
+        input.movement.y() = ( -input.joystick[XX] * fsin + input.joystick[YY] * fcos );
+    }
+
+    //ZF> dirty hack here... mouse seems to be inverted in inventory mode?
+    if (_inventoryMode && getInputDevice().getDeviceType() == Ego::Input::InputDevice::InputDeviceType::MOUSE)
+    {
+        input.joystick[XX] = -input.joystick[XX];
+        input.joystick[YY] = -input.joystick[YY];
+    }
+
+    return input;
+}
+
+void Player::updateLatches()
+{
+    applyInput(sampleInput());
+}
+
+void Player::applyInput(const InputSample& input)
+{
+    //Ensure this player is controlling a valid object
+    std::shared_ptr<Object> object = getObject();
+    if(!object || object->isTerminated()) {
+        return;
+    }
+    object->resetInputCommands();
+
+    if (!input.valid) {
+        return;
     }
 
     // Read control buttons
     if (!_inventoryMode)
     {
         // Now update movement and input
-        object->setLatchButton(LATCHBUTTON_JUMP, getInputDevice().isButtonPressed(Ego::Input::InputDevice::InputButton::JUMP));
-        object->setLatchButton(LATCHBUTTON_LEFT, getInputDevice().isButtonPressed(Ego::Input::InputDevice::InputButton::USE_LEFT));
-        object->setLatchButton(LATCHBUTTON_RIGHT, getInputDevice().isButtonPressed(Ego::Input::InputDevice::InputButton::USE_RIGHT));
-        object->setLatchButton(LATCHBUTTON_ALTLEFT, getInputDevice().isButtonPressed(Ego::Input::InputDevice::InputButton::GRAB_LEFT));
-        object->setLatchButton(LATCHBUTTON_ALTRIGHT, getInputDevice().isButtonPressed(Ego::Input::InputDevice::InputButton::GRAB_RIGHT));
-        object->getObjectPhysics().setDesiredVelocity(movementInput);
+        object->setLatchButton(LATCHBUTTON_JUMP, input.isButtonPressed(Ego::Input::InputDevice::InputButton::JUMP));
+        object->setLatchButton(LATCHBUTTON_LEFT, input.isButtonPressed(Ego::Input::InputDevice::InputButton::USE_LEFT));
+        object->setLatchButton(LATCHBUTTON_RIGHT, input.isButtonPressed(Ego::Input::InputDevice::InputButton::USE_RIGHT));
+        object->setLatchButton(LATCHBUTTON_ALTLEFT, input.isButtonPressed(Ego::Input::InputDevice::InputButton::GRAB_LEFT));
+        object->setLatchButton(LATCHBUTTON_ALTRIGHT, input.isButtonPressed(Ego::Input::InputDevice::InputButton::GRAB_RIGHT));
+        object->getObjectPhysics().setDesiredVelocity(input.movement);
     }
 
     //inventory mode
@@ -117,16 +166,9 @@ void Player::updateLatches()
     {
         int new_selected = _inventorySlot;
 
-        //ZF> dirty hack here... mouse seems to be inverted in inventory mode?
-        if (getInputDevice().getDeviceType() == Ego::Input::InputDevice::InputDeviceType::MOUSE)
-        {
-            joy_pos[XX] = -joy_pos[XX];
-            joy_pos[YY] = -joy_pos[YY];
-        }
-
         //handle inventory movement
-        if ( joy_pos[XX] < 0 )       new_selected--;
-        else if ( joy_pos[XX] > 0 )  new_selected++;
+        if ( input.joystick[XX] < 0 )       new_selected--;
+        else if ( input.joystick[XX] > 0 )  new_selected++;
 
         //clip to a valid value
         if ( _inventorySlot != new_selected )
@@ -149,35 +191,38 @@ void Player::updateLatches()
         if ( object->inst.canBeInterrupted() && 0 == object->reload_timer )
         {
             //handle LEFT hand control
-            if (getInputDevice().isButtonPressed(Ego::Input::InputDevice::InputButton::USE_LEFT) || getInputDevice().isButtonPressed(Ego::Input::InputDevice::InputButton::GRAB_LEFT))
+            if (input.isButtonPressed(Ego::Input::InputDevice::InputButton::USE_LEFT) || input.isButtonPressed(Ego::Input::InputDevice::InputButton::GRAB_LEFT))
             {
                 //put it away and swap with any existing item
                 Inventory::swap_item(object->getObjRef(), _inventorySlot, SLOT_LEFT, false);
 
                 // Make it take a little time
                 object->inst.playAction(ACTION_MG, false);
-                object->reload_timer = Inventory::PACKDELAY;
+                object->setTimer(&Object::reload_timer, Inventory::PACKDELAY);
             }
 
             //handle RIGHT hand control
-            if (getInputDevice().isButtonPressed(Ego::Input::InputDevice::InputButton::USE_RIGHT) || getInputDevice().isButtonPressed(Ego::Input::InputDevice::InputButton::GRAB_RIGHT))
+            if (input.isButtonPressed(Ego::Input::InputDevice::InputButton::USE_RIGHT) || input.isButtonPressed(Ego::Input::InputDevice::InputButton::GRAB_RIGHT))
             {
                 // put it away and swap with any existing item
                 Inventory::swap_item(object->getObjRef(), _inventorySlot, SLOT_RIGHT, false);
 
                 // Make it take a little time
                 object->inst.playAction(ACTION_MG, false);
-                object->reload_timer = Inventory::PACKDELAY;
+                object->setTimer(&Object::reload_timer, Inventory::PACKDELAY);
             }
         }
     }
 
     //enable inventory mode?
-    if ( update_wld > _inventoryCooldown && getInputDevice().isButtonPressed(Ego::Input::InputDevice::InputButton::INVENTORY) )
+    if ( update_wld > _inventoryCooldown && input.isButtonPressed(Ego::Input::InputDevice::InputButton::INVENTORY) )
     {
         for(uint8_t ipla = 0; ipla < _currentModule->getPlayerList().size(); ++ipla) {
             if(_currentModule->getPlayer(ipla).get() == this) {
-                _gameEngine->getActivePlayingState()->displayCharacterWindow(ipla);
+                //There is no character window without a user interface (e.g. when replaying headless)
+                if(_gameEngine->getActivePlayingState()) {
+                    _gameEngine->getActivePlayingState()->displayCharacterWindow(ipla);
+                }
                 _inventoryCooldown = update_wld + ( ONESECOND / 4 );
                 break;
             }
@@ -185,7 +230,7 @@ void Player::updateLatches()
     }
 
     //Enter or exit stealth mode?
-    if(getInputDevice().isButtonPressed(Ego::Input::InputDevice::InputButton::STEALTH) && update_wld > _inventoryCooldown) {
+    if(input.isButtonPressed(Ego::Input::InputDevice::InputButton::STEALTH) && update_wld > _inventoryCooldown) {
         if(!object->isStealthed()) {
             object->activateStealth();
         }
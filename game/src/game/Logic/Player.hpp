@@ -37,6 +37,27 @@ namespace Ego
 class Player
 {
 public:
+    /**
+    * @brief
+    *   The input of a player for a single update frame.
+    **/
+    struct InputSample
+    {
+        bool valid;             ///< false if the player has no controllable object or no camera
+        bool respawn;           ///< true if a respawn was requested
+        uint32_t buttons;       ///< bit i is set if InputDevice::InputButton i is pressed
+        Vector2f joystick;      ///< the movement input of the input device
+        Vector2f movement;      ///< the movement input rotated into world space
+
+        InputSample();
+
+        /**
+        * @return
+        *   true if the specified input button is pressed
+        **/
+        bool isButtonPressed(const Ego::Input::InputDevice::InputButton button) const;
+    };
+
     Player(const std::shared_ptr<Object>& object, const Ego::Input::InputDevice &device);
 
     /**
@@ -65,6 +86,21 @@ public:
     **/
     void updateLatches();
 
+    /**
+    * @brief
+    *   Polls the input device controlling this player
+    * @return
+    *   the input for the current update frame
+    **/
+    InputSample sampleInput() const;
+
+    /**
+    * @brief
+    *   Sets movement and action latches (and handles inventory and stealth controls) from an input sample.
+    *   The input sample may either come from sampleInput() or from a recorded session.
+    **/
+    void applyInput(const InputSample& input);
+
     /**
     * @brief
     *   This makes this player have a channeling progress bar next to it's status indicator
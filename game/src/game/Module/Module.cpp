@@ -61,7 +61,9 @@ GameModule::GameModule(const std::shared_ptr<ModuleProfile> &profile, const uint
     _pitsClock(PIT_CLOCK_RATE),
     _pitsKill(false),
     _pitsTeleport(false),
-    _pitsTeleportPos()
+    _pitsTeleportPos(),
+
+    _timers(0)
 {
     Log::get() << Log::Entry::create(Log::Level::Info, __FILE__, __LINE__, "loading module ", "`", profile->getPath(), "`", Log::EndOfEntry);
 
@@ -621,7 +623,10 @@ std::shared_ptr<const Ego::Texture> GameModule::getWaterTexture(const uint8_t la
 
 void GameModule::updateAllObjects()
 {
-   for(const std::shared_ptr<Object> &object : getObjectHandler().iterator())
+    //Run the timers expired since the last update
+    _timers.advance(update_wld, [](const std::function<void()> &timer) { timer(); });
+
+    for(const std::shared_ptr<Object> &object : getObjectHandler().iterator())
     {
         //Skip terminated objects
         if(object->isTerminated()) {
@@ -815,7 +820,7 @@ void GameModule::updateDamageTiles()
                                              static_cast<DamageType>(_damageTile.damagetype), 
                                              Team::TEAM_DAMAGE, nullptr, true, false, false);
 
-            pchr->damage_timer = DAMAGETILETIME;
+            pchr->setTimer(&Object::damage_timer, DAMAGETILETIME);
 
             if ((actual_damage > 0) && (LocalParticleProfileRef::Invalid != _damageTile.part_gpip) && 0 == (update_wld & _damageTile.partand)) {
                 ParticleHandler::get().spawnGlobalParticle( pchr->getPosition(), Facing::ATK_FRONT, _damageTile.part_gpip, 0 );
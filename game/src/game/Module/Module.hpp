@@ -164,6 +164,13 @@ public:
     **/
     ObjectHandler& getObjectHandler() {return _gameObjects;}
 
+    /**
+    * @return
+    *   Get the timers of this Module. Deadlines are in update frames (update_wld) and
+    *   expired timers are run at the start of updateAllObjects()
+    **/
+    Ego::Core::TimerWheel<std::function<void()>>& getTimers() {return _timers;}
+
     /**
     * @return
     *   true if the specified position is inside the level
@@ -308,6 +315,8 @@ private:
     bool _pitsKill;              ///< Do they kill?
     bool _pitsTeleport;          ///< Do they teleport?
     Vector3f _pitsTeleportPos;   ///< If they teleport, then where to?
+
+    Ego::Core::TimerWheel<std::function<void()>> _timers;   ///< Timers expiring in a given update frame
 };
 
 /// @todo Remove this global.
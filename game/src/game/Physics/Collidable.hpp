@@ -29,7 +29,8 @@ class Collidable
 {
 public:
     Collidable() :
-        _position(0.0f, 0.0f, 0.0f),
+        _ownPosition(0.0f, 0.0f, 0.0f),
+        _position(_ownPosition),
         _oldPosition(0.0f, 0.0f, 0.0f),
         _spawnPosition(0.0f, 0.0f, 0.0f),
         _safePosition(0.0f, 0.0f, 0.0f),
@@ -39,6 +40,24 @@ public:
         //ctor
     }
 
+    /**
+    * @brief
+    *   Constructs an entity which keeps its current position outside of itself
+    * @param position
+    *   the current position, must live as long as the entity
+    **/
+    explicit Collidable(Vector3f& position) :
+        _ownPosition(0.0f, 0.0f, 0.0f),
+        _position(position),
+        _oldPosition(0.0f, 0.0f, 0.0f),
+        _spawnPosition(0.0f, 0.0f, 0.0f),
+        _safePosition(0.0f, 0.0f, 0.0f),
+        _safeValid(false),
+		_tile(Index1D::Invalid)
+    {
+        _position = Vector3f::zero();
+    }
+
     /**
     * @return
     *   true if this Entity can collide with another Entity
@@ -205,12 +224,15 @@ public:
     /// @brief Return nonzero if the entity hit a wall that the entity is not allowed to cross.
 	virtual BIT_FIELD test_wall(const Vector3f& pos) = 0;
 
+private:
+    Vector3f _ownPosition;  ///< Storage of the current position, unless it is kept outside
+
 protected:
     /**
     * @brief
     *  Current position in the world
     */
-    Vector3f _position;
+    Vector3f& _position;
 
 private:
 
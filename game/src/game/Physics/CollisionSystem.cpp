@@ -30,7 +30,15 @@ namespace Physics
 static bool do_chr_chr_collision(const std::shared_ptr<Object> &objectA, const std::shared_ptr<Object> &objectB, float tmax, float tmin);
 static void get_recoil_factors( float wta, float wtb, float * recoil_a, float * recoil_b );
 
-CollisionSystem::CollisionSystem()
+const size_t CollisionSystem::NO_CANDIDATE;
+
+CollisionSystem::CollisionSystem() :
+    _objectBroadphase(),
+    _particleBroadphase(),
+    _objectPairs(),
+    _particlePairs(),
+    _candidates(),
+    _candidateIndices()
 {
 
 }
@@ -46,6 +54,10 @@ void CollisionSystem::update()
     // blank the accumulators
     for(const std::shared_ptr<Object> &object : _currentModule->getObjectHandler().iterator())
     {
+        //Sleeping objects have no accumulators until they are woken up
+        if(object->getObjectPhysics().isSleeping()) {
+            continue;
+        }
         object->phys.clear();
     }
     for(const std::shared_ptr<Ego::Particle> &particle : ParticleHandler::get().iterator())
@@ -59,7 +71,7 @@ void CollisionSystem::update()
     // accumulate the accumulators
     for(const std::shared_ptr<Object> &pchr : _currentModule->getObjectHandler().iterator())
     {
-        if(pchr->isTerminated()) {
+        if(pchr->isTerminated() || pchr->getObjectPhysics().isSleeping()) {
             continue;
         }
         
@@ -257,16 +269,17 @@ void CollisionSystem::update()
 
 void CollisionSystem::updateObjectCollisions()
 {
-    std::unordered_set<std::shared_ptr<Object>> handledObjects;
+    //Objects killed by collisions must stay alive while their pairs are handled
+    ObjectHandler::ObjectIterator objects = _currentModule->getObjectHandler().iterator();
 
-    //Detect character -> character collisions
-    for(const std::shared_ptr<Object> &object : _currentModule->getObjectHandler().iterator()) {
+    //Submit the volume that every object will occupy during this update to the broadphase
+    _objectBroadphase.begin();
+    for(const std::shared_ptr<Object> &object : objects) {
 
         //Can we collide?
         if (!object->canCollide()) {
             continue;
         }
-        handledObjects.insert(object);
 
         //First check if this object is still attached to it's Platform
         const std::shared_ptr<Object> &platform = _currentModule->getObjectHandler()[object->onwhichplatform_ref];
@@ -286,30 +299,64 @@ void CollisionSystem::updateObjectCollisions()
         oct_bb_t tmp_oct;
         phys_expand_chr_bb(object.get(), 0.0f, 1.0f, tmp_oct);
         const AxisAlignedBox2f aabb2d = AxisAlignedBox2f(Point2f(tmp_oct._mins[OCT_X], tmp_oct._mins[OCT_Y]), Point2f(tmp_oct._maxs[OCT_X], tmp_oct._maxs[OCT_Y]));
+        _objectBroadphase.update(ObjectHandler::getSlot(object->getObjRef()), object.get(), aabb2d);
+    }
+    _objectBroadphase.end();
+
+    //Detect character -> character collisions, every pair is reported once in iteration order
+    //Collect the pairs, all pairs of an object are consecutive
+    _objectPairs.clear();
+    _objectBroadphase.findPairs([this](Object &objectA, Object &objectB)
+    {
+        _objectPairs.emplace_back(&objectA, &objectB);
+    });
 
-        //Do not collide scenery with other scenery objects - unless they can use platforms,
-        //for example boxes stacked on top of other boxes
-        bool canCollideWithScenery = !object->isScenery() || object->canuseplatforms;
+    for(size_t first = 0, last = 0; first < _objectPairs.size(); first = last)
+    {
+        Object &objectA = *_objectPairs[first].first;
 
-        // Check collisions to nearby Objects
-        std::vector<std::shared_ptr<Object>> possibleCollisions;
-        _currentModule->getObjectHandler().findObjects(aabb2d, possibleCollisions, canCollideWithScenery);
-        for (const std::shared_ptr<Object> &other : possibleCollisions)
+        //Test all pairs of this object without platform interactions at once
+        _candidates.clear();
+        _candidateIndices.clear();
+        for(last = first; last < _objectPairs.size() && _objectPairs[last].first == &objectA; ++last)
         {
-            //Skip possible interactions that have already been handled earlier this iteration
-            if(handledObjects.find(other) != handledObjects.end()) {
-                continue;
+            const Object &objectB = *_objectPairs[last].second;
+            size_t candidate = NO_CANDIDATE;
+            if(isCollisionCandidate(objectA, objectB) && canDetectInBatch(objectA, objectB)) {
+                candidate = _candidates.size();
+                _candidates.push_back(objectB.chr_max_cv, objectB.getPosition(), objectB.vel);
             }
+            _candidateIndices.push_back(candidate);
+        }
+        phys_intersect_oct_bb_batch(objectA.chr_max_cv, objectA.getPosition(), objectA.vel, _candidates);
 
-            //Can it collide?
-            if(!other->canCollide()) {
+        //Handle the collisions in order
+        for(size_t i = first; i < last; ++i)
+        {
+            Object &objectB = *_objectPairs[i].second;
+
+            //Can they still collide?
+            if(!isCollisionCandidate(objectA, objectB)) {
                 continue;
             }
 
-            //Detect any collisions and handle it if needed
+            //Detect any collisions and handle it if needed, contacts wake up sleeping objects
             float tmin, tmax;
-            if(detectCollision(object, other, &tmin, &tmax)) {
-                handleCollision(object, other, tmin, tmax);
+            bool collision;
+            const size_t candidate = _candidateIndices[i - first];
+            if(NO_CANDIDATE != candidate && canDetectInBatch(objectA, objectB)) {
+                collision = _candidates.hit[candidate];
+                tmin = _candidates.tmin[candidate];
+                tmax = _candidates.tmax[candidate];
+            }
+            else {
+                collision = detectCollision(objectA, objectB, &tmin, &tmax);
+            }
+
+            if(collision) {
+                objectA.getObjectPhysics().wakeUp();
+                objectB.getObjectPhysics().wakeUp();
+                handleCollision(objectA.shared_from_this(), objectB.shared_from_this(), tmin, tmax);
             }
         }
     }
@@ -317,8 +364,16 @@ void CollisionSystem::updateObjectCollisions()
 
 void CollisionSystem::updateParticleCollisions()
 {
-    //Check collisions with particles
-    for(const std::shared_ptr<Ego::Particle> &particle : ParticleHandler::get().iterator())
+    //Objects killed by particles must stay alive while their pairs are handled
+    ObjectHandler::ObjectIterator objectLock = _currentModule->getObjectHandler().iterator();
+
+    //Particles are short-lived, so their broadphase is sorted from scratch. The proxies refer to
+    //the shared pointers in the active particle list, which does not change while it is locked.
+    ParticleHandler::ParticleIterator particles = ParticleHandler::get().iterator();
+    _particleBroadphase.clear();
+    _particleBroadphase.begin();
+    size_t key = 0;
+    for(const std::shared_ptr<Ego::Particle> &particle : particles)
     {
         if(!particle->canCollide()) {
             continue;
@@ -334,39 +389,114 @@ void CollisionSystem::updateParticleCollisions()
         oct_bb_t   tmp_oct;
         phys_expand_prt_bb(particle.get(), 0.0f, 1.0f, tmp_oct);
         const AxisAlignedBox2f aabb2d = AxisAlignedBox2f(Point2f(tmp_oct._mins[OCT_X], tmp_oct._mins[OCT_Y]), Point2f(tmp_oct._maxs[OCT_X], tmp_oct._maxs[OCT_Y]));
+        _particleBroadphase.update(key++, &particle, aabb2d);
+    }
+    _particleBroadphase.end();
+
+    //Detect collisions with nearby Objects
+    //Collect the pairs, all pairs of a particle are consecutive
+    _particlePairs.clear();
+    _particleBroadphase.findPairs(_objectBroadphase, [this](const std::shared_ptr<Ego::Particle> &particle, Object &object)
+    {
+        _particlePairs.emplace_back(&particle, &object);
+    });
+
+    for(size_t first = 0, last = 0; first < _particlePairs.size(); first = last)
+    {
+        const std::shared_ptr<Ego::Particle> &particle = *_particlePairs[first].first;
+
+        //Test all objects near this particle which are not platforms at once
+        _candidates.clear();
+        _candidateIndices.clear();
+        for(last = first; last < _particlePairs.size() && _particlePairs[last].first == &particle; ++last)
+        {
+            const Object &object = *_particlePairs[last].second;
+            size_t candidate = NO_CANDIDATE;
+            if(object.canCollide() && canDetectInBatch(particle, object)) {
+                candidate = _candidates.size();
+                _candidates.push_back(object.chr_min_cv, object.getPosition(), object.vel);
+            }
+            _candidateIndices.push_back(candidate);
+        }
+        phys_intersect_oct_bb_batch(particle->prt_max_cv, particle->getPosition(), particle->vel, _candidates);
 
-        //Detect collisions with nearby Objects
-        std::vector<std::shared_ptr<Object>> possibleCollisions;
-         _currentModule->getObjectHandler().findObjects(aabb2d, possibleCollisions, true);
-        for (const std::shared_ptr<Object> &object : possibleCollisions)
+        //Handle the collisions in order
+        for(size_t i = first; i < last; ++i)
         {
+            Object &object = *_particlePairs[i].second;
+
             //Is it a valid collision?
-            if(!object->canCollide()) {
+            if(!object.canCollide()) {
                 continue;
             }
 
             //Detect any collisions and handle it if needed
             float tmin, tmax;
-            if(detectCollision(particle, object, &tmin, &tmax)) {
-                do_prt_platform_detection(object->getObjRef(), particle->getParticleID());
-                do_chr_prt_collision(object, particle, tmin, tmax);
+            bool collision;
+            const size_t candidate = _candidateIndices[i - first];
+            if(NO_CANDIDATE != candidate && canDetectInBatch(particle, object)) {
+                collision = _candidates.hit[candidate];
+                tmin = _candidates.tmin[candidate];
+                tmax = _candidates.tmax[candidate];
+            }
+            else {
+                collision = detectCollision(particle, object, &tmin, &tmax);
+            }
+
+            if(collision) {
+                object.getObjectPhysics().wakeUp();
+                do_prt_platform_detection(object.getObjRef(), particle->getParticleID());
+                do_chr_prt_collision(object.shared_from_this(), particle, tmin, tmax);
             }
         }
-    }    
+    }
 }
 
-bool CollisionSystem::detectCollision(const std::shared_ptr<Ego::Particle> &particle, const std::shared_ptr<Object> &object, float *tmin, float *tmax) const
+bool CollisionSystem::isCollisionCandidate(const Object &objectA, const Object &objectB) const
+{
+    //Can they collide?
+    if(!objectA.canCollide() || !objectB.canCollide()) {
+        return false;
+    }
+
+    //Do not collide scenery with other scenery objects - unless they can use platforms,
+    //for example boxes stacked on top of other boxes
+    if(objectA.isScenery() && !objectA.canuseplatforms && objectB.isScenery()) {
+        return false;
+    }
+
+    //Nothing to do if neither of them is moving
+    if(objectA.getObjectPhysics().isSleeping() && objectB.getObjectPhysics().isSleeping()) {
+        return false;
+    }
+
+    return true;
+}
+
+bool CollisionSystem::canDetectInBatch(const Object &objectA, const Object &objectB) const
+{
+    return canInteract(objectA, objectB) && EMPTY_BIT_FIELD == getPlatformTest(objectA, objectB)
+        && !objectA.chr_max_cv.isEmpty() && !objectB.chr_max_cv.isEmpty();
+}
+
+bool CollisionSystem::canDetectInBatch(const std::shared_ptr<Ego::Particle> &particle, const Object &object) const
+{
+    return particle->getAttachedObject().get() != &object && !object.platform
+        && !particle->prt_max_cv.isEmpty() && !object.chr_min_cv.isEmpty();
+}
+
+bool CollisionSystem::detectCollision(const std::shared_ptr<Ego::Particle> &particle, const Object &object, float *tmin, float *tmax) const
 {
     // particles don't "collide" with anything they are attached to.
     // that only happes through doing bump particle damage
-    if (particle->getAttachedObject() == object)
+    if (particle->getAttachedObject().get() == &object)
     {
         return false;
     }
 
     //Detect collisions with platforms?
     BIT_FIELD testPlatform = EMPTY_BIT_FIELD;
-    if ( object->platform /*&& ( SPRITE_SOLID == particle->type )*/ ) {
+    if ( object.platform /*&& ( SPRITE_SOLID == particle->type )*/ ) {
         SET_BIT(testPlatform, PHYS_PLATFORM_OBJ1);
     }
 
@@ -375,40 +505,53 @@ bool CollisionSystem::detectCollision(const std::shared_ptr<Ego::Particle> &part
     oct_bb_t cv;
 
     // detect a when the possible collision occurred
-    return phys_intersect_oct_bb(object->chr_min_cv, object->getPosition(), object->vel, particle->prt_max_cv, particle->getPosition(), particle->vel, testPlatform, cv, tmin, tmax);
+    return phys_intersect_oct_bb(object.chr_min_cv, object.getPosition(), object.vel, particle->prt_max_cv, particle->getPosition(), particle->vel, testPlatform, cv, tmin, tmax);
 }
 
-bool CollisionSystem::detectCollision(const std::shared_ptr<Object> &objectA, const std::shared_ptr<Object> &objectB, float *tmin, float *tmax) const
+bool CollisionSystem::canInteract(const Object &objectA, const Object &objectB) const
 {
     // "non-interacting" objects interact with platforms
-    if ((0 == objectA->bump.size && !objectB->platform ) ||
-        (0 == objectB->bump.size && !objectA->platform )) {
+    if ((0 == objectA.bump.size && !objectB.platform ) ||
+        (0 == objectB.bump.size && !objectA.platform )) {
         return false;
     }
 
     // handle the dismount exception
-    if (objectA->dismount_timer > 0 && objectA->dismount_object == objectB->getObjRef()) {
+    if (objectA.dismount_timer > 0 && objectA.dismount_object == objectB.getObjRef()) {
         return false;
     }
-    if (objectB->dismount_timer > 0 && objectB->dismount_object == objectA->getObjRef()) {
+    if (objectB.dismount_timer > 0 && objectB.dismount_object == objectA.getObjRef()) {
         return false;
     }
 
+    return true;
+}
+
+BIT_FIELD CollisionSystem::getPlatformTest(const Object &objectA, const Object &objectB) const
+{
     //Is it a platform collision?
     BIT_FIELD testPlatform = EMPTY_BIT_FIELD;
-    if (objectA->platform && objectB->canuseplatforms) {
+    if (objectA.platform && objectB.canuseplatforms) {
         SET_BIT(testPlatform, PHYS_PLATFORM_OBJ1);
     }
-    if (objectB->platform && objectA->canuseplatforms) {
+    if (objectB.platform && objectA.canuseplatforms) {
         SET_BIT(testPlatform, PHYS_PLATFORM_OBJ2);
     }
+    return testPlatform;
+}
+
+bool CollisionSystem::detectCollision(const Object &objectA, const Object &objectB, float *tmin, float *tmax) const
+{
+    if (!canInteract(objectA, objectB)) {
+        return false;
+    }
 
     // Some information about the estimated collision.
     //TODO: ZF> hmmm unused?
     oct_bb_t cv;
 
     // detect a when the possible collision occurred
-    return phys_intersect_oct_bb(objectA->chr_max_cv, objectA->getPosition(), objectA->vel, objectB->chr_max_cv, objectB->getPosition(), objectB->vel, testPlatform, cv, tmin, tmax);
+    return phys_intersect_oct_bb(objectA.chr_max_cv, objectA.getPosition(), objectA.vel, objectB.chr_max_cv, objectB.getPosition(), objectB.vel, getPlatformTest(objectA, objectB), cv, tmin, tmax);
 }
 
 void CollisionSystem::handleCollision(const std::shared_ptr<Object> &objectA, const std::shared_ptr<Object> &objectB, const float tmin, const float tmax)
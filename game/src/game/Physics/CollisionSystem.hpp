@@ -20,6 +20,7 @@
 
 #include "IdLib/IdLib.hpp"
 #include "egolib/egolib.h"
+#include "game/physics.h"
 
 //Forward declarations
 namespace Ego { class Particle; }
@@ -40,13 +41,44 @@ public:
 
     /**
     * @brief
-    *   Detect and handle all Particle to Object collisions
+    *   Detect and handle all Particle to Object collisions.
+    *   Uses the object broadphase built by updateObjectCollisions().
     **/
     void updateParticleCollisions();
 
     void update();
 
 private:
+    /**
+    * @return
+    *   true if the broadphase pair of objectA and objectB needs to be tested for a collision
+    **/
+    bool isCollisionCandidate(const Object &objectA, const Object &objectB) const;
+
+    /**
+    * @return
+    *   false if these two Objects can never interact with each other, for example while dismounting
+    **/
+    bool canInteract(const Object &objectA, const Object &objectB) const;
+
+    /**
+    * @return
+    *   Which of the two Objects can act as a platform for the other (PHYS_PLATFORM_OBJ1, PHYS_PLATFORM_OBJ2)
+    **/
+    BIT_FIELD getPlatformTest(const Object &objectA, const Object &objectB) const;
+
+    /**
+    * @return
+    *   true if detecting a collision between these two Objects can be done with phys_intersect_oct_bb_batch()
+    **/
+    bool canDetectInBatch(const Object &objectA, const Object &objectB) const;
+
+    /**
+    * @return
+    *   true if detecting a collision between this Particle and Object can be done with phys_intersect_oct_bb_batch()
+    **/
+    bool canDetectInBatch(const std::shared_ptr<Ego::Particle> &particle, const Object &object) const;
+
     /**
     * @brief
     *   Detects if a collision occurs between two Objects
@@ -57,7 +89,7 @@ private:
     * @return
     *   true if these two Object actually collide, false otherwise
     **/
-    bool detectCollision(const std::shared_ptr<Object> &objectA, const std::shared_ptr<Object> &objectB, float *tmin, float *tmax) const;
+    bool detectCollision(const Object &objectA, const Object &objectB, float *tmin, float *tmax) const;
 
     /**
     * @brief
@@ -69,7 +101,7 @@ private:
     * @return
     *   true if these two Entities actually collide, false otherwise
     **/
-    bool detectCollision(const std::shared_ptr<Ego::Particle> &particle, const std::shared_ptr<Object> &object, float *tmin, float *tmax) const;
+    bool detectCollision(const std::shared_ptr<Ego::Particle> &particle, const Object &object, float *tmin, float *tmax) const;
 
     /**
     * @brief
@@ -104,6 +136,17 @@ private:
     friend Core::Singleton<CollisionSystem>::DestroyFunctorType;
     CollisionSystem();
     ~CollisionSystem();
+
+private:
+    Ego::SweepAndPrune<Object> _objectBroadphase;                                       ///< Objects that can collide, kept sorted with their pairs between updates
+    Ego::SweepAndPrune<const std::shared_ptr<Ego::Particle>> _particleBroadphase;       ///< Particles that can collide, sorted every update
+
+    std::vector<std::pair<Object*, Object*>> _objectPairs;                                  ///< Object pairs found by the broadphase in this update
+    std::vector<std::pair<const std::shared_ptr<Ego::Particle>*, Object*>> _particlePairs;  ///< Particle and Object pairs found by the broadphase
+    phys_oct_bb_batch_t _candidates;                                                        ///< Pairs of one Object or Particle tested at once
+    std::vector<size_t> _candidateIndices;                                                  ///< Index of each pair in _candidates or NO_CANDIDATE
+
+    static const size_t NO_CANDIDATE = std::numeric_limits<size_t>::max();
 };
 
 } //namespace Physics
@@ -37,7 +37,10 @@ ObjectPhysics::ObjectPhysics(Object &object) :
     _desiredVelocity(0.0f, 0.0f),
     _traction(1.0f),
     _groundElevation(0.0f),
-    _aabb2D()
+    _aabb2D(),
+    _restingUpdates(0),
+    _sleeping(false),
+    _restingPosition()
 {
     //ctor
 }
@@ -248,8 +251,18 @@ void ObjectPhysics::updateVelocityZ()
 
 void ObjectPhysics::updatePhysics()
 {
+    //Sleeping objects stay asleep until something moves them, for example an AI script
+    //giving them a velocity or another system teleporting them
+    if(_sleeping) {
+        if(isResting() && (_object.getPosition() - _restingPosition).length_abs() == 0.0f) {
+            return;
+        }
+        wakeUp();
+    }
+
     // Keep inventory items with the carrier
     if(_object.isInsideInventory()) {
+        _restingUpdates = 0;
         _object.setPosition(_currentModule->getObjectHandler()[_object.inwhich_inventory]->getPosition());
         return;
     }
@@ -260,6 +273,7 @@ void ObjectPhysics::updatePhysics()
 
     //Is this character being held by another character?
     if(_object.isBeingHeld()) {
+        _restingUpdates = 0;
         keepItemsWithHolder();
         return;
     }
@@ -287,6 +301,52 @@ void ObjectPhysics::updatePhysics()
     //Recalculate the altitude of the ground beneath our feet
     //Apperantly this function is quite expensive so cache the result every update
     _groundElevation = recalculateGroundElevation();
+
+    //Fall asleep after resting on the ground for a while
+    if(isResting() && isTouchingGround()) {
+        _restingUpdates++;
+        if(_restingUpdates >= SLEEP_DELAY) {
+            _sleeping = true;
+            _restingPosition = _object.getPosition();
+        }
+    }
+    else {
+        _restingUpdates = 0;
+    }
+}
+
+bool ObjectPhysics::isResting() const
+{
+    if(_object.vel.length_abs() > 0.0f || _desiredVelocity.length_abs() > 0.05f) {
+        return false;
+    }
+
+    if(_object.isFlying() || _object.isBeingHeld() || _object.isInsideInventory()) {
+        return false;
+    }
+
+    //Objects standing on a platform may only sleep while their platform sleeps
+    const std::shared_ptr<Object> &platform = _object.getAttachedPlatform();
+    if(platform && !platform->getObjectPhysics().isSleeping()) {
+        return false;
+    }
+
+    return true;
+}
+
+bool ObjectPhysics::isSleeping() const
+{
+    return _sleeping;
+}
+
+void ObjectPhysics::wakeUp()
+{
+    //The collision accumulators are not cleared while sleeping
+    if(_sleeping) {
+        _object.phys.clear();
+        _sleeping = false;
+    }
+    _restingUpdates = 0;
 }
 
 float ObjectPhysics::recalculateGroundElevation()
@@ -447,6 +507,9 @@ void ObjectPhysics::detachFromPlatform()
     _object.targetplatform_ref     = ObjectRef::Invalid;
     _object.targetplatform_level   = -1e32;
     _platformOffset = Vector2f::zero();
+
+    //Fall down if we were sleeping on the platform
+    wakeUp();
 }
 
 bool ObjectPhysics::attachToPlatform(const std::shared_ptr<Object> &platform)
@@ -666,55 +729,54 @@ bool ObjectPhysics::grabStuff(grip_offset_t grip_off, bool grab_people)
     Vector3f   slot_pos = Vector3f(mids[OCT_X], mids[OCT_Y], mids[OCT_Z]) + _object.getPosition();
 
     //The object that we grab
-    std::shared_ptr<Object> bestMatch = nullptr;
+    Object *bestMatch = nullptr;
     float bestMatchDistance = std::numeric_limits<float>::max();
 
     // Go through all nearby objects to find the best match
-    std::vector<std::shared_ptr<Object>> nearbyObjects = _currentModule->getObjectHandler().findObjects(slot_pos.x(), slot_pos.y(), MAX_SEARCH_DIST, false);
-    for(const std::shared_ptr<Object> &pchr_c : nearbyObjects)
+    _currentModule->getObjectHandler().visitObjects(slot_pos.x(), slot_pos.y(), MAX_SEARCH_DIST, false, [&](Object &pchr_c)
     {
         //Skip invalid objects
-        if(pchr_c->isTerminated()) {
-            continue;
+        if(pchr_c.isTerminated()) {
+            return;
         }
 
         // do nothing to yourself
-        if (_object.getObjRef() == pchr_c->getObjRef()) continue;
+        if (_object.getObjRef() == pchr_c.getObjRef()) return;
 
         // Dont do hidden objects
-        if (pchr_c->isHidden()) continue;
+        if (pchr_c.isHidden()) return;
 
         // disarm and pickpocket not allowed yet
-        if (pchr_c->isBeingHeld()) continue;
+        if (pchr_c.isBeingHeld()) return;
 
         // do not pick up your mount
-        if ( pchr_c->holdingwhich[SLOT_LEFT] == _object.getObjRef() ||
-             pchr_c->holdingwhich[SLOT_RIGHT] == _object.getObjRef() ) continue;
+        if ( pchr_c.holdingwhich[SLOT_LEFT] == _object.getObjRef() ||
+             pchr_c.holdingwhich[SLOT_RIGHT] == _object.getObjRef() ) return;
 
         // do not notice completely broken items?
-        if (pchr_c->isItem() && !pchr_c->isAlive()) continue;
+        if (pchr_c.isItem() && !pchr_c.isAlive()) return;
 
         // reasonable carrying capacity
-        if (pchr_c->phys.weight > _object.phys.weight + FLOAT_TO_FP8(_object.getAttribute(Ego::Attribute::MIGHT)) * INV_FF<float>()) {
-            continue;
+        if (pchr_c.phys.weight > _object.phys.weight + FLOAT_TO_FP8(_object.getAttribute(Ego::Attribute::MIGHT)) * INV_FF<float>()) {
+            return;
         }
 
         // grab_people == true allows you to pick up living non-items
         // grab_people == false allows you to pick up living (functioning) items
-        if (!grab_people && !pchr_c->isItem()) {
-            continue;
+        if (!grab_people && !pchr_c.isItem()) {
+            return;
         }
 
         // calculate the distance
-        const float horizontalDistance = (pchr_c->getPosition() - slot_pos).length();
-        const float verticalDistance = std::sqrt(Ego::Math::sq(_object.getPosZ() - pchr_c->getPosZ()));
+        const float horizontalDistance = (pchr_c.getPosition() - slot_pos).length();
+        const float verticalDistance = std::sqrt(Ego::Math::sq(_object.getPosZ() - pchr_c.getPosZ()));
  
         //Figure out if the character is looking towards the object
-        const bool isFacingObject = _object.isFacingLocation(pchr_c->getPosX(), pchr_c->getPosY());
+        const bool isFacingObject = _object.isFacingLocation(pchr_c.getPosX(), pchr_c.getPosY());
 
         // Is it too far away to interact with?
         if (horizontalDistance > MAX_SEARCH_DIST || verticalDistance > MAX_SEARCH_DIST) {
-            continue;
+            return;
         }
 
         // visibility affects the max grab distance.
@@ -736,7 +798,7 @@ bool ObjectPhysics::grabStuff(grip_offset_t grip_off, bool grab_people)
 
         // is it too far away to grab?
         if (horizontalDistance > maxHorizontalGrabDistance + _object.bump.size / 4.0f && horizontalDistance > _object.bump.size) {
-            continue;
+            return;
         }
 
         //Check vertical distance as well
@@ -750,25 +812,25 @@ bool ObjectPhysics::grabStuff(grip_offset_t grip_off, bool grab_people)
             }
 
             if (verticalDistance > maxVerticalGrabDistance) {
-                continue;
+                return;
             }
         }
 
         //Is this one better to grab than any previous matches?
         if(horizontalDistance < bestMatchDistance) {
             bestMatchDistance = horizontalDistance;
-            bestMatch = pchr_c;
+            bestMatch = &pchr_c;
 
             //Prioritize items in front of us over those behind us
             if(!isFacingObject) {
                 bestMatchDistance *= 2.0f;
             }
         }
-    }
+    });
 
     if(bestMatch != nullptr) {
         const std::shared_ptr<Object> &grabber = _currentModule->getObjectHandler()[_object.getObjRef()];
-        if (Shop::canGrabItem(grabber, bestMatch))
+        if (Shop::canGrabItem(grabber, bestMatch->shared_from_this()))
         {
             // Stick 'em together and quit
             if(bestMatch->getObjectPhysics().attachToObject(grabber, grip_off))
@@ -850,7 +912,7 @@ bool ObjectPhysics::attachToObject(const std::shared_ptr<Object> &holder, grip_o
     _object.setPosition(mat_getTranslate(_object.inst.getMatrix()));
 
     _object.inwater  = false;
-    _object.jump_timer = Object::JUMPDELAY * 4;
+    _object.setTimer(&Object::jump_timer, Object::JUMPDELAY * 4);
 
     // Run the held animation
     if (holder->isMount() && (GRIP_ONLY == grip_off))
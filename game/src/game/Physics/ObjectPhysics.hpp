@@ -46,6 +46,20 @@ public:
     **/
     void updatePhysics();
 
+    /**
+    * @return
+    *   true if this Object has been resting for a while and is skipped by the physics
+    *   and collision updates until something moves it
+    **/
+    bool isSleeping() const;
+
+    /**
+    * @brief
+    *   Wake this Object up if it is sleeping and restart counting the updates it has been resting.
+    *   Called when it collides with something, takes damage or loses its platform.
+    **/
+    void wakeUp();
+
     /// @details attach a character to a platform
     void detachFromPlatform();
 
@@ -197,6 +211,13 @@ private:
     **/
     float recalculateGroundElevation();
 
+    /**
+    * @return
+    *   true if nothing makes this Object move: it has no velocity, no desired movement, is not
+    *   flying or held and is not standing on a platform that is awake
+    **/
+    bool isResting() const;
+
 private:
     static constexpr float FLOOR_TOLERANCE = 20.0f;         //< Z tolerance for when we are touching the floor
     static constexpr float MAX_DISPLACEMENT_XY = 20.0f;     //< Max velocity correction due to being inside a wall
@@ -204,6 +225,7 @@ private:
     static constexpr uint16_t SPINRATE = 200;               //< How fast spinners spin
     static constexpr float WATCHMIN = 0.1f;                 //< Tolerance for TURNMODE_WATCH
     static constexpr float FLYDAMPEN = 0.001f;              ///< Levelling rate for flyers
+    static constexpr uint32_t SLEEP_DELAY = 50;             //< Number of resting updates before an Object falls asleep
 
     Object &_object;                //< The actual Entity that this physics class represents
     Vector2f _platformOffset;       //< Offset from the center of the platform we are standing on (if any) 
@@ -211,6 +233,9 @@ private:
     float _traction;                //< How good grip do we have on the floor to generate movement?
     float _groundElevation;         //< Cached value of ground elevation below Object (could be platform or water)
     AxisAlignedBox2f _aabb2D;       //< 2-dimensional bounding box (for fast & rough collision detection)
+    uint32_t _restingUpdates;       //< Number of consecutive updates this Object has been resting
+    bool _sleeping;                 //< Skip physics and collisions until something moves this Object
+    Vector3f _restingPosition;      //< Where this Object fell asleep
 };
 
 } //Physics
@@ -9,7 +9,9 @@ namespace Physics
 {
 
 ParticlePhysics::ParticlePhysics(Ego::Particle &particle) :
-	_particle(particle)
+	_particle(particle),
+    _commands(nullptr),
+    _commandKey(0)
 {
 	//ctor
 }
@@ -53,6 +55,32 @@ void ParticlePhysics::updatePhysics()
     }
 }
 
+void ParticlePhysics::updatePhysicsConcurrent(Ego::Core::CommandBuffer& commands, size_t key)
+{
+    _commands = &commands;
+    _commandKey = key;
+    updatePhysics();
+    _commands = nullptr;
+}
+
+bool ParticlePhysics::isConcurrent() const
+{
+    return !_particle.getProfile()->homing && 0.0f == _particle.getProfile()->getGravityPull();
+}
+
+void ParticlePhysics::playSound(int8_t sound)
+{
+    //The audio system is not thread-safe
+    if (nullptr != _commands) {
+        Ego::Particle *particle = &_particle;
+        const Vector3f position = _particle.getPosition();
+        _commands->record(_commandKey, [particle, sound, position]() { particle->playSound(sound, position); });
+    }
+    else {
+        _particle.playSound(sound);
+    }
+}
+
 void ParticlePhysics::updateMovement()
 {
     Ego::prt_environment_t *penviro = &(_particle.enviro);
@@ -120,7 +148,7 @@ void ParticlePhysics::updateMovement()
     if (hit_a_floor)
     {
         // Play the sound for hitting the floor [FSND]
-        _particle.playSound(_particle.getProfile()->end_sound_floor);
+        playSound(_particle.getProfile()->end_sound_floor);
     }
 
     // handle the collision
@@ -160,7 +188,7 @@ void ParticlePhysics::updateMovement()
     if (hit_a_wall)
     {
         // Play the sound for hitting the wall [WSND]
-        _particle.playSound(_particle.getProfile()->end_sound_wall);
+        playSound(_particle.getProfile()->end_sound_wall);
     }
 
     // handle the collision
@@ -279,7 +307,7 @@ void ParticlePhysics::updateAttached()
     if (_particle.getPosition().z() < penviro->adj_level)
     {
         // Play the sound for hitting the floor [FSND]
-        _particle.playSound(_particle.getProfile()->end_sound_floor);
+        playSound(_particle.getProfile()->end_sound_floor);
 
         if(_particle.getProfile()->end_ground)
         {
@@ -472,24 +500,23 @@ void ParticlePhysics::updateGravity()
         const auto &particleTeam = _currentModule->getTeamList()[_particle.team];
 
         //Pull all nearby objects
-        std::vector<std::shared_ptr<Object>> affectedObjects = _currentModule->getObjectHandler().findObjects(_particle.getPosX(), _particle.getPosY(), pullDistance, false);
-        for(const std::shared_ptr<Object> &object : affectedObjects)
+        _currentModule->getObjectHandler().visitObjects(_particle.getPosX(), _particle.getPosY(), pullDistance, false, [&](Object &object)
         {
             //Do not affect the object we are attached to
-            if(_particle.getAttachedObject() == object) continue;
+            if(_particle.getAttachedObject().get() == &object) return;
 
             //Allow friendly fire?
-            if(!_particle.getProfile()->hateonly && !particleTeam.hatesTeam(object->getTeam())) continue;
+            if(!_particle.getProfile()->hateonly && !particleTeam.hatesTeam(object.getTeam())) return;
 
             //Skip objects that cannot collide
-            if(!object->canCollide()) continue;
+            if(!object.canCollide()) return;
 
-            const Vector3f pull = _particle.getPosition() - object->getPosition();
+            const Vector3f pull = _particle.getPosition() - object.getPosition();
             const float distance = pull.length_2();
             if(distance > 10.0f) {
-                object->vel += (pull * _particle.getProfile()->getGravityPull()) * (1.0f/distance);
+                object.vel += (pull * _particle.getProfile()->getGravityPull()) * (1.0f/distance);
             }
-        }
+        });
 
         //Pull all nearby particles
         for(const std::shared_ptr<Ego::Particle> &particle : ParticleHandler::get().iterator())
@@ -15,6 +15,24 @@ public:
 
 	void updatePhysics();
 
+    /**
+    * @brief
+    *   Update the physics of this particle concurrently with the physics of other particles.
+    *   Sounds are recorded into the command buffer.
+    * @remark
+    *   Only valid if isConcurrent() is @a true.
+    **/
+    void updatePhysicsConcurrent(Ego::Core::CommandBuffer& commands, size_t key);
+
+    /**
+    * @brief
+    *   Get if the physics of this particle can be updated concurrently with other particles.
+    * @return
+    *   @a false if this particle is homing (this draws random numbers) or has a gravity pull
+    *   (this changes other particles and objects), @a true otherwise
+    **/
+    bool isConcurrent() const;
+
     void detachFromPlatform();
 
 private:
@@ -46,10 +64,16 @@ private:
     **/
     void updateGravity();
 
+    /// @brief
+    /// Play a sound of this particle, or record it if updated concurrently.
+    void playSound(int8_t sound);
+
 private:
 	static constexpr float STOPBOUNCINGPART = 10.0f;        ///< To make particles stop bouncing
 
 	Ego::Particle& _particle;
+    Ego::Core::CommandBuffer *_commands;   ///< The command buffer if updated concurrently
+    size_t _commandKey;                     ///< The key of the recorded commands
 };
 
 } //Physics
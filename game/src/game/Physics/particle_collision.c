@@ -568,13 +568,13 @@ bool do_chr_prt_collision_deflect(chr_prt_collision_data_t& pdata)
                 {
                     // Defender won, the block holds
                     // Add a small stun to the attacker = 40/50 (0.8 seconds)
-                    pattacker->reload_timer += 40;
+                    pattacker->setTimer(&Object::reload_timer, pattacker->getTimer(&Object::reload_timer) + 40);
                 }
                 else
                 {
                     // Attacker broke the block and batters away the shield
                     // Time to raise shield again = 40/50 (0.8 seconds)
-                    pdata.pchr->reload_timer += 40;
+                    pdata.pchr->setTimer(&Object::reload_timer, pdata.pchr->getTimer(&Object::reload_timer) + 40);
                     AudioSystem::get().playSound(pdata.pchr->getPosition(), AudioSystem::get().getGlobalSound(GSND_SHIELDBLOCK));
                 }
             }
@@ -30,10 +30,12 @@
 #include "game/GameStates/PlayingState.hpp"
 #include "game/Inventory.hpp"
 #include "game/Logic/Player.hpp"
+#include "game/Logic/InputReplay.hpp"
 #include "game/link.h"
 #include "game/graphic.h"
 #include "game/graphic_fan.h"
 #include "game/graphic_billboard.h"
+#include "game/script_compile.h"
 #include "game/script_implementation.h"
 #include "game/egoboo.h"
 #include "game/Core/GameEngine.hpp"
@@ -68,6 +70,14 @@ uint32_t update_wld       = 0;
 int chr_stoppedby_tests = 0;
 int chr_pressure_tests = 0;
 
+/// Profiling timer for update_game().
+Ego::Time::Clock<Ego::Time::ClockPolicy::NonRecursive> update_game_timer("update.game", 512);
+/// Profiling timers for the phases of update_game().
+Ego::Time::Clock<Ego::Time::ClockPolicy::NonRecursive> update_ai_timer("update.ai", 512);
+Ego::Time::Clock<Ego::Time::ClockPolicy::NonRecursive> update_all_objects_timer("update.all.objects", 512);
+Ego::Time::Clock<Ego::Time::ClockPolicy::NonRecursive> move_all_objects_timer("move.all.objects", 512);
+Ego::Time::Clock<Ego::Time::ClockPolicy::NonRecursive> collision_update_timer("collision.update", 512);
+
 //--------------------------------------------------------------------------------------------
 //--------------------------------------------------------------------------------------------
 
@@ -287,13 +297,7 @@ void move_all_objects()
     chr_stoppedby_tests = 0;
 
     // move every particle
-    for(const std::shared_ptr<Ego::Particle> &particle : ParticleHandler::get().iterator())
-    {
-        if(particle->isTerminated()) {
-            continue;
-        }
-        particle->getParticlePhysics().updatePhysics();
-    }
+    ParticleHandler::get().updateAllPhysics();
 
     // Move every character
     for(const std::shared_ptr<Object> &object : _currentModule->getObjectHandler().iterator())
@@ -379,6 +383,8 @@ int update_game()
     /// @details This function does several iterations of character movements and such
     ///    to keep the game in sync.
 
+    Ego::Time::ClockScope<Ego::Time::ClockPolicy::NonRecursive> updateGameScope(update_game_timer);
+
     //status text for player stats
     check_stats();
 
@@ -388,12 +394,15 @@ int update_game()
     // keep the mpdfx lists up-to-date. No calculation is done unless one
     // of the mpdfx values was changed during the last update
     _currentModule->getMeshPointer()->_fxlists.synch(_currentModule->getMeshPointer()->_tmem, false);
+
+    // line of sight results are only reused within an update
+    _currentModule->getMeshPointer()->_losCache.clear();
     
     // Get immediate mode state for the rest of the game
     Ego::Input::InputSystem::get().update();
 
-    //Rebuild the quadtree for fast object lookup
-    _currentModule->getObjectHandler().updateQuadTree(0.0f, 0.0f, _currentModule->getMeshPointer()->_info.getTileCountX()*Info<float>::Grid::Size(),
+    //Update the spatial grid for fast object lookup
+    _currentModule->getObjectHandler().updateSpatialGrid(0.0f, 0.0f, _currentModule->getMeshPointer()->_info.getTileCountX()*Info<float>::Grid::Size(),
 		                                                          _currentModule->getMeshPointer()->_info.getTileCountY()*Info<float>::Grid::Size());
 
     //---- begin the code for updating misc. game stuff
@@ -412,16 +421,30 @@ int update_game()
     //---- Run AI (but not on first update frame)
     if(_gameEngine->getCurrentUpdateFrame() > 0)
     {
+        Ego::Time::ClockScope<Ego::Time::ClockPolicy::NonRecursive> scope(update_ai_timer);
         let_all_characters_think();           //sets the non-player latches
         readPlayerInput();                    //sets latches generated by players
     }
 
     //---- begin the code for updating in-game objects
-    update_all_objects();
-    move_all_objects();                            //movement
-    Ego::Physics::CollisionSystem::get().update(); //collisions
+    {
+        Ego::Time::ClockScope<Ego::Time::ClockPolicy::NonRecursive> scope(update_all_objects_timer);
+        update_all_objects();
+    }
+    {
+        Ego::Time::ClockScope<Ego::Time::ClockPolicy::NonRecursive> scope(move_all_objects_timer);
+        move_all_objects();                            //movement
+    }
+    {
+        Ego::Time::ClockScope<Ego::Time::ClockPolicy::NonRecursive> scope(collision_update_timer);
+        Ego::Physics::CollisionSystem::get().update(); //collisions
+    }
     //---- end the code for updating in-game objects
 
+    //Update the spatial hash for fast particle lookup
+    ParticleHandler::get().updateSpatialHash(0.0f, 0.0f, _currentModule->getMeshPointer()->_info.getTileCountX()*Info<float>::Grid::Size(),
+                                                         _currentModule->getMeshPointer()->_info.getTileCountY()*Info<float>::Grid::Size());
+
     // put the camera movement inside here
     CameraSystem::get().updateAll(_currentModule->getMeshPointer().get());
 
@@ -600,7 +623,42 @@ ObjectRef chr_find_target( Object * psrc, float max_dist, const IDSZ2& idsz, con
 
     if (!psrc || psrc->isTerminated()) return ObjectRef::Invalid;
 
-    std::vector<std::shared_ptr<Object>> searchList;
+    // set the line-of-sight source
+    los_info.x0         = psrc->getPosX();
+    los_info.y0         = psrc->getPosY();
+    los_info.z0         = psrc->getPosZ() + psrc->bump.height;
+    los_info.stopped_by = psrc->stoppedby;
+
+    ObjectRef best_target = ObjectRef::Invalid;
+    float best_dist2  = (max_dist == NEAREST) ? std::numeric_limits<float>::max() : max_dist*max_dist + 1.0f;
+    auto consider = [&](Object &ptst)
+    {
+        if(ptst.isTerminated()) return;
+
+        //Skip held items
+        if(ptst.isBeingHeld()) return;
+
+        //Only closer targets can be better (checked first, it is cheaper than chr_check_target)
+        float dist2 = (psrc->getPosition() - ptst.getPosition()).length_2();
+        if (dist2 >= best_dist2) return;
+
+        if (!chr_check_target(psrc, ptst.shared_from_this(), idsz, targeting_bits)) return;
+
+        //Invictus chars do not need a line of sight
+        if ( !psrc->isInvincible() )
+        {
+            // set the line-of-sight source
+            los_info.x1 = ptst.getPosition()[kX];
+            los_info.y1 = ptst.getPosition()[kY];
+            los_info.z1 = ptst.getPosition()[kZ] + std::max( 1.0f, ptst.bump.height );
+
+            if ( line_of_sight_info_t::blocked( los_info, _currentModule->getMeshPointer() ) ) return;
+        }
+
+        //Set the new best target found
+        best_target = ptst.getObjRef();
+        best_dist2  = dist2;
+    };
 
     //Only loop through the players
     if ( HAS_SOME_BITS( targeting_bits, TARGET_PLAYERS ) || HAS_SOME_BITS( targeting_bits, TARGET_QUEST ) )
@@ -613,7 +671,7 @@ ObjectRef chr_find_target( Object * psrc, float max_dist, const IDSZ2& idsz, con
                 //Within range?
                 float distance = (object->getPosition() - psrc->getPosition()).length();
                 if(max_dist == NEAREST || distance < max_dist) {
-                    searchList.push_back(object);
+                    consider(*object);
                 }
 
             }
@@ -623,51 +681,16 @@ ObjectRef chr_find_target( Object * psrc, float max_dist, const IDSZ2& idsz, con
     //All objects in level
     else if(max_dist == NEAREST)
     {
-        searchList = _currentModule->getObjectHandler().getAllObjects();
+        for(const std::shared_ptr<Object> &object : _currentModule->getObjectHandler().getAllObjects())
+        {
+            consider(*object);
+        }
     }
 
     //All objects within range
     else
     {
-        searchList = _currentModule->getObjectHandler().findObjects(psrc->getPosX(), psrc->getPosY(), max_dist, true);
-    }
-
-
-    // set the line-of-sight source
-    los_info.x0         = psrc->getPosX();
-    los_info.y0         = psrc->getPosY();
-    los_info.z0         = psrc->getPosZ() + psrc->bump.height;
-    los_info.stopped_by = psrc->stoppedby;
-
-    ObjectRef best_target = ObjectRef::Invalid;
-    float best_dist2  = (max_dist == NEAREST) ? std::numeric_limits<float>::max() : max_dist*max_dist + 1.0f;
-    for(const std::shared_ptr<Object> &ptst : searchList)
-    {
-        if(ptst->isTerminated()) continue;
-
-        //Skip held items
-        if(ptst->isBeingHeld()) continue;
-
-        if (!chr_check_target(psrc, ptst, idsz, targeting_bits)) continue;
-
-		float dist2 = (psrc->getPosition() - ptst->getPosition()).length_2();
-        if (dist2 < best_dist2)
-        {
-            //Invictus chars do not need a line of sight
-            if ( !psrc->isInvincible() )
-            {
-                // set the line-of-sight source
-                los_info.x1 = ptst->getPosition()[kX];
-                los_info.y1 = ptst->getPosition()[kY];
-                los_info.z1 = ptst->getPosition()[kZ] + std::max( 1.0f, ptst->bump.height );
-
-                if ( line_of_sight_info_t::blocked( los_info, _currentModule->getMeshPointer() ) ) continue;
-            }
-
-            //Set the new best target found
-            best_target = ptst->getObjRef();
-            best_dist2  = dist2;
-        }
+        _currentModule->getObjectHandler().visitObjects(psrc->getPosX(), psrc->getPosY(), max_dist, true, consider);
     }
 
     return best_target;
@@ -721,7 +744,12 @@ void WeatherState::animate()
 //--------------------------------------------------------------------------------------------
 void readPlayerInput()
 {
-    for(const std::shared_ptr<Ego::Player>& player : _currentModule->getPlayerList()) {
+    //Poll the input devices (or read the input from a recording)
+    static std::vector<Ego::Player::InputSample> inputs;
+    InputReplay::get().updateInput(_currentModule->getPlayerList(), inputs);
+
+    for(size_t i = 0; i < _currentModule->getPlayerList().size(); ++i) {
+        const std::shared_ptr<Ego::Player>& player = _currentModule->getPlayerList()[i];
 
         //Only valid players
         const std::shared_ptr<Object> &pchr = player->getObject();
@@ -729,12 +757,12 @@ void readPlayerInput()
             continue;
         }
 
-        //Read input from the device controlling the player into object latches
-        player->updateLatches();
+        //Apply the input of the device controlling the player to the object latches
+        player->applyInput(inputs[i]);
 
         //Press space to respawn!
         bool respawnRequested = false;
-        if (Ego::Input::InputSystem::get().isKeyDown(SDLK_SPACE)
+        if (inputs[i].respawn
             && (local_stats.allpladead || _currentModule->canRespawnAnyTime())
             && _currentModule->isRespawnValid()
             && egoboo_config_t::get().game_difficulty.getValue() < Ego::GameDifficulty::Hard)
@@ -1006,11 +1034,9 @@ void game_load_module_profiles( const std::string& modname )
 
 //--------------------------------------------------------------------------------------------
 void disaffirm_attached_particles(ObjectRef objectRef) {
-    for(const std::shared_ptr<Ego::Particle> &particle : ParticleHandler::get().iterator()) {
-        if (!particle->isTerminated() && particle->getAttachedObjectID() == objectRef) {
-            particle->requestTerminate();
-        }
-    }
+    ParticleHandler::get().visitAttachedParticles(objectRef, [](Ego::Particle &particle) {
+        particle.requestTerminate();
+    });
     if (_currentModule->getObjectHandler().exists(objectRef)) {
         // Set the alert for disaffirmation (wet torch).
         SET_BIT( _currentModule->getObjectHandler().get(objectRef)->ai.alert, ALERTIF_DISAFFIRMED );
@@ -1019,11 +1045,11 @@ void disaffirm_attached_particles(ObjectRef objectRef) {
 
 int number_of_attached_particles(ObjectRef objectRef) {
     int cnt = 0;
-    for(const std::shared_ptr<Ego::Particle> &particle : ParticleHandler::get().iterator()) {
-		if (particle->isAttached() && !particle->isTerminated() && particle->getAttachedObject()->getObjRef() == objectRef) {
+    ParticleHandler::get().visitAttachedParticles(objectRef, [&cnt](Ego::Particle &particle) {
+        if (particle.isAttached()) {
             cnt++;
         }
-    }
+    });
     return cnt;
 }
 
@@ -1089,8 +1115,10 @@ bool game_begin_module(const std::shared_ptr<ModuleProfile> &module)
     /// @author BB
     /// @details all of the initialization code before the module actually starts
 
-    // start the module
-    _currentModule = std::make_unique<GameModule>(module, time(NULL));
+    // start the module (a recorded session replaces the seed)
+    uint32_t seed = time(NULL);
+    InputReplay::get().beginModule(module->getFolderName(), seed);
+    _currentModule = std::make_unique<GameModule>(module, seed);
 
     //After loading, spawn all the data and initialize everything (spawn.txt)
     //Due to dependency on the global _currentModule, we cannot do this in the constructor above
@@ -1130,7 +1158,19 @@ void let_all_characters_think()
 {
     /// @author ZZ
     /// @details This function funst the ai scripts for all eligible objects
-    for(const std::shared_ptr<Object> &object : _currentModule->getObjectHandler().iterator())
+    /// @remark If concurrent scripts are enabled, the scripts which may run concurrently
+    /// (see scr_is_concurrent) run first, in parallel, on copies of the A.I. states. The
+    /// copies and then the commands recorded by these scripts are committed in the update
+    /// order. The remaining scripts run afterwards in the update order. The result does not
+    /// depend on the number of threads.
+
+    const bool concurrent = egoboo_config_t::get().game_concurrentScripts_enable.getValue() && !debug_scripts;
+
+    //Objects spawned by the scripts are added after the iterator is released
+    ObjectHandler::ObjectIterator objects = _currentModule->getObjectHandler().iterator();
+    std::vector<Object *> concurrentObjects, serialObjects;
+
+    for(const std::shared_ptr<Object> &object : objects)
     {
         if(object->isTerminated()) {
             continue;
@@ -1163,9 +1203,54 @@ void let_all_characters_think()
                 object->ai.timer = update_wld + 1;  //Prevents IfTimeOut from triggering
             }
 
-            scr_run_chr_script(object.get());
+            if (!concurrent) {
+                scr_run_chr_script(object.get());
+            }
+            else if (object->getProfile()->getAIScript()._concurrent) {
+                concurrentObjects.push_back(object.get());
+            }
+            else {
+                serialObjects.push_back(object.get());
+            }
         }
     }
+
+    if (!concurrent) {
+        return;
+    }
+
+    // Make sure that the scripting system is initialized before the scripts run concurrently.
+    scripting_system_begin();
+
+    // Run the concurrent scripts on copies of the A.I. states: Each script reads the states of other objects as of the beginning of the update.
+    static const size_t GRAIN_SIZE = 8;
+    static Ego::Core::CommandBuffer commands;
+    std::vector<ai_state_t> states;
+    states.reserve(concurrentObjects.size());
+    for (Object *object : concurrentObjects) {
+        states.push_back(object->ai);
+    }
+    std::vector<char> committed(concurrentObjects.size(), false);
+    commands.open();
+    Ego::Core::parallel_for(0, concurrentObjects.size(), GRAIN_SIZE, [&](size_t begin, size_t end) {
+        for (size_t i = begin; i < end; ++i) {
+            committed[i] = scr_run_chr_script_concurrent(concurrentObjects[i], states[i], commands, i);
+        }
+    });
+    commands.close();
+
+    // Commit the A.I. states before the recorded commands (e.g. orders) change them.
+    for (size_t i = 0; i < concurrentObjects.size(); ++i) {
+        if (committed[i]) {
+            scr_commit_chr_script(concurrentObjects[i], states[i]);
+        }
+    }
+    commands.execute();
+
+    // Run the remaining scripts.
+    for (Object *object : serialObjects) {
+        scr_run_chr_script(object);
+    }
 }
 
 //--------------------------------------------------------------------------------------------
@@ -1815,11 +1900,13 @@ float get_mesh_max_vertex_2( ego_mesh_t *mesh, Object *object)
         pos_y[corner] = object->getPosY() + (( 0 == iy_off[corner] ) ? object->chr_min_cv._mins[OCT_Y] : object->chr_min_cv._maxs[OCT_Y] );
     }
 
-    zmax = mesh->getElevation(Vector2f(pos_x[0], pos_y[0]), object->getAttribute(Ego::Attribute::WALK_ON_WATER) > 0 );
+    float pos_z[4];
+    mesh->getElevation(pos_x, pos_y, pos_z, 4, object->getAttribute(Ego::Attribute::WALK_ON_WATER) > 0 );
+
+    zmax = pos_z[0];
     for ( corner = 1; corner < 4; corner++ )
     {
-        float fval = mesh->getElevation(Vector2f(pos_x[corner], pos_y[corner]), object->getAttribute(Ego::Attribute::WALK_ON_WATER) > 0 );
-        zmax = std::max( zmax, fval );
+        zmax = std::max( zmax, pos_z[corner] );
     }
 
     return zmax;
@@ -2286,7 +2373,7 @@ bool chr_do_latch_attack( Object * pchr, slot_t which_slot )
     if ( !allowedtoattack )
     {
         // This character can't use this iweapon
-        pweapon->reload_timer = ONESECOND;
+        pweapon->setTimer(&Object::reload_timer, ONESECOND);
         if (pchr->getShowStatus() || egoboo_config_t::get().debug_developerMode_enable.getValue())
         {
             // Tell the player that they can't use this iweapon
@@ -2414,7 +2501,7 @@ bool chr_do_latch_attack( Object * pchr, slot_t which_slot )
                         else if ( ACTION_IS_TYPE( action, F ) ) base_reload_time += 60;     //Flinged  (Unused)
 
                         //it is possible to have so high dex to eliminate all reload time
-                        if ( base_reload_time > 0 ) pweapon->reload_timer += base_reload_time;
+                        if ( base_reload_time > 0 ) pweapon->setTimer(&Object::reload_timer, pweapon->getTimer(&Object::reload_timer) + base_reload_time);
                     }
                 }
 
@@ -2823,5 +2910,11 @@ int DisplayMsg_printf( const char *format, ... )
 
 void DisplayMsg_print(const std::string &text)
 {
-    _gameEngine->getActivePlayingState()->getMessageLog()->addMessage(text);
+    //No message log when running without a playing state (e.g. a headless simulation)
+    std::shared_ptr<PlayingState> playingState = _gameEngine->getActivePlayingState();
+    if(!playingState) {
+        Log::get() << Log::Entry::create(Log::Level::Info, __FILE__, __LINE__, text, Log::EndOfEntry);
+        return;
+    }
+    playingState->getMessageLog()->addMessage(text);
 }
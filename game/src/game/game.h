@@ -225,6 +225,13 @@ extern Uint32          update_wld;            ///< The number of times the game
 extern int chr_stoppedby_tests;
 extern int chr_pressure_tests;
 
+// profiling timers for update_game() and its phases
+extern Ego::Time::Clock<Ego::Time::ClockPolicy::NonRecursive> update_game_timer;
+extern Ego::Time::Clock<Ego::Time::ClockPolicy::NonRecursive> update_ai_timer;
+extern Ego::Time::Clock<Ego::Time::ClockPolicy::NonRecursive> update_all_objects_timer;
+extern Ego::Time::Clock<Ego::Time::ClockPolicy::NonRecursive> move_all_objects_timer;
+extern Ego::Time::Clock<Ego::Time::ClockPolicy::NonRecursive> collision_update_timer;
+
 //--------------------------------------------------------------------------------------------
 //--------------------------------------------------------------------------------------------
 
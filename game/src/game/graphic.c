@@ -1836,20 +1836,22 @@ gfx_rv gfx_make_dynalist(dynalist_t& dyl, Camera& cam)
     // Don't really make a list, just set to visible or not
     dynalist_t::init(dyl);
 
-    for(const std::shared_ptr<Ego::Particle> &particle : ParticleHandler::get().iterator())
+    // only lights in the same area as the visible particles (see gfx_make_entityList)
+    const float range = Info<float>::Grid::Size() * 10;
+    const AxisAlignedBox2f searchArea(Point2f(cam.getTrackPosition()[kX] - range, cam.getTrackPosition()[kY] - range),
+                                      Point2f(cam.getTrackPosition()[kX] + range, cam.getTrackPosition()[kY] + range));
+    ParticleHandler::get().visitParticles(searchArea, [&](Ego::Particle &particle)
     {
-        if(particle->isTerminated()) continue;
-        
-        dynalight_info_t& pprt_dyna = particle->dynalight;
+        dynalight_info_t& pprt_dyna = particle.dynalight;
 
         // is the light on?
-        if (!pprt_dyna.on || 0.0f == pprt_dyna.level) continue;
+        if (!pprt_dyna.on || 0.0f == pprt_dyna.level) return;
 
         // reset the dynalight pointer
         plight = NULL;
 
         // find the distance to the camera
-        vdist = particle->getPosition() - cam.getTrackPosition();
+        vdist = particle.getPosition() - cam.getTrackPosition();
         distance = vdist.length_2();
 
         // insert the dynalight
@@ -1893,11 +1895,11 @@ gfx_rv gfx_make_dynalist(dynalist_t& dyl, Camera& cam)
         if (NULL != plight)
         {
             plight->distance = distance;
-            plight->pos = particle->getPosition();
+            plight->pos = particle.getPosition();
             plight->level = pprt_dyna.level;
             plight->falloff = pprt_dyna.falloff;
         }
-    }
+    });
 
     // the list is updated, so update the frame count
     dyl.frame = _gameEngine->getNumberOfFramesRendered();
@@ -2235,20 +2237,17 @@ gfx_rv gfx_make_entityList(Ego::Graphics::EntityList& el, Camera& cam)
     el.clear();
 
     // collide the characters with the frustum
-    std::vector<std::shared_ptr<Object>> visibleObjects = 
-        _currentModule->getObjectHandler().findObjects(
+    _currentModule->getObjectHandler().visitObjects(
             cam.getCenter()[kX], 
             cam.getCenter()[kY], 
 			Info<float>::Grid::Size() * 10,  //@todo: use camera view size here instead
-            true);
+            true,
+            [&el, &cam](Object &object) { el.add(cam, object); });
 
-    for(const std::shared_ptr<Object> object : visibleObjects) {
-        el.add(cam, *object.get());
-    }
-
-    for(const std::shared_ptr<Ego::Particle> particle : ParticleHandler::get().iterator()) {
-        el.add(cam, *particle.get());
-    }
+    ParticleHandler::get().visitParticles(
+            AxisAlignedBox2f(Point2f(cam.getCenter()[kX] - Info<float>::Grid::Size() * 10, cam.getCenter()[kY] - Info<float>::Grid::Size() * 10),
+                             Point2f(cam.getCenter()[kX] + Info<float>::Grid::Size() * 10, cam.getCenter()[kY] + Info<float>::Grid::Size() * 10)),
+            [&el, &cam](Ego::Particle &particle) { el.add(cam, particle); });
 
     return gfx_success;
 }
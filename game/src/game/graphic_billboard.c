@@ -287,10 +287,15 @@ std::shared_ptr<Billboard> BillboardSystem::makeBillboard(ObjectRef obj_ref, con
         return nullptr;
     }
 
+    // Text can not be pre-rendered without a user interface (e.g. in a headless simulation).
+    if (!_gameEngine->getUIManager()) {
+        return nullptr;
+    }
+
     // Pre-render the text.
     std::shared_ptr<Ego::Texture> tex;
     try {
-        tex = std::make_shared<Ego::OpenGL::Texture>();
+        tex = Ego::Renderer::get().createTexture();
     } catch (...) {
         return nullptr;
     }
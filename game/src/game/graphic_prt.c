@@ -77,7 +77,7 @@ void prt_set_texture_params(const std::shared_ptr<const Ego::Texture>& texture,
 }
 
 //--------------------------------------------------------------------------------------------
-static gfx_rv prt_instance_update(Camera& camera, const ParticleRef particle, Uint8 trans, bool do_lighting);
+static gfx_rv prt_instance_update(Camera& camera, Ego::Particle& particle, Uint8 trans, bool do_lighting);
 static void calc_billboard_verts(Ego::VertexBuffer& vb, prt_instance_t& pinst, float size, bool do_reflect);
 static void draw_one_attachment_point(Ego::Graphics::ObjectGraphics& inst, int vrt_offset);
 static void prt_draw_attached_point(const std::shared_ptr<Ego::Particle> &bdl_prt);
@@ -510,6 +510,7 @@ gfx_rv update_all_prt_instance(Camera& camera)
     // assume the best
     gfx_rv retval = gfx_success;
 
+    // the active particles are in storage order, so their hot data is read front to back
     for(const std::shared_ptr<Ego::Particle> &particle : ParticleHandler::get().iterator())
     {
         if(particle->isTerminated()) continue;
@@ -527,7 +528,7 @@ gfx_rv update_all_prt_instance(Camera& camera)
         else
         {
             // calculate the "billboard" for this particle
-            if (gfx_error == prt_instance_update(camera, particle->getParticleID(), 255, true))
+            if (gfx_error == prt_instance_update(camera, *particle, 255, true))
             {
                 retval = gfx_error;
             }
@@ -550,17 +551,23 @@ gfx_rv prt_instance_t::update_vertices(prt_instance_t& inst, Camera& camera, Ego
 
     const std::shared_ptr<ParticleProfile> &ppip = pprt->getProfile();
 
+    // The position, velocity and size are read from the hot data in storage order
+    const Ego::ParticleHotData& hotData = ParticleHandler::get().getHotData();
+    const size_t slot = pprt->getSlot();
+    const Vector3f& position = hotData.position[slot];
+    const Vector3f& velocity = hotData.velocity[slot];
+
     inst.type = pprt->type;
 
     inst.image_ref = (pprt->_image._start / EGO_ANIMATION_MULTIPLIER + pprt->_image._offset / EGO_ANIMATION_MULTIPLIER);
 
 
     // Set the position.
-    inst.pos = pprt->getPosition();
+    inst.pos = position;
     inst.orientation = ppip->orientation;
 
     // Calculate the billboard vectors for the reflections.
-    inst.ref_pos = pprt->getPosition();
+    inst.ref_pos = position;
     inst.ref_pos[kZ] = 2 * pprt->enviro.floor_level - inst.pos[kZ];
 
     // get the vector from the camera to the particle
@@ -573,11 +580,11 @@ gfx_rv prt_instance_t::update_vertices(prt_instance_t& inst, Camera& camera, Ego
     // Set the up and right vectors.
 	Vector3f vup = Vector3f(0.0f, 0.0f, 1.0f), vright;
 	Vector3f vup_ref = Vector3f(0.0f, 0.0f, 1.0f), vright_ref;
-    if (ppip->rotatetoface && !pprt->isAttached() && (pprt->vel.length_abs() > 0))
+    if (ppip->rotatetoface && !pprt->isAttached() && (velocity.length_abs() > 0))
     {
         // The particle points along its direction of travel.
 
-        vup = pprt->vel;
+        vup = velocity;
         vup.normalize();
 
         // Get the correct "right" vector.
@@ -807,7 +814,7 @@ gfx_rv prt_instance_t::update_vertices(prt_instance_t& inst, Camera& camera, Ego
 
     // Set some particle dependent properties.
     inst.scale = pprt->getScale();
-    inst.size = FP8_TO_FLOAT(pprt->size) * inst.scale;
+    inst.size = FP8_TO_FLOAT(hotData.size[slot]) * inst.scale;
 
     // This instance is now completely valid.
     inst.valid = true;
@@ -885,33 +892,27 @@ gfx_rv prt_instance_t::update_lighting(prt_instance_t& pinst, Ego::Particle *ppr
     pinst.fintens = Ego::Math::constrain(pinst.fintens, 0.0f, 1.0f);
 
     // determine the alpha component
-    pinst.falpha = (alpha * INV_FF<float>()) * (pinst.alpha * INV_FF<float>());
+    pinst.falpha = (alpha * INV_FF<float>()) * (ParticleHandler::get().getHotData().alpha[pprt->getSlot()] * INV_FF<float>());
     pinst.falpha = Ego::Math::constrain(pinst.falpha, 0.0f, 1.0f);
 
     return gfx_success;
 }
 
-gfx_rv prt_instance_update(Camera& camera, const ParticleRef particle, Uint8 trans, bool do_lighting)
+gfx_rv prt_instance_update(Camera& camera, Ego::Particle& particle, Uint8 trans, bool do_lighting)
 {
-    const std::shared_ptr<Ego::Particle> &pprt = ParticleHandler::get()[particle];
-    if(!pprt) {
-        gfx_error_add(__FILE__, __FUNCTION__, __LINE__, particle.get(), "invalid particle");
-        return gfx_error;
-    }
-
-    prt_instance_t& pinst = pprt->inst;
+    prt_instance_t& pinst = particle.inst;
 
     // assume the best
     gfx_rv retval = gfx_success;
 
     // make sure that the vertices are interpolated
-    if (gfx_error == prt_instance_t::update_vertices(pinst, camera, pprt.get()))
+    if (gfx_error == prt_instance_t::update_vertices(pinst, camera, &particle))
     {
         retval = gfx_error;
     }
 
     // do the lighting
-    if (gfx_error == prt_instance_t::update_lighting(pinst, pprt.get(), trans, do_lighting))
+    if (gfx_error == prt_instance_t::update_lighting(pinst, &particle, trans, do_lighting))
     {
         retval = gfx_error;
     }
@@ -55,7 +55,6 @@ struct prt_instance_t
     // basic info
     uint8_t  type;               ///< particle type
     uint32_t image_ref;          ///< which sub image within the texture?
-    float    alpha;              ///< base alpha
     uint8_t  light;              ///< base self lighting
 
     // position info
@@ -89,7 +88,6 @@ struct prt_instance_t
         // basic info
         type(0),
         image_ref(0),
-        alpha(0.0f),
         light(0),
 
         // position info
@@ -129,7 +127,6 @@ struct prt_instance_t
         // basic info
         type = 0;
         image_ref = 0;
-        alpha = 0.0f;
         light = 0;
 
         // position info
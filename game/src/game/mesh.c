@@ -39,7 +39,7 @@ const std::shared_ptr<ego_tile_info_t> ego_tile_info_t::NULL_TILE = nullptr;
 //--------------------------------------------------------------------------------------------
 //--------------------------------------------------------------------------------------------
 
-MeshStats g_meshStats;
+thread_local MeshStats g_meshStats;
 
 static void warnNumberOfVertices(const char *file, int line, size_t numberOfVertices)
 {
@@ -438,6 +438,11 @@ BIT_FIELD ego_mesh_t::test_wall(const BIT_FIELD bits, const mesh_wall_data_t& da
 		return pass;
 	}
 
+	// Away from any walls there is no need to look at the tiles.
+	if (data._mesh->_wallField.isClear(bits, data._i)) {
+		return EMPTY_BIT_FIELD;
+	}
+
 	for (int iy = data._i.min().y(); iy <= data._i.max().y(); ++iy) {
 		for (int ix = data._i.min().x(); ix <= data._i.max().x(); ++ix) {
 			Index1D tileIndex(ix + iy * data._mesh->_tmem.getInfo().getTileCountX());
@@ -836,6 +841,260 @@ bool mpdfx_lists_t::synch( const tile_mem_t& tmem, bool force )
     return true;
 }
 
+//--------------------------------------------------------------------------------------------
+const uint8_t mesh_wall_field_t::MAX_DISTANCE;
+const size_t mesh_wall_field_t::MASK_COUNT;
+
+const BIT_FIELD mesh_wall_field_t::MASKS[mesh_wall_field_t::MASK_COUNT] =
+{
+    MAPFX_IMPASS,
+    MAPFX_IMPASS | MAPFX_WALL,
+};
+
+mesh_wall_field_t::mesh_wall_field_t(const Ego::MeshInfo& info)
+    : _info(info)
+{
+    for (size_t mask = 0; mask < MASK_COUNT; ++mask)
+    {
+        _distances[mask].resize(info.getTileCount(), 0);
+    }
+}
+
+void mesh_wall_field_t::compute(const tile_mem_t& tmem, const BIT_FIELD bits, const IndexRect& window, std::vector<uint8_t>& distances) const
+{
+    const int width = window.max().x() - window.min().x() + 1;
+    const int height = window.max().y() - window.min().y() + 1;
+    distances.resize(width * height);
+
+    // blocking tiles have distance 0, all other tiles start at the maximum
+    for (int y = 0; y < height; ++y)
+    {
+        for (int x = 0; x < width; ++x)
+        {
+            const Index2D index(window.min().x() + x, window.min().y() + y);
+            distances[x + y * width] = (0 != tmem.get(index).testFX(bits)) ? 0 : MAX_DISTANCE;
+        }
+    }
+
+    // two passes over the 8 neighbours give the exact distances within the window
+    auto relax = [&distances, width, height](int x, int y, int dx, int dy)
+    {
+        if (x + dx < 0 || x + dx >= width || y + dy < 0 || y + dy >= height) return;
+        uint8_t& distance = distances[x + y * width];
+        distance = std::min<uint8_t>(distance, distances[(x + dx) + (y + dy) * width] + 1);
+    };
+    for (int y = 0; y < height; ++y)
+    {
+        for (int x = 0; x < width; ++x)
+        {
+            relax(x, y, -1,  0);
+            relax(x, y, -1, -1);
+            relax(x, y,  0, -1);
+            relax(x, y, +1, -1);
+        }
+    }
+    for (int y = height - 1; y >= 0; --y)
+    {
+        for (int x = width - 1; x >= 0; --x)
+        {
+            relax(x, y, +1,  0);
+            relax(x, y, +1, +1);
+            relax(x, y,  0, +1);
+            relax(x, y, -1, +1);
+        }
+    }
+}
+
+void mesh_wall_field_t::synch(const tile_mem_t& tmem)
+{
+    if (0 == _info.getTileCount()) return;
+
+    const IndexRect window(Index2D(0, 0), Index2D(_info.getTileCountX() - 1, _info.getTileCountY() - 1));
+    for (size_t mask = 0; mask < MASK_COUNT; ++mask)
+    {
+        // the window is the whole mesh, so the buffer has the layout of the mesh
+        compute(tmem, MASKS[mask], window, _distances[mask]);
+    }
+}
+
+void mesh_wall_field_t::update(const tile_mem_t& tmem, const Index2D& index)
+{
+    const int countX = _info.getTileCountX(), countY = _info.getTileCountY();
+
+    // Only tiles closer than MAX_DISTANCE to the changed tile can change. Their nearest blocking
+    // tiles are closer than 2 * MAX_DISTANCE to it.
+    const IndexRect window(Index2D(std::max(0, index.x() - 2 * MAX_DISTANCE), std::max(0, index.y() - 2 * MAX_DISTANCE)),
+                           Index2D(std::min(countX - 1, index.x() + 2 * MAX_DISTANCE), std::min(countY - 1, index.y() + 2 * MAX_DISTANCE)));
+    const int width = window.max().x() - window.min().x() + 1;
+
+    std::vector<uint8_t> distances;
+    for (size_t mask = 0; mask < MASK_COUNT; ++mask)
+    {
+        compute(tmem, MASKS[mask], window, distances);
+        for (int y = std::max(0, index.y() - MAX_DISTANCE); y <= std::min(countY - 1, index.y() + MAX_DISTANCE); ++y)
+        {
+            for (int x = std::max(0, index.x() - MAX_DISTANCE); x <= std::min(countX - 1, index.x() + MAX_DISTANCE); ++x)
+            {
+                _distances[mask][x + y * countX] = distances[(x - window.min().x()) + (y - window.min().y()) * width];
+            }
+        }
+    }
+}
+
+mesh_elevation_t::mesh_elevation_t(const Ego::MeshInfo& info)
+    : _info(info), _corners(info.getTileCount())
+{
+}
+
+void mesh_elevation_t::synch(const tile_mem_t& tmem)
+{
+    for (Index1D i = 0; i < _info.getTileCount(); i++)
+    {
+        const size_t vertex = tmem.get(i)._vrtstart;
+        for (size_t corner = 0; corner < 4; ++corner)
+        {
+            _corners[i.i()].z[corner] = tmem._plst[vertex + corner][ZZ];
+        }
+    }
+}
+
+//--------------------------------------------------------------------------------------------
+const int mesh_block_fx_t::BLOCK_BITS;
+std::atomic<uint32_t> mesh_block_fx_t::s_nextRevision(1);
+
+mesh_block_fx_t::mesh_block_fx_t(const Ego::MeshInfo& info)
+    : _info(info),
+      _blockCountX((info.getTileCountX() + (1 << BLOCK_BITS) - 1) >> BLOCK_BITS),
+      _blockCountY((info.getTileCountY() + (1 << BLOCK_BITS) - 1) >> BLOCK_BITS),
+      _fx(_blockCountX * _blockCountY, 0),
+      _revisions(_blockCountX * _blockCountY, 0),
+      _revision(0)
+{
+}
+
+void mesh_block_fx_t::synch(const tile_mem_t& tmem)
+{
+    for (size_t y = 0; y < _blockCountY; ++y)
+    {
+        for (size_t x = 0; x < _blockCountX; ++x)
+        {
+            update(tmem, Index2D(static_cast<int>(x) << BLOCK_BITS, static_cast<int>(y) << BLOCK_BITS));
+        }
+    }
+}
+
+void mesh_block_fx_t::update(const tile_mem_t& tmem, const Index2D& index)
+{
+    const int blockX = index.x() >> BLOCK_BITS, blockY = index.y() >> BLOCK_BITS;
+    const int maxX = std::min<int>(_info.getTileCountX(), (blockX + 1) << BLOCK_BITS);
+    const int maxY = std::min<int>(_info.getTileCountY(), (blockY + 1) << BLOCK_BITS);
+
+    GRID_FX_BITS fx = 0;
+    for (int y = blockY << BLOCK_BITS; y < maxY; ++y)
+    {
+        for (int x = blockX << BLOCK_BITS; x < maxX; ++x)
+        {
+            // tiles with their fan turned off never block (see ego_mesh_t::test_fx)
+            const ego_tile_info_t& tile = tmem.get(Index2D(x, y));
+            if (!tile.isFanOff())
+            {
+                fx |= tile.getFX();
+            }
+        }
+    }
+    _fx[blockX + blockY * _blockCountX] = fx;
+    _revision = s_nextRevision++;
+    _revisions[blockX + blockY * _blockCountX] = _revision;
+}
+
+bool mesh_block_fx_t::isClear(const BIT_FIELD bits, const IndexRect& rect) const
+{
+    // clip the rectangle to the mesh
+    const int minX = std::max(0, rect.min().x()) >> BLOCK_BITS;
+    const int minY = std::max(0, rect.min().y()) >> BLOCK_BITS;
+    const int maxX = std::min<int>(_info.getTileCountX() - 1, rect.max().x()) >> BLOCK_BITS;
+    const int maxY = std::min<int>(_info.getTileCountY() - 1, rect.max().y()) >> BLOCK_BITS;
+
+    for (int y = minY; y <= maxY; ++y)
+    {
+        for (int x = minX; x <= maxX; ++x)
+        {
+            if (0 != (_fx[x + y * _blockCountX] & bits)) return false;
+        }
+    }
+    return true;
+}
+
+size_t mesh_block_fx_t::getBlockCount(const IndexRect& rect)
+{
+    const size_t width = (rect.max().x() >> BLOCK_BITS) - (rect.min().x() >> BLOCK_BITS) + 1;
+    const size_t height = (rect.max().y() >> BLOCK_BITS) - (rect.min().y() >> BLOCK_BITS) + 1;
+    return width * height;
+}
+
+//--------------------------------------------------------------------------------------------
+const size_t mesh_los_cache_t::SHARD_COUNT;
+
+size_t mesh_los_cache_t::hash_t::operator()(const key_t& key) const
+{
+    size_t hash = key.stoppedBy;
+    hash = hash * 31 + key.x0;
+    hash = hash * 31 + key.y0;
+    hash = hash * 31 + key.x1;
+    hash = hash * 31 + key.y1;
+    hash = hash * 2 + (key.steep ? 1 : 0);
+    return hash;
+}
+
+bool mesh_los_cache_t::find(const key_t& key, result_t& result) const
+{
+    const shard_t& shard = _shards[hash_t()(key) % SHARD_COUNT];
+    std::lock_guard<std::mutex> lock(shard.mutex);
+
+    auto it = shard.results.find(key);
+    if (it == shard.results.end()) return false;
+    result = it->second;
+    return true;
+}
+
+void mesh_los_cache_t::insert(const key_t& key, const result_t& result)
+{
+    shard_t& shard = _shards[hash_t()(key) % SHARD_COUNT];
+    std::lock_guard<std::mutex> lock(shard.mutex);
+    shard.results[key] = result;
+}
+
+void mesh_los_cache_t::clear()
+{
+    for (shard_t& shard : _shards)
+    {
+        std::lock_guard<std::mutex> lock(shard.mutex);
+        shard.results.clear();
+    }
+}
+
+//--------------------------------------------------------------------------------------------
+bool mesh_wall_field_t::isClear(const BIT_FIELD bits, const IndexRect& rect) const
+{
+    if (0 == _info.getTileCount()) return false;
+
+    for (size_t mask = 0; mask < MASK_COUNT; ++mask)
+    {
+        // a tile which does not block the mask does not block any part of it either
+        if (bits != (bits & MASKS[mask])) continue;
+
+        // are all tiles of the rectangle closer to its center than the nearest blocking tile?
+        const int x = (rect.min().x() + rect.max().x()) / 2;
+        const int y = (rect.min().y() + rect.max().y()) / 2;
+        const int extent = std::max(std::max(x - rect.min().x(), rect.max().x() - x),
+                                    std::max(y - rect.min().y(), rect.max().y() - y));
+        return extent < _distances[mask][x + y * _info.getTileCountX()];
+    }
+
+    // not a common mask
+    return false;
+}
+
 //--------------------------------------------------------------------------------------------
 
 bool ego_mesh_t::tile_has_bits( const Index2D& i, const BIT_FIELD bits ) const
@@ -872,22 +1131,43 @@ float ego_mesh_t::getElevation(const Vector2f& p) const
 		return 0;
 	}
 
-    // Get the height of each fan corner.
-    float z0 = _tmem._plst[_tmem.get(i1)._vrtstart + 0][ZZ];
-    float z1 = _tmem._plst[_tmem.get(i1)._vrtstart + 1][ZZ];
-    float z2 = _tmem._plst[_tmem.get(i1)._vrtstart + 2][ZZ];
-    float z3 = _tmem._plst[_tmem.get(i1)._vrtstart + 3][ZZ];
-
     //Calculate where on the tile we are relative to top left corner of the tile (0,0)
     Vector2f posOnTile = Vector2f(static_cast<float>(static_cast<int>(p.x()) % Info<int>::Grid::Size()), 
                                   static_cast<float>(static_cast<int>(p.y()) % Info<int>::Grid::Size()));
 
-    // Get the weighted height of each side.
-    float zleft = (z0 * (Info<float>::Grid::Size() - posOnTile.y()) + z3 * posOnTile.y()) / Info<float>::Grid::Size();
-    float zright = (z1 * (Info<float>::Grid::Size() - posOnTile.y()) + z2 * posOnTile.y()) / Info<float>::Grid::Size();
-    float zdone = (zleft * (Info<float>::Grid::Size() - posOnTile.x()) + zright * posOnTile.x()) / Info<float>::Grid::Size();
+    return _elevation.get(i1, posOnTile.x(), posOnTile.y());
+}
+
+void ego_mesh_t::getElevation(const float *x, const float *y, float *z, size_t count, bool waterwalk) const
+{
+    const water_instance_t *water = waterwalk ? &(_currentModule->getWater()) : nullptr;
+    waterwalk = waterwalk && water->_is_water;
+
+    for (size_t i = 0; i < count; ++i)
+    {
+        // Same as getTileIndex(const Vector2f&), without constructing the intermediate objects.
+        if (!(x[i] >= 0.0f && x[i] < _tmem._edge_x && y[i] >= 0.0f && y[i] < _tmem._edge_y))
+        {
+            z[i] = 0;
+            continue;
+        }
+        const int ix = static_cast<int>(x[i]), iy = static_cast<int>(y[i]);
+        const Index2D i2(ix / Info<int>::Grid::Size(), iy / Info<int>::Grid::Size());
+        if (!_info.isValid(i2))
+        {
+            z[i] = 0;
+            continue;
+        }
+        const Index1D i1 = _info.map(i2);
+
+        z[i] = _elevation.get(i1, static_cast<float>(ix % Info<int>::Grid::Size()),
+                                  static_cast<float>(iy % Info<int>::Grid::Size()));
 
-    return zdone;
+        if (waterwalk && water->_surface_level > z[i] && 0 != test_fx(i1, MAPFX_WATER))
+        {
+            z[i] = water->_surface_level;
+        }
+    }
 }
 
 Index1D ego_mesh_t::getTileIndex(const Vector2f& p) const
@@ -925,6 +1205,9 @@ bool ego_mesh_t::clear_fx( const Index1D& i, const BIT_FIELD flags )
 
     if (_tmem.get(i).removeFX(flags)) {
         _fxlists.dirty = true;
+        _wallField.update(_tmem, _info.map(i));
+        _blockFX.update(_tmem, _info.map(i));
+        _losCache.clear();
         return true;
     } else {
         return false;
@@ -946,6 +1229,9 @@ bool ego_mesh_t::add_fx(const Index1D& i, const BIT_FIELD flags)
     if ( retval )
     {
         _fxlists.dirty = true;
+        _wallField.update(_tmem, _info.map(i));
+        _blockFX.update(_tmem, _info.map(i));
+        _losCache.clear();
     }
 
     return retval;
@@ -1162,6 +1448,13 @@ BIT_FIELD ego_mesh_t::hit_wall(const Vector3f& pos, float radius, const BIT_FIEL
 
 	// ego_mesh_test_wall() clamps pdata->ix_* and pdata->iy_* to valid values
 
+	// Away from any walls there is no need to look at the tiles.
+	if (data._i.min().x() >= 0 && data._i.max().x() < static_cast<int>(_info.getTileCountX()) &&
+		data._i.min().y() >= 0 && data._i.max().y() < static_cast<int>(_info.getTileCountY()) &&
+		_wallField.isClear(bits, data._i)) {
+		return EMPTY_BIT_FIELD;
+	}
+
 	BIT_FIELD loc_pass = 0;
 	nrm[kX] = nrm[kY] = 0.0f;
 	for (int iy = data._i.min().y(); iy <= data._i.max().y(); iy++)
@@ -1272,7 +1565,7 @@ BIT_FIELD ego_mesh_t::hit_wall(const Vector3f& pos, const float radius, const BI
 }
 
 ego_mesh_t::ego_mesh_t(const Ego::MeshInfo& mesh_info)
-	: _info(mesh_info), _tmem(mesh_info), _fxlists(mesh_info) {
+	: _info(mesh_info), _tmem(mesh_info), _fxlists(mesh_info), _wallField(mesh_info), _elevation(mesh_info), _blockFX(mesh_info) {
 }
 
 ego_mesh_t::~ego_mesh_t() {
@@ -1354,6 +1647,10 @@ void ego_mesh_t::finalize()
 
 	// create some lists to make searching the mesh tiles easier
 	_fxlists.synch(_tmem, true);
+	_wallField.synch(_tmem);
+	_elevation.synch(_tmem);
+	_blockFX.synch(_tmem);
+	_losCache.clear();
 }
 
 float ego_mesh_t::getElevation(const Vector2f& p, bool waterwalk) const
@@ -341,6 +341,168 @@ struct mpdfx_lists_t
     bool synch(const tile_mem_t& other, bool force);
 };
 
+//--------------------------------------------------------------------------------------------
+/// For every tile the distance (in tiles, along the "longer" axis) to the nearest tile which
+/// blocks a common stoppedby mask. Lets wall tests away from any wall skip scanning the tiles.
+struct mesh_wall_field_t
+{
+    static const uint8_t MAX_DISTANCE = 8;      ///< Distances are clamped to this value
+
+	mesh_wall_field_t(const Ego::MeshInfo& info);
+
+    /// @brief Recompute the distances of all tiles.
+    void synch(const tile_mem_t& tmem);
+
+    /// @brief Recompute the distances around a tile after its fx changed.
+    void update(const tile_mem_t& tmem, const Index2D& index);
+
+    /// @return @a true if it is known that no tile within the index rectangle blocks any of the bits
+    /// @remark The index rectangle must be within the bounds of the mesh.
+    bool isClear(const BIT_FIELD bits, const IndexRect& rect) const;
+
+private:
+    static const size_t MASK_COUNT = 2;
+    static const BIT_FIELD MASKS[MASK_COUNT];   ///< The stoppedby masks, smaller masks first
+
+    /// @brief Compute the distances within a window of the mesh into a buffer of the size of the window.
+    void compute(const tile_mem_t& tmem, const BIT_FIELD bits, const IndexRect& window, std::vector<uint8_t>& distances) const;
+
+	Ego::MeshInfo _info;
+    std::vector<uint8_t> _distances[MASK_COUNT];
+};
+
+//--------------------------------------------------------------------------------------------
+/// For every tile the heights of its four corners, stored next to each other. Elevation
+/// queries read one small record per tile instead of the vertex list of the tile.
+struct mesh_elevation_t
+{
+	mesh_elevation_t(const Ego::MeshInfo& info);
+
+    /// @brief Copy the corner heights of all tiles from the vertex list.
+    /// @remark Must be called whenever the vertices of the mesh change.
+    void synch(const tile_mem_t& tmem);
+
+    /// @brief Get the height of a tile at a point.
+    /// @param index the tile index
+    /// @param x, y the point relative to the top left corner of the tile
+    float get(const Index1D& index, float x, float y) const
+    {
+        const corners_t& corners = _corners[index.i()];
+        const float size = Info<float>::Grid::Size();
+
+        // Get the weighted height of each side.
+        const float zleft = (corners.z[0] * (size - y) + corners.z[3] * y) / size;
+        const float zright = (corners.z[1] * (size - y) + corners.z[2] * y) / size;
+        return (zleft * (size - x) + zright * x) / size;
+    }
+
+private:
+    struct corners_t
+    {
+        float z[4];     ///< The heights of the top left, top right, bottom right and bottom left corner
+    };
+
+	Ego::MeshInfo _info;
+    std::vector<corners_t> _corners;
+};
+
+//--------------------------------------------------------------------------------------------
+/// For every block of tiles the union of the fx of its tiles. Lets line of sight tests
+/// through blocks which contain no blocking tile skip the walk along the ray.
+struct mesh_block_fx_t
+{
+    static const int BLOCK_BITS = Info<int>::Block::Bits() - Info<int>::Grid::Bits();   ///< Blocks are 2^BLOCK_BITS tiles wide
+
+	mesh_block_fx_t(const Ego::MeshInfo& info);
+
+    /// @brief Recompute the fx of all blocks.
+    void synch(const tile_mem_t& tmem);
+
+    /// @brief Recompute the fx of the block of a tile after the fx of the tile changed.
+    void update(const tile_mem_t& tmem, const Index2D& index);
+
+    /// @return @a true if no tile of the mesh within the index rectangle has any of the bits
+    /// @remark Tiles of the rectangle outside of the mesh are ignored.
+    bool isClear(const BIT_FIELD bits, const IndexRect& rect) const;
+
+    /// @return the number of blocks overlapped by the index rectangle
+    static size_t getBlockCount(const IndexRect& rect);
+
+    size_t getBlockCountX() const { return _blockCountX; }
+    size_t getBlockCountY() const { return _blockCountY; }
+
+    /// @return the revision of a block, which changes whenever the fx of a tile of the block change
+    /// @remark Revisions are unique among all meshes, a new mesh does not reuse the revisions of an old mesh.
+    uint32_t getRevision(size_t blockX, size_t blockY) const { return _revisions[blockX + blockY * _blockCountX]; }
+
+    /// @return the revision of the mesh, which changes whenever the revision of any block changes
+    uint32_t getRevision() const { return _revision; }
+
+private:
+	Ego::MeshInfo _info;
+    size_t _blockCountX, _blockCountY;
+    std::vector<GRID_FX_BITS> _fx;
+    std::vector<uint32_t> _revisions;
+    uint32_t _revision;
+
+    static std::atomic<uint32_t> s_nextRevision;
+};
+
+//--------------------------------------------------------------------------------------------
+/// The results of line of sight tests against the mesh. A.I. scripts of the same update test
+/// the same pairs of tiles over and over again. The results are shared by all threads.
+struct mesh_los_cache_t
+{
+    /// The parameters which determine the tiles visited by a line of sight test.
+    struct key_t
+    {
+        int x0, y0;             ///< The start tile
+        int x1, y1;             ///< The end tile
+        uint32_t stoppedBy;     ///< The fx which block the line of sight
+        bool steep;             ///< Is the ray stepped along the y-axis?
+
+        bool operator==(const key_t& other) const
+        {
+            return x0 == other.x0 && y0 == other.y0 && x1 == other.x1 && y1 == other.y1
+                && stoppedBy == other.stoppedBy && steep == other.steep;
+        }
+    };
+
+    /// The outcome of a line of sight test.
+    struct result_t
+    {
+        bool blocked;
+        int collideX, collideY;     ///< The blocking tile, if the line of sight is blocked
+        uint32_t collideFX;         ///< The fx of the blocking tile, if the line of sight is blocked
+    };
+
+    /// @brief Get the result of a line of sight test.
+    /// @return @a true if the result was found
+    bool find(const key_t& key, result_t& result) const;
+
+    /// @brief Store the result of a line of sight test.
+    void insert(const key_t& key, const result_t& result);
+
+    /// @brief Forget all results, e.g. after the fx of the mesh changed.
+    void clear();
+
+private:
+    struct hash_t
+    {
+        size_t operator()(const key_t& key) const;
+    };
+
+    static const size_t SHARD_COUNT = 16;   ///< Number of independently locked parts of the cache
+
+    struct shard_t
+    {
+        mutable std::mutex mutex;
+        std::unordered_map<key_t, result_t, hash_t> results;
+    };
+
+    std::array<shard_t, SHARD_COUNT> _shards;
+};
+
 //--------------------------------------------------------------------------------------------
 
 class ego_mesh_t;
@@ -388,6 +550,10 @@ public:
     Ego::MeshInfo _info;
     tile_mem_t _tmem;
     mpdfx_lists_t _fxlists;
+    mesh_wall_field_t _wallField;
+    mesh_elevation_t _elevation;
+    mesh_block_fx_t _blockFX;
+    mutable mesh_los_cache_t _losCache;     ///< Filled by line of sight tests, which only have a const mesh
 
     Vector3f get_diff(const Vector3f& pos, float radius, float center_pressure, const BIT_FIELD bits);
     float get_pressure(const Vector3f& pos, float radius, const BIT_FIELD bits) const;
@@ -459,6 +625,21 @@ public:
 	 *  0 otherwise
 	 **/
 	float getElevation(const Vector2f& p) const;
+	/**
+	 * @brief
+	 *  Get the precise heights of the mesh at a list of points (world coordinates).
+	 * @param x, y
+	 *  the coordinates of the points (world coordinates)
+	 * @param z
+	 *  receives the heights of the mesh at the points
+	 * @param count
+	 *  the number of points
+	 * @param waterwalk
+	 *	if @a true and the fan is watery, then the height returned is the water level
+	 * @remark
+	 *  Each height is the same as the one returned by getElevation(const Vector2f&, bool) for that point.
+	 */
+	void getElevation(const float *x, const float *y, float *z, size_t count, bool waterwalk) const;
 
 	bool tile_has_bits(const Index2D& i, const BIT_FIELD bits) const;
 
@@ -517,7 +698,8 @@ struct MeshStats {
 };
 
 // Those are statistics. Move into per-mesh statistics.
-extern MeshStats g_meshStats;
+// Thread-local, such that the mesh can be queried by multiple threads at the same time.
+extern thread_local MeshStats g_meshStats;
 
 //--------------------------------------------------------------------------------------------
 
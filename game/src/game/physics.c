@@ -25,6 +25,11 @@
 #include "game/Entities/_Include.hpp"
 #include "egolib/Float.hpp"
 
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+    #define PHYS_INTERSECT_OCT_BB_SSE2
+    #include <emmintrin.h>
+#endif
+
 //--------------------------------------------------------------------------------------------
 //--------------------------------------------------------------------------------------------
 
@@ -598,6 +603,235 @@ bool phys_intersect_oct_bb(const oct_bb_t& src1_orig, const Vector3f& pos1, cons
     return true;
 }
 
+//--------------------------------------------------------------------------------------------
+//--------------------------------------------------------------------------------------------
+void phys_oct_bb_batch_t::clear()
+{
+    for (size_t index = 0; index < OCT_COUNT; ++index)
+    {
+        mins[index].clear();
+        maxs[index].clear();
+        ovel[index].clear();
+    }
+    for (size_t index = 0; index < 3; ++index)
+    {
+        vel[index].clear();
+    }
+    tmin.clear();
+    tmax.clear();
+    hit.clear();
+}
+
+//--------------------------------------------------------------------------------------------
+size_t phys_oct_bb_batch_t::size() const
+{
+    return vel[kX].size();
+}
+
+//--------------------------------------------------------------------------------------------
+void phys_oct_bb_batch_t::push_back(const oct_bb_t& src, const Vector3f& pos, const Vector3f& vel)
+{
+    const oct_vec_v2_t opos(pos), ovel(vel);
+    for (size_t index = 0; index < OCT_COUNT; ++index)
+    {
+        this->mins[index].push_back(src._mins[index] + opos[index]);
+        this->maxs[index].push_back(src._maxs[index] + opos[index]);
+        this->ovel[index].push_back(ovel[index]);
+    }
+    this->vel[kX].push_back(vel[kX]);
+    this->vel[kY].push_back(vel[kY]);
+    this->vel[kZ].push_back(vel[kZ]);
+}
+
+//--------------------------------------------------------------------------------------------
+static bool phys_intersect_oct_bb_candidate(const oct_bb_t& src1, const Vector3f& pos1, const Vector3f& vel1, const phys_oct_bb_batch_t& candidates, size_t candidate, float *tmin, float *tmax)
+{
+    // the candidate volumes are already translated to their positions
+    oct_bb_t src2;
+    for (size_t index = 0; index < OCT_COUNT; ++index)
+    {
+        src2._mins[index] = candidates.mins[index][candidate];
+        src2._maxs[index] = candidates.maxs[index][candidate];
+    }
+    src2._empty = false;
+
+    const Vector3f vel2(candidates.vel[kX][candidate], candidates.vel[kY][candidate], candidates.vel[kZ][candidate]);
+
+    oct_bb_t dst;
+    return phys_intersect_oct_bb(src1, pos1, vel1, src2, Vector3f::zero(), vel2, PHYS_PLATFORM_NONE, dst, tmin, tmax);
+}
+
+#if defined(PHYS_INTERSECT_OCT_BB_SSE2)
+//--------------------------------------------------------------------------------------------
+static float phys_get_motion_tolerance()
+{
+    // phys_intersect_oct_bb() compares against the double 1.0e-6, so use the smallest float that is not less
+    float tolerance = static_cast<float>(1.0e-6);
+    if (tolerance < 1.0e-6)
+    {
+        tolerance = std::nextafter(tolerance, std::numeric_limits<float>::infinity());
+    }
+    return tolerance;
+}
+
+//--------------------------------------------------------------------------------------------
+static inline __m128 phys_select(__m128 mask, __m128 a, __m128 b)
+{
+    return _mm_or_ps(_mm_and_ps(mask, a), _mm_andnot_ps(mask, b));
+}
+
+//--------------------------------------------------------------------------------------------
+static inline void phys_translate_oct(__m128 x, __m128 y, __m128 z, __m128 (&dst)[OCT_COUNT])
+{
+    // the same as oct_vec_v2_t(const Vector3f&)
+    dst[OCT_X]  = x;
+    dst[OCT_Y]  = y;
+    dst[OCT_Z]  = z;
+    dst[OCT_XY] = _mm_add_ps(x, y);
+    dst[OCT_YX] = _mm_sub_ps(y, x);
+}
+
+//--------------------------------------------------------------------------------------------
+static void phys_intersect_oct_bb_sse2(const oct_bb_t& src1, const oct_vec_v2_t& ovel1, const Vector3f& vel1, phys_oct_bb_batch_t& candidates, size_t first)
+{
+    /// @details Tests the candidates [first, first + 4) in the same way as phys_intersect_oct_bb(),
+    ///          with one candidate in each lane. The early outs of the scalar loop are folded into
+    ///          the final tests, as the interval of interaction can only shrink from axis to axis.
+
+    const __m128 zero = _mm_setzero_ps();
+    const __m128 one = _mm_set1_ps(1.0f);
+    static const float tolerance = phys_get_motion_tolerance();
+    const __m128 epsilon = _mm_set1_ps(tolerance);
+    const __m128 infinity = _mm_set1_ps(std::numeric_limits<float>::infinity());
+    const __m128 absMask = _mm_castsi128_ps(_mm_set1_epi32(0x7FFFFFFF));
+
+    __m128 vel2[3];
+    vel2[kX] = _mm_loadu_ps(&candidates.vel[kX][first]);
+    vel2[kY] = _mm_loadu_ps(&candidates.vel[kY][first]);
+    vel2[kZ] = _mm_loadu_ps(&candidates.vel[kZ][first]);
+
+    // is there any relative motion at all?
+    __m128 relative = zero;
+    for (size_t index = 0; index < 3; ++index)
+    {
+        relative = _mm_add_ps(relative, _mm_and_ps(absMask, _mm_sub_ps(_mm_set1_ps(vel1[index]), vel2[index])));
+    }
+
+    // cycle through the coordinates to see when the two volumes might coincide
+    __m128 found = zero;
+    __m128 tmin = _mm_set1_ps(-std::numeric_limits<float>::infinity());
+    __m128 tmax = infinity;
+    for (size_t index = 0; index < OCT_COUNT; ++index)
+    {
+        const __m128 src1_min = _mm_set1_ps(src1._mins[index]);
+        const __m128 src1_max = _mm_set1_ps(src1._maxs[index]);
+        const __m128 src2_min = _mm_loadu_ps(&candidates.mins[index][first]);
+        const __m128 src2_max = _mm_loadu_ps(&candidates.maxs[index][first]);
+
+        const __m128 vdiff = _mm_sub_ps(_mm_loadu_ps(&candidates.ovel[index][first]), _mm_set1_ps(ovel1[index]));
+        const __m128 moving = _mm_cmpge_ps(_mm_and_ps(absMask, vdiff), epsilon);
+
+        const __m128 time0 = _mm_div_ps(_mm_sub_ps(src1_min, src2_min), vdiff);
+        const __m128 time1 = _mm_div_ps(_mm_sub_ps(src1_min, src2_max), vdiff);
+        const __m128 time2 = _mm_div_ps(_mm_sub_ps(src1_max, src2_min), vdiff);
+        const __m128 time3 = _mm_div_ps(_mm_sub_ps(src1_max, src2_max), vdiff);
+
+        __m128 tmp_min = _mm_min_ps(_mm_min_ps(time0, time1), _mm_min_ps(time2, time3));
+        __m128 tmp_max = _mm_max_ps(_mm_max_ps(time0, time1), _mm_max_ps(time2, time3));
+
+        // Normalize the results for the diagonal directions.
+        if (OCT_XY == index || OCT_YX == index)
+        {
+            const __m128 scale = _mm_set1_ps(Ego::Math::invSqrtTwo<float>());
+            tmp_min = _mm_mul_ps(tmp_min, scale);
+            tmp_max = _mm_mul_ps(tmp_max, scale);
+        }
+
+        // skip axes without motion, overflows and empty intervals
+        __m128 valid = _mm_and_ps(moving, _mm_cmpgt_ps(tmp_max, tmp_min));
+        valid = _mm_and_ps(valid, _mm_cmplt_ps(_mm_and_ps(absMask, tmp_min), infinity));
+        valid = _mm_and_ps(valid, _mm_cmplt_ps(_mm_and_ps(absMask, tmp_max), infinity));
+
+        tmin = phys_select(valid, _mm_max_ps(tmin, tmp_min), tmin);
+        tmax = phys_select(valid, _mm_min_ps(tmax, tmp_max), tmax);
+        found = _mm_or_ps(found, valid);
+    }
+
+    // Without an interval of interaction the volumes interact for the whole frame.
+    const __m128 swept = _mm_and_ps(found, _mm_cmpge_ps(relative, epsilon));
+
+    // Check whether there is any overlap this frame.
+    __m128 reject = _mm_cmple_ps(tmax, tmin);
+    reject = _mm_or_ps(reject, _mm_cmpge_ps(tmin, one));
+    reject = _mm_or_ps(reject, _mm_cmple_ps(tmax, zero));
+
+    // Clip the interaction time to just one frame.
+    const __m128 clip_min = _mm_max_ps(zero, _mm_min_ps(tmin, one));
+    const __m128 clip_max = _mm_max_ps(zero, _mm_min_ps(tmax, one));
+
+    // the displacements of both volumes at the start and the end of the interaction
+    __m128 disp1_min[OCT_COUNT], disp1_max[OCT_COUNT], disp2_min[OCT_COUNT], disp2_max[OCT_COUNT];
+    phys_translate_oct(_mm_mul_ps(_mm_set1_ps(vel1[kX]), clip_min), _mm_mul_ps(_mm_set1_ps(vel1[kY]), clip_min), _mm_mul_ps(_mm_set1_ps(vel1[kZ]), clip_min), disp1_min);
+    phys_translate_oct(_mm_mul_ps(_mm_set1_ps(vel1[kX]), clip_max), _mm_mul_ps(_mm_set1_ps(vel1[kY]), clip_max), _mm_mul_ps(_mm_set1_ps(vel1[kZ]), clip_max), disp1_max);
+    phys_translate_oct(_mm_mul_ps(vel2[kX], clip_min), _mm_mul_ps(vel2[kY], clip_min), _mm_mul_ps(vel2[kZ], clip_min), disp2_min);
+    phys_translate_oct(_mm_mul_ps(vel2[kX], clip_max), _mm_mul_ps(vel2[kY], clip_max), _mm_mul_ps(vel2[kZ], clip_max), disp2_max);
+
+    // Determine whether the intersection of the (expanded) volumes is empty.
+    __m128 swept_empty = zero, static_empty = zero;
+    for (size_t index = 0; index < OCT_COUNT; ++index)
+    {
+        const __m128 src1_min = _mm_set1_ps(src1._mins[index]);
+        const __m128 src1_max = _mm_set1_ps(src1._maxs[index]);
+        const __m128 src2_min = _mm_loadu_ps(&candidates.mins[index][first]);
+        const __m128 src2_max = _mm_loadu_ps(&candidates.maxs[index][first]);
+
+        const __m128 exp1_min = _mm_min_ps(_mm_add_ps(src1_min, disp1_min[index]), _mm_add_ps(src1_min, disp1_max[index]));
+        const __m128 exp1_max = _mm_max_ps(_mm_add_ps(src1_max, disp1_min[index]), _mm_add_ps(src1_max, disp1_max[index]));
+        const __m128 exp2_min = _mm_min_ps(_mm_add_ps(src2_min, disp2_min[index]), _mm_add_ps(src2_min, disp2_max[index]));
+        const __m128 exp2_max = _mm_max_ps(_mm_add_ps(src2_max, disp2_min[index]), _mm_add_ps(src2_max, disp2_max[index]));
+
+        swept_empty = _mm_or_ps(swept_empty, _mm_cmpgt_ps(_mm_max_ps(exp1_min, exp2_min), _mm_min_ps(exp1_max, exp2_max)));
+        static_empty = _mm_or_ps(static_empty, _mm_cmpgt_ps(_mm_max_ps(src1_min, src2_min), _mm_min_ps(src1_max, src2_max)));
+    }
+
+    const __m128 miss = phys_select(swept, _mm_or_ps(reject, swept_empty), static_empty);
+    _mm_storeu_ps(&candidates.tmin[first], phys_select(swept, tmin, zero));
+    _mm_storeu_ps(&candidates.tmax[first], phys_select(swept, tmax, one));
+
+    const int mask = _mm_movemask_ps(miss);
+    for (size_t lane = 0; lane < 4; ++lane)
+    {
+        candidates.hit[first + lane] = (0 == (mask & (1 << lane)));
+    }
+}
+#endif
+
+//--------------------------------------------------------------------------------------------
+void phys_intersect_oct_bb_batch(const oct_bb_t& src1_orig, const Vector3f& pos1, const Vector3f& vel1, phys_oct_bb_batch_t& candidates)
+{
+    const size_t count = candidates.size();
+    candidates.tmin.resize(count);
+    candidates.tmax.resize(count);
+    candidates.hit.resize(count);
+
+    size_t candidate = 0;
+
+#if defined(PHYS_INTERSECT_OCT_BB_SSE2)
+    const oct_bb_t src1 = oct_bb_t::translate(src1_orig, pos1);
+    const oct_vec_v2_t ovel1(vel1);
+    for (; candidate + 4 <= count; candidate += 4)
+    {
+        phys_intersect_oct_bb_sse2(src1, ovel1, vel1, candidates, candidate);
+    }
+#endif
+
+    // the remaining candidates
+    for (; candidate < count; ++candidate)
+    {
+        candidates.hit[candidate] = phys_intersect_oct_bb_candidate(src1_orig, pos1, vel1, candidates, candidate, &candidates.tmin[candidate], &candidates.tmax[candidate]);
+    }
+}
+
 //--------------------------------------------------------------------------------------------
 //--------------------------------------------------------------------------------------------
 egolib_rv phys_intersect_oct_bb_close_index(int index, const oct_bb_t& src1, const oct_vec_v2_t& ovel1, const oct_bb_t& src2, const oct_vec_v2_t& ovel2, int test_platform, float *tmin, float *tmax)
@@ -195,3 +195,31 @@ bool phys_estimate_collision_normal(const oct_bb_t& obb_a, const oct_bb_t& pobb_
 bool phys_estimate_pressure_normal(const oct_bb_t& obb_a, const oct_bb_t& pobb_b, const float exponent, oct_vec_v2_t& odepth, Vector3f& nrm, float& depth);
 
 bool phys_intersect_oct_bb(const oct_bb_t& src1, const Vector3f& pos1, const Vector3f& vel1, const oct_bb_t& src2, const Vector3f& pos2, const Vector3f& vel2, int test_platform, oct_bb_t& dst, float *tmin, float *tmax);
+
+//--------------------------------------------------------------------------------------------
+//--------------------------------------------------------------------------------------------
+/// Moving oct_bb_t volumes stored as a structure of arrays, so that phys_intersect_oct_bb_batch()
+/// can test one volume against several candidates at once.
+struct phys_oct_bb_batch_t
+{
+    std::vector<float> mins[OCT_COUNT];     ///< Minima of the volumes, translated to their positions
+    std::vector<float> maxs[OCT_COUNT];     ///< Maxima of the volumes, translated to their positions
+    std::vector<float> ovel[OCT_COUNT];     ///< Velocities in octagonal format
+    std::vector<float> vel[3];              ///< Velocities
+
+    std::vector<float> tmin, tmax;          ///< Results: the interval of interaction of each hit candidate
+    std::vector<char> hit;                  ///< Results: is the candidate interacting within this frame?
+
+    void clear();
+    size_t size() const;
+
+    /// @details add a candidate, its results are stored at the index size() - 1.
+    ///          The volume must not be empty.
+    void push_back(const oct_bb_t& src, const Vector3f& pos, const Vector3f& vel);
+};
+
+/// @details Test one volume against all candidates of a batch. This gives the same results as calling
+///               phys_intersect_oct_bb() with test_platform == PHYS_PLATFORM_NONE for every candidate,
+///               platform interactions must still use phys_intersect_oct_bb().
+///               Four candidates are tested at a time if SSE2 is available.
+void phys_intersect_oct_bb_batch(const oct_bb_t& src1, const Vector3f& pos1, const Vector3f& vel1, phys_oct_bb_batch_t& candidates);
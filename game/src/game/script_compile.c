@@ -1069,6 +1069,9 @@ egolib_rv load_ai_script_vfs0(parser_state_t& ps, const std::string& loadname, O
 
         // determine the correct jumps
         parser_state_t::parse_jumps(script);
+
+        // determine if the script may run concurrently
+        script._concurrent = scr_is_concurrent(script);
     } catch (...) {
         return rv_fail;
     }
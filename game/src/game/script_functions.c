@@ -1007,7 +1007,7 @@ Uint8 scr_Else( script_state_t& state, ai_state_t& self )
 
     SCRIPT_FUNCTION_BEGIN();
 
-    returncode = ( ppro->getAIScript().indent >= ppro->getAIScript().indent_last );
+    returncode = ( state.indent >= state.indent_last );
 
     SCRIPT_FUNCTION_END();
 }
@@ -1105,7 +1105,17 @@ Uint8 scr_IssueOrder( script_state_t& state, ai_state_t& self )
 
     SCRIPT_FUNCTION_BEGIN();
 
-    issue_order( self.getSelf(), state.argument );
+    if ( nullptr != state.commands )
+    {
+        // The teammates are changed after all scripts have run.
+        ObjectRef ichr = self.getSelf();
+        int order = state.argument;
+        state.commands->record( state.commandKey, [ichr, order]() { issue_order( ichr, order ); } );
+    }
+    else
+    {
+        issue_order( self.getSelf(), state.argument );
+    }
 
     SCRIPT_FUNCTION_END();
 }
@@ -1128,7 +1138,7 @@ Uint8 scr_DropWeapons( script_state_t& state, ai_state_t& self )
         if ( pchr->isMount() )
         {
             leftItem->vel.z()    = Object::DISMOUNTZVEL;
-            leftItem->jump_timer = Object::JUMPDELAY;
+            leftItem->setTimer(&Object::jump_timer, Object::JUMPDELAY);
             leftItem->movePosition(0.0f, 0.0f, Object::DISMOUNTZVEL);
         }
     }
@@ -1140,7 +1150,7 @@ Uint8 scr_DropWeapons( script_state_t& state, ai_state_t& self )
         if ( pchr->isMount() )
         {
             rightItem->vel.z()    = Object::DISMOUNTZVEL;
-            rightItem->jump_timer = Object::JUMPDELAY;
+            rightItem->setTimer(&Object::jump_timer, Object::JUMPDELAY);
             rightItem->movePosition(0.0f, 0.0f, Object::DISMOUNTZVEL);
         }
     }
@@ -1421,7 +1431,7 @@ Uint8 scr_SetState( script_state_t& state, ai_state_t& self )
 
     SCRIPT_FUNCTION_BEGIN();
 
-    pchr->ai.state = state.argument;
+    self.state = state.argument;
 
     SCRIPT_FUNCTION_END();
 }
@@ -2156,7 +2166,17 @@ Uint8 scr_PlaySound( script_state_t& state, ai_state_t& self )
 
     if ( pchr->getOldPosition()[kZ] > PITNOSOUND )
     {
-        AudioSystem::get().playSound(pchr->getOldPosition(), ppro->getSoundID(state.argument));
+        if ( nullptr != state.commands )
+        {
+            // The audio system is not thread-safe.
+            Vector3f position = pchr->getOldPosition();
+            SoundID sound = ppro->getSoundID(state.argument);
+            state.commands->record( state.commandKey, [position, sound]() { AudioSystem::get().playSound(position, sound); } );
+        }
+        else
+        {
+            AudioSystem::get().playSound(pchr->getOldPosition(), ppro->getSoundID(state.argument));
+        }
     }
 
     SCRIPT_FUNCTION_END();
@@ -4377,7 +4397,7 @@ Uint8 scr_SetReloadTime( script_state_t& state, ai_state_t& self )
 
     SCRIPT_FUNCTION_BEGIN();
 
-    pchr->reload_timer = std::max( 0, state.argument );
+    pchr->setTimer(&Object::reload_timer, std::max( 0, state.argument ));
 
     SCRIPT_FUNCTION_END();
 }
@@ -5002,11 +5022,11 @@ Uint8 scr_SetTargetReloadTime( script_state_t& state, ai_state_t& self )
 
     if ( state.argument > 0 )
     {
-        pself_target->reload_timer = Ego::Math::constrain( state.argument, 0, 0xFFFF );
+        pself_target->setTimer(&Object::reload_timer, Ego::Math::constrain( state.argument, 0, 0xFFFF ));
     }
     else
     {
-        pself_target->reload_timer = 0;
+        pself_target->setTimer(&Object::reload_timer, 0);
     }
 
     SCRIPT_FUNCTION_END();
@@ -6257,7 +6277,7 @@ Uint8 scr_SetDamageTime( script_state_t& state, ai_state_t& self )
 
     SCRIPT_FUNCTION_BEGIN();
 
-    pchr->damage_timer = Ego::Math::constrain( state.argument, 0, 0xFFFF );
+    pchr->setTimer(&Object::damage_timer, Ego::Math::constrain( state.argument, 0, 0xFFFF ));
 
     SCRIPT_FUNCTION_END();
 }
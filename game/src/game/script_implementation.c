@@ -248,8 +248,20 @@ bool FindPath( waypoint_list_t& wplst, Object * pchr, float dst_x, float dst_y,
 #ifdef DEBUG_ASTAR
         printf( "Finding a path from %d,%d to %d,%d: \n", src_ix, src_iy, dst_ix, dst_iy );
 #endif
+        //Many agents moving to the same tile share a flow field
+        if ( g_flowFieldCache.find_path( _currentModule->getMeshPointer(), pchr->stoppedby, src_ix, src_iy, dst_ix, dst_iy ) )
+        {
+            returncode = g_flowFieldCache.get_path( dst_x, dst_y, wplst);
+        }
+
+        //Try to find a long path on the blocks of the mesh
+        else if ( g_hierarchicalAStar.find_path( _currentModule->getMeshPointer(), pchr->stoppedby, src_ix, src_iy, dst_ix, dst_iy ) )
+        {
+            returncode = g_hierarchicalAStar.get_path( dst_x, dst_y, wplst);
+        }
+
         //Try to find a path with the AStar algorithm
-        if ( g_astar.find_path( _currentModule->getMeshPointer(), pchr->stoppedby, src_ix, src_iy, dst_ix, dst_iy ) )
+        else if ( g_astar.find_path( _currentModule->getMeshPointer(), pchr->stoppedby, src_ix, src_iy, dst_ix, dst_iy ) )
         {
             returncode = g_astar.get_path( dst_x, dst_y, wplst);
         }